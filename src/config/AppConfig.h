@@ -4,6 +4,7 @@
 
 #include <opencv2/core.hpp>
 
+#include "core/capture/CaptureConfig.h"
 #include "core/engine/TrackingEngine.h"
 #include "core/recorder/RecorderConfig.h"
 #include "core/visualizer/Visualizer.h"
@@ -19,6 +20,9 @@ struct AppConfig {
     // Engine 全量配置（包含 detector / extractor / tracker）
     TrackingEngineConfig engine;
 
+    // 帧源读取配置（预解码等）
+    CaptureConfig capture;
+
     // 录制/统计模块配置
     RecorderConfig recorder;
 
@@ -33,6 +33,13 @@ void writeValue<std::vector<int>>(cv::FileStorage &fs, const char *key, const st
     fs << "]";
 }
 
+template <>
+void writeValue<std::vector<float>>(cv::FileStorage &fs, const char *key, const std::vector<float> &vec) {
+    fs << key << "[";
+    for (float x : vec) fs << x;
+    fs << "]";
+}
+
 template <>
 void writeValue<cv::Scalar>(cv::FileStorage &fs, const char *key, const cv::Scalar &value) {
     fs << key << "[";
@@ -42,7 +49,12 @@ void writeValue<cv::Scalar>(cv::FileStorage &fs, const char *key, const cv::Scal
 
 template <typename T>
 inline void writeValue(cv::FileStorage &fs, const char *key, const T &v) {
-    writeScalar(fs, key, v);
+    if constexpr (std::is_enum_v<T>) {
+        // 枚举按整数写入
+        writeScalar(fs, key, static_cast<int>(v));
+    } else {
+        writeScalar(fs, key, v);
+    }
 }
 
 // ---------- 读取 ----------
@@ -50,7 +62,13 @@ template <typename T>
 bool readValue(const cv::FileNode &node, const char *key, T &out) {
     const cv::FileNode v = node[key];
     if (v.empty()) return false;
-    v >> out;
+    if constexpr (std::is_enum_v<T>) {
+        int tmp = static_cast<int>(out);
+        v >> tmp;
+        out = static_cast<T>(tmp);
+    } else {
+        v >> out;
+    }
     return true;
 }
 
@@ -87,6 +105,19 @@ bool readValue<std::vector<int>>(const cv::FileNode &node, const char *key, std:
     return true;
 }
 
+template <>
+bool readValue<std::vector<float>>(const cv::FileNode &node, const char *key, std::vector<float> &out) {
+    const cv::FileNode v = node[key];
+    if (v.empty() || !v.isSeq()) return false;
+    out.clear();
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        float val = 0.0F;
+        *it >> val;
+        out.push_back(val);
+    }
+    return true;
+}
+
 template <>
 bool readValue<cv::Scalar>(const cv::FileNode &node, const char *key, cv::Scalar &out) {
     const cv::FileNode v = node[key];
@@ -149,6 +180,16 @@ inline void deserialize<std::vector<int>>(const cv::FileNode &node, const char *
     readValue(node, key, v);
 }
 
+template <>
+inline void serialize<std::vector<float>>(cv::FileStorage &fs, const char *key, const std::vector<float> &v) {
+    writeValue(fs, key, v);
+}
+
+template <>
+inline void deserialize<std::vector<float>>(const cv::FileNode &node, const char *key, std::vector<float> &v) {
+    readValue(node, key, v);
+}
+
 // 针对 cv::Scalar 的显式序列化/反序列化，避免走类反射路径
 template <>
 inline void serialize<cv::Scalar>(cv::FileStorage &fs, const char *key, const cv::Scalar &v) {
@@ -168,14 +209,31 @@ void for_each_field(Obj &obj, Tuple &&t, Fn &&fn) {
     }, std::forward<Tuple>(t));
 }
 
+// 结构体数组（如 ROI 区域列表）：写成由 map 组成的序列
+template <typename T>
+struct IsStructVector : std::false_type {};
+template <typename T, typename A>
+struct IsStructVector<std::vector<T, A>> : std::bool_constant<std::is_class_v<T> && !std::is_same_v<T, std::string>> {};
+
 template <typename T>
 std::enable_if_t<std::is_class_v<T> && !std::is_same_v<T, std::string>, void>
 serialize(cv::FileStorage &fs, const char *key, const T &obj) {
-    fs << key << "{";
-    for_each_field(const_cast<T &>(obj), Reflect<T>::fields(), [&](const char *name, const auto &value) {
-        serialize(fs, name, value);
-    });
-    fs << "}";
+    if constexpr (IsStructVector<T>::value) {
+        fs << key << "[";
+        for (const auto &item : obj) {
+            fs << "{";
+            for_each_field(const_cast<typename T::value_type &>(item), Reflect<typename T::value_type>::fields(),
+                           [&](const char *name, const auto &value) { serialize(fs, name, value); });
+            fs << "}";
+        }
+        fs << "]";
+    } else {
+        fs << key << "{";
+        for_each_field(const_cast<T &>(obj), Reflect<T>::fields(), [&](const char *name, const auto &value) {
+            serialize(fs, name, value);
+        });
+        fs << "}";
+    }
 }
 
 // 反序列化类：按字段名读取（缺失则保持默认值）
@@ -184,9 +242,23 @@ std::enable_if_t<std::is_class_v<T> && !std::is_same_v<T, std::string>, void>
 deserialize(const cv::FileNode &node, const char *key, T &obj) {
     const cv::FileNode child = node[key];
     if (child.empty()) return;
-    for_each_field(obj, Reflect<T>::fields(), [&](const char *name, auto &value) {
-        deserialize(child, name, value);
-    });
+    if constexpr (IsStructVector<T>::value) {
+        // 序列存在时整体替换（元素缺失的字段保持默认值）
+        if (!child.isSeq()) return;
+        obj.clear();
+        for (auto it = child.begin(); it != child.end(); ++it) {
+            const cv::FileNode item_node = *it;
+            typename T::value_type item{};
+            for_each_field(item, Reflect<typename T::value_type>::fields(), [&](const char *name, auto &value) {
+                deserialize(item_node, name, value);
+            });
+            obj.push_back(std::move(item));
+        }
+    } else {
+        for_each_field(obj, Reflect<T>::fields(), [&](const char *name, auto &value) {
+            deserialize(child, name, value);
+        });
+    }
 }
 
 // ------------- 各配置结构的反射表 -------------
@@ -198,7 +270,22 @@ struct Reflect<OrtEnvConfig> {
             Field<OrtEnvConfig, std::string>{"model_path", &OrtEnvConfig::model_path},
             Field<OrtEnvConfig, bool>{"using_gpu", &OrtEnvConfig::using_gpu},
             Field<OrtEnvConfig, int>{"device_id", &OrtEnvConfig::device_id},
-            Field<OrtEnvConfig, size_t>{"gpu_mem_limit", &OrtEnvConfig::gpu_mem_limit}
+            Field<OrtEnvConfig, size_t>{"gpu_mem_limit", &OrtEnvConfig::gpu_mem_limit},
+            Field<OrtEnvConfig, int>{"intra_op_threads", &OrtEnvConfig::intra_op_threads}
+        );
+    }
+};
+
+template <>
+struct Reflect<TilingConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<TilingConfig, bool>{"enabled", &TilingConfig::enabled},
+            Field<TilingConfig, int>{"tile_width", &TilingConfig::tile_width},
+            Field<TilingConfig, int>{"tile_height", &TilingConfig::tile_height},
+            Field<TilingConfig, float>{"overlap", &TilingConfig::overlap},
+            Field<TilingConfig, bool>{"include_full_frame", &TilingConfig::include_full_frame},
+            Field<TilingConfig, float>{"merge_threshold", &TilingConfig::merge_threshold}
         );
     }
 };
@@ -209,10 +296,20 @@ struct Reflect<DetectorConfig> {
         return std::make_tuple(
             Field<DetectorConfig, int>{"input_width", &DetectorConfig::input_width},
             Field<DetectorConfig, int>{"input_height", &DetectorConfig::input_height},
+            Field<DetectorConfig, bool>{"rect_inference", &DetectorConfig::rect_inference},
+            Field<DetectorConfig, int>{"input_stride", &DetectorConfig::input_stride},
             Field<DetectorConfig, float>{"score_threshold", &DetectorConfig::score_threshold},
             Field<DetectorConfig, float>{"nms_threshold", &DetectorConfig::nms_threshold},
+            Field<DetectorConfig, NmsMethod>{"nms_method", &DetectorConfig::nms_method},
+            Field<DetectorConfig, bool>{"nms_use_iom", &DetectorConfig::nms_use_iom},
+            Field<DetectorConfig, float>{"nms_sigma", &DetectorConfig::nms_sigma},
+            Field<DetectorConfig, float>{"nms_min_score", &DetectorConfig::nms_min_score},
             Field<DetectorConfig, bool>{"filter_edge_boxes", &DetectorConfig::filter_edge_boxes},
             Field<DetectorConfig, std::vector<int>>{"focus_class_ids", &DetectorConfig::focus_class_ids},
+            Field<DetectorConfig, int>{"decode_parallel_min_anchors", &DetectorConfig::decode_parallel_min_anchors},
+            Field<DetectorConfig, int>{"region_input_size", &DetectorConfig::region_input_size},
+            Field<DetectorConfig, int>{"region_max_batch", &DetectorConfig::region_max_batch},
+            Field<DetectorConfig, TilingConfig>{"tiling", &DetectorConfig::tiling},
             Field<DetectorConfig, OrtEnvConfig>{"ort_env", &DetectorConfig::ort_env_config}
         );
     }
@@ -224,6 +321,7 @@ struct Reflect<FeatureExtractorConfig> {
         return std::make_tuple(
             Field<FeatureExtractorConfig, int>{"input_height", &FeatureExtractorConfig::input_height},
             Field<FeatureExtractorConfig, int>{"input_width", &FeatureExtractorConfig::input_width},
+            Field<FeatureExtractorConfig, int>{"max_batch_size", &FeatureExtractorConfig::max_batch_size},
             Field<FeatureExtractorConfig, OrtEnvConfig>{"ort_env", &FeatureExtractorConfig::ort_env_config}
         );
     }
@@ -233,9 +331,12 @@ template <>
 struct Reflect<MatcherConfig> {
     static constexpr auto fields() {
         return std::make_tuple(
+            Field<MatcherConfig, MatcherType>{"type", &MatcherConfig::type},
             Field<MatcherConfig, float>{"iou_weight", &MatcherConfig::iou_weight},
             Field<MatcherConfig, float>{"feature_weight", &MatcherConfig::feature_weight},
-            Field<MatcherConfig, float>{"threshold", &MatcherConfig::threshold}
+            Field<MatcherConfig, float>{"threshold", &MatcherConfig::threshold},
+            Field<MatcherConfig, bool>{"gating", &MatcherConfig::gating},
+            Field<MatcherConfig, float>{"gate_margin", &MatcherConfig::gate_margin}
         );
     }
 };
@@ -253,12 +354,43 @@ struct Reflect<TrackerConfig> {
     }
 };
 
+template <>
+struct Reflect<ReidGateConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<ReidGateConfig, bool>{"enabled", &ReidGateConfig::enabled},
+            Field<ReidGateConfig, float>{"confident_iou", &ReidGateConfig::confident_iou},
+            Field<ReidGateConfig, float>{"ambiguity_iou", &ReidGateConfig::ambiguity_iou},
+            Field<ReidGateConfig, int>{"refresh_interval", &ReidGateConfig::refresh_interval},
+            Field<ReidGateConfig, int>{"max_crops_per_frame", &ReidGateConfig::max_crops_per_frame}
+        );
+    }
+};
+
 template <>
 struct Reflect<TrackerManagerConfig> {
     static constexpr auto fields() {
         return std::make_tuple(
             Field<TrackerManagerConfig, MatcherConfig>{"matcher", &TrackerManagerConfig::matcher_cfg},
-            Field<TrackerManagerConfig, TrackerConfig>{"tracker", &TrackerManagerConfig::tracker_cfg}
+            Field<TrackerManagerConfig, TrackerConfig>{"tracker", &TrackerManagerConfig::tracker_cfg},
+            Field<TrackerManagerConfig, FeatureStorage>{"feature_storage", &TrackerManagerConfig::feature_storage},
+            Field<TrackerManagerConfig, ReidGateConfig>{"reid_gate", &TrackerManagerConfig::reid_gate},
+            Field<TrackerManagerConfig, bool>{"export_features", &TrackerManagerConfig::export_features}
+        );
+    }
+};
+
+template <>
+struct Reflect<RoiZone> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<RoiZone, std::string>{"name", &RoiZone::name},
+            Field<RoiZone, RoiShape>{"shape", &RoiZone::shape},
+            Field<RoiZone, float>{"x", &RoiZone::x},
+            Field<RoiZone, float>{"y", &RoiZone::y},
+            Field<RoiZone, float>{"w", &RoiZone::w},
+            Field<RoiZone, float>{"h", &RoiZone::h},
+            Field<RoiZone, std::vector<float>>{"polygon", &RoiZone::polygon}
         );
     }
 };
@@ -271,7 +403,69 @@ struct Reflect<RoiConfig> {
             Field<RoiConfig, float>{"x", &RoiConfig::x},
             Field<RoiConfig, float>{"y", &RoiConfig::y},
             Field<RoiConfig, float>{"w", &RoiConfig::w},
-            Field<RoiConfig, float>{"h", &RoiConfig::h}
+            Field<RoiConfig, float>{"h", &RoiConfig::h},
+            Field<RoiConfig, std::vector<RoiZone>>{"zones", &RoiConfig::zones}
+        );
+    }
+};
+
+template <>
+struct Reflect<PipelineConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<PipelineConfig, bool>{"enabled", &PipelineConfig::enabled},
+            Field<PipelineConfig, int>{"stage_count", &PipelineConfig::stage_count},
+            Field<PipelineConfig, int>{"decode_queue_depth", &PipelineConfig::decode_queue_depth},
+            Field<PipelineConfig, int>{"queue_depth", &PipelineConfig::queue_depth}
+        );
+    }
+};
+
+template <>
+struct Reflect<KeyframeConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<KeyframeConfig, int>{"interval", &KeyframeConfig::interval},
+            Field<KeyframeConfig, bool>{"adaptive", &KeyframeConfig::adaptive},
+            Field<KeyframeConfig, int>{"max_interval", &KeyframeConfig::max_interval}
+        );
+    }
+};
+
+template <>
+struct Reflect<LocalDetectionConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<LocalDetectionConfig, bool>{"enabled", &LocalDetectionConfig::enabled},
+            Field<LocalDetectionConfig, int>{"full_frame_interval", &LocalDetectionConfig::full_frame_interval},
+            Field<LocalDetectionConfig, float>{"padding", &LocalDetectionConfig::padding},
+            Field<LocalDetectionConfig, int>{"min_region_size", &LocalDetectionConfig::min_region_size},
+            Field<LocalDetectionConfig, float>{"max_area_ratio", &LocalDetectionConfig::max_area_ratio}
+        );
+    }
+};
+
+template <>
+struct Reflect<OfflineConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<OfflineConfig, int>{"segments", &OfflineConfig::segments},
+            Field<OfflineConfig, int>{"overlap_frames", &OfflineConfig::overlap_frames},
+            Field<OfflineConfig, int>{"min_segment_frames", &OfflineConfig::min_segment_frames},
+            Field<OfflineConfig, float>{"stitch_iou", &OfflineConfig::stitch_iou},
+            Field<OfflineConfig, float>{"stitch_min_ratio", &OfflineConfig::stitch_min_ratio},
+            Field<OfflineConfig, float>{"stitch_reid_threshold", &OfflineConfig::stitch_reid_threshold}
+        );
+    }
+};
+
+template <>
+struct Reflect<LookaheadConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<LookaheadConfig, bool>{"enabled", &LookaheadConfig::enabled},
+            Field<LookaheadConfig, int>{"workers", &LookaheadConfig::workers},
+            Field<LookaheadConfig, int>{"depth", &LookaheadConfig::depth}
         );
     }
 };
@@ -283,7 +477,26 @@ struct Reflect<TrackingEngineConfig> {
             Field<TrackingEngineConfig, DetectorConfig>{"detector", &TrackingEngineConfig::detector},
             Field<TrackingEngineConfig, FeatureExtractorConfig>{"extractor", &TrackingEngineConfig::extractor},
             Field<TrackingEngineConfig, TrackerManagerConfig>{"tracker_mgr", &TrackingEngineConfig::tracker_mgr},
-            Field<TrackingEngineConfig, RoiConfig>{"roi", &TrackingEngineConfig::roi}
+            Field<TrackingEngineConfig, RoiConfig>{"roi", &TrackingEngineConfig::roi},
+            Field<TrackingEngineConfig, PipelineConfig>{"pipeline", &TrackingEngineConfig::pipeline},
+            Field<TrackingEngineConfig, KeyframeConfig>{"keyframe", &TrackingEngineConfig::keyframe},
+            Field<TrackingEngineConfig, LocalDetectionConfig>{"local_detection", &TrackingEngineConfig::local_detection},
+            Field<TrackingEngineConfig, OfflineConfig>{"offline", &TrackingEngineConfig::offline},
+            Field<TrackingEngineConfig, LookaheadConfig>{"lookahead", &TrackingEngineConfig::lookahead}
+        );
+    }
+};
+
+template <>
+struct Reflect<CaptureConfig> {
+    static constexpr auto fields() {
+        return std::make_tuple(
+            Field<CaptureConfig, int>{"prefetch_depth", &CaptureConfig::prefetch_depth},
+            Field<CaptureConfig, bool>{"seek_sampling", &CaptureConfig::seek_sampling},
+            Field<CaptureConfig, int>{"seek_overhead_frames", &CaptureConfig::seek_overhead_frames},
+            Field<CaptureConfig, bool>{"cache_keyframe_index", &CaptureConfig::cache_keyframe_index},
+            Field<CaptureConfig, bool>{"live_mode", &CaptureConfig::live_mode},
+            Field<CaptureConfig, int>{"live_keep_frames", &CaptureConfig::live_keep_frames}
         );
     }
 };
@@ -322,6 +535,7 @@ struct Reflect<AppConfig> {
     static constexpr auto fields() {
         return std::make_tuple(
             Field<AppConfig, TrackingEngineConfig>{"engine", &AppConfig::engine},
+            Field<AppConfig, CaptureConfig>{"capture", &AppConfig::capture},
             Field<AppConfig, RecorderConfig>{"recorder", &AppConfig::recorder},
             Field<AppConfig, VisualizerConfig>{"visualizer", &AppConfig::visualizer}
         );
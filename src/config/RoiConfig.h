@@ -2,12 +2,32 @@
 
 #include <algorithm>
 #include <cmath>
+#include <string>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
+// ROI 区域形状
+enum class RoiShape {
+    Rect = 0,     // 归一化矩形 (x, y, w, h)
+    Polygon = 1,  // 归一化多边形顶点
+};
+
+// 单个 ROI 区域（归一化坐标系，取值范围 0~1）
+struct RoiZone {
+    std::string name;               // 显示名称（为空时按序号显示）
+    RoiShape shape = RoiShape::Rect;
+    float x = 0.0F;
+    float y = 0.0F;
+    float w = 1.0F;
+    float h = 1.0F;
+    std::vector<float> polygon;     // Polygon：顶点按 x0, y0, x1, y1, ... 排列（至少 3 个点）
+};
+
 // ROI 配置（归一化坐标系，取值范围 0~1）
 // - (x,y) 表示 ROI 左上角占原图的百分比位置
 // - (w,h) 表示 ROI 宽高占原图的百分比
+// - zones 非空时使用其中的多个区域（矩形或多边形），忽略上面的单个矩形
 // - enabled=false 表示使用整帧
 struct RoiConfig {
     bool enabled = false;
@@ -15,17 +35,24 @@ struct RoiConfig {
     float y = 0.0F;
     float w = 1.0F;
     float h = 1.0F;
+    std::vector<RoiZone> zones;
 };
 
-// 将归一化 ROI 转为像素 Rect，并做边界裁剪；若 ROI 非法则返回空 Rect
-inline cv::Rect RoiToPixelRect(const RoiConfig &roi, const cv::Size &frame_size) {
-    if (!roi.enabled) return cv::Rect();
+// 像素坐标下的单个 ROI 区域
+struct PixelRoi {
+    std::string name;
+    cv::Rect bounds;                 // 外接矩形（已裁剪到画面内）
+    std::vector<cv::Point> polygon;  // 多边形顶点（矩形区域为空）
+};
+
+// 将归一化矩形转为像素 Rect，并做边界裁剪；若矩形非法则返回空 Rect
+inline cv::Rect NormalizedRectToPixel(float x, float y, float w, float h, const cv::Size &frame_size) {
     if (frame_size.width <= 0 || frame_size.height <= 0) return cv::Rect();
 
-    const float x = std::clamp(roi.x, 0.0F, 1.0F);
-    const float y = std::clamp(roi.y, 0.0F, 1.0F);
-    const float w = std::clamp(roi.w, 0.0F, 1.0F);
-    const float h = std::clamp(roi.h, 0.0F, 1.0F);
+    x = std::clamp(x, 0.0F, 1.0F);
+    y = std::clamp(y, 0.0F, 1.0F);
+    w = std::clamp(w, 0.0F, 1.0F);
+    h = std::clamp(h, 0.0F, 1.0F);
     if (w <= 0.0F || h <= 0.0F) return cv::Rect();
 
     const int px = static_cast<int>(std::round(x * static_cast<float>(frame_size.width)));
@@ -39,3 +66,46 @@ inline cv::Rect RoiToPixelRect(const RoiConfig &roi, const cv::Size &frame_size)
     return r;
 }
 
+// 将归一化 ROI 转为像素 Rect，并做边界裁剪；若 ROI 非法则返回空 Rect
+inline cv::Rect RoiToPixelRect(const RoiConfig &roi, const cv::Size &frame_size) {
+    if (!roi.enabled) return cv::Rect();
+    return NormalizedRectToPixel(roi.x, roi.y, roi.w, roi.h, frame_size);
+}
+
+// 将所有 ROI 区域转为像素坐标（未启用时返回空列表；非法区域被跳过）
+inline std::vector<PixelRoi> RoiToPixelZones(const RoiConfig &roi, const cv::Size &frame_size) {
+    std::vector<PixelRoi> zones;
+    if (!roi.enabled || frame_size.width <= 0 || frame_size.height <= 0) return zones;
+    if (roi.zones.empty()) {
+        const cv::Rect r = RoiToPixelRect(roi, frame_size);
+        if (r.area() > 0) zones.push_back(PixelRoi{"ROI", r, {}});
+        return zones;
+    }
+
+    const cv::Rect frame_rect(0, 0, frame_size.width, frame_size.height);
+    for (size_t i = 0; i < roi.zones.size(); ++i) {
+        const RoiZone &zone = roi.zones[i];
+        PixelRoi px;
+        px.name = zone.name.empty() ? "ROI " + std::to_string(i + 1) : zone.name;
+        if (zone.shape == RoiShape::Rect) {
+            px.bounds = NormalizedRectToPixel(zone.x, zone.y, zone.w, zone.h, frame_size);
+        } else {
+            if (zone.polygon.size() < 6) continue;
+            int x0 = frame_size.width, y0 = frame_size.height, x1 = 0, y1 = 0;
+            for (size_t k = 0; k + 1 < zone.polygon.size(); k += 2) {
+                const int px_x = static_cast<int>(std::round(std::clamp(zone.polygon[k], 0.0F, 1.0F) *
+                                                             static_cast<float>(frame_size.width)));
+                const int px_y = static_cast<int>(std::round(std::clamp(zone.polygon[k + 1], 0.0F, 1.0F) *
+                                                             static_cast<float>(frame_size.height)));
+                px.polygon.emplace_back(px_x, px_y);
+                x0 = std::min(x0, px_x);
+                y0 = std::min(y0, px_y);
+                x1 = std::max(x1, px_x);
+                y1 = std::max(y1, px_y);
+            }
+            px.bounds = cv::Rect(cv::Point(x0, y0), cv::Point(x1, y1)) & frame_rect;
+        }
+        if (px.bounds.area() > 0) zones.push_back(std::move(px));
+    }
+    return zones;
+}
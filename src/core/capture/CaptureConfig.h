@@ -0,0 +1,19 @@
+#pragma once
+
+// 帧源（视频文件 / 摄像头）读取配置
+struct CaptureConfig {
+    // 视频文件后台预解码的缓冲帧数：解码线程提前解出这么多帧，与推理重叠；0 表示在 next() 中同步解码
+    int prefetch_depth = 4;
+
+    // 视频文件稀疏采样时按关键帧索引跳转：目标帧之前的关键帧比当前位置超前 seek_overhead_frames 帧以上时，
+    // 直接 seek 过去，而不是逐帧 grab（每次 grab 都要完整解码一帧）
+    bool seek_sampling = true;
+    int seek_overhead_frames = 2;
+    // 关键帧索引缓存在视频旁的 <视频>.kfidx，下次打开同一文件时免去扫描
+    bool cache_keyframe_index = true;
+
+    // 摄像头实时模式：采集线程持续读取，只保留最新的 live_keep_frames 帧，来不及处理的旧帧直接丢弃，
+    // 使跟踪总是处理最新画面、延迟有界；关闭时在 next() 中同步读取驱动缓冲
+    bool live_mode = false;
+    int live_keep_frames = 1;
+};
@@ -0,0 +1,57 @@
+#include "core/capture/FramePrefetcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/capture/MatBuffer.h"
+
+FramePrefetcher::FramePrefetcher(ReadFn read, size_t depth)
+    : read_(std::move(read)), filled_(std::max<size_t>(depth, 1)) {
+    // 队列中的帧 + 调用方正持有的一帧 + 正在解码的一帧
+    ring_.resize(filled_.capacity() + 2);
+    worker_ = std::thread(&FramePrefetcher::decodeLoop, this);
+}
+
+FramePrefetcher::~FramePrefetcher() {
+    filled_.close();
+    if (worker_.joinable()) worker_.join();
+}
+
+bool FramePrefetcher::next(cv::Mat &frame) {
+    // 先释放调用方对上一帧的引用，使其缓冲可以回到环中复用
+    frame.release();
+    if (filled_.pop(frame)) return true;
+
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    return false;
+}
+
+cv::Mat &FramePrefetcher::acquireSlot() {
+    for (size_t n = 0; n < ring_.size(); ++n) {
+        cv::Mat &slot = ring_[cursor_];
+        cursor_ = (cursor_ + 1) % ring_.size();
+        if (slot.empty() || IsSoleOwner(slot)) return slot;
+    }
+    // 所有缓冲都还被下游引用：放弃当前槽位的旧缓冲，改为新分配
+    cv::Mat &slot = ring_[cursor_];
+    cursor_ = (cursor_ + 1) % ring_.size();
+    slot = cv::Mat();
+    return slot;
+}
+
+void FramePrefetcher::decodeLoop() {
+    try {
+        while (!filled_.closed()) {
+            cv::Mat &slot = acquireSlot();
+            const uchar *prev = slot.data;
+            if (!read_(slot) || slot.empty()) break;
+            if (slot.data != prev) ++allocations_;
+            if (!filled_.push(slot)) return;
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        error_ = std::current_exception();
+    }
+    filled_.close();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "core/concurrency/BoundedQueue.h"
+
+// 后台预解码器：在独立线程上反复调用 read 解码下一帧，放入有界队列，消费方按序取出。
+// 解码目标缓冲来自一个固定大小的环：只有当某块缓冲已不再被下游引用（引用计数回到 1）时才会被复用，
+// 因此输出给调用方的帧在其持有期间不会被覆盖；环中缓冲都被占用时才临时新分配。
+class FramePrefetcher {
+public:
+    // read 在解码线程上调用：成功解出一帧写入参数并返回 true；返回 false 表示数据源结束
+    using ReadFn = std::function<bool(cv::Mat &)>;
+
+    FramePrefetcher(ReadFn read, size_t depth);
+    ~FramePrefetcher();
+
+    FramePrefetcher(const FramePrefetcher &) = delete;
+    FramePrefetcher &operator=(const FramePrefetcher &) = delete;
+
+    // 阻塞直到下一帧解码完成；数据源结束且已取完时返回 false。解码线程抛出的异常在这里重新抛出
+    bool next(cv::Mat &frame);
+
+    // 累计新分配的解码缓冲数（稳定运行时应不再增长）
+    size_t allocations() const { return allocations_; }
+
+private:
+    void decodeLoop();
+    // 从环中挑一块可复用的缓冲；没有空闲时让出该槽位（旧缓冲留给下游继续持有）
+    cv::Mat &acquireSlot();
+
+    ReadFn read_;
+    BoundedQueue<cv::Mat> filled_;
+    // ring_ / cursor_ 只在解码线程上访问
+    std::vector<cv::Mat> ring_;
+    size_t cursor_ = 0;
+    std::atomic<size_t> allocations_{0};
+
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+    std::thread worker_;
+};
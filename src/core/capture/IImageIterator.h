@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <opencv2/core.hpp>
 
 // 帧源基础信息（用于 UI 进度、采样参数回显等）
@@ -11,6 +13,14 @@ struct FrameSourceInfo {
     int frame_step = 1;        // 采样步长（>=1）
 };
 
+// 实时采集统计（非实时源或同步读取时保持默认值）
+struct CaptureStats {
+    uint64_t captured = 0;         // 从驱动读出的帧数（不含采样跳过的帧）
+    uint64_t dropped = 0;          // 处理跟不上、被更新的帧挤掉的帧数
+    int64_t last_capture_us = 0;   // 最近一次输出帧的采集时刻（steady_clock，微秒）
+    double last_wait_ms = 0.0;     // 最近一次输出帧从采集完成到被取走等待的时间
+};
+
 // 图像迭代器接口：按顺序输出 cv::Mat 帧
 class IImageIterator {
 public:
@@ -20,4 +30,7 @@ public:
 
     // 可选的帧源信息（默认返回空信息）
     virtual FrameSourceInfo info() const { return FrameSourceInfo{}; }
+
+    // 可选的采集统计（默认返回空统计）
+    virtual CaptureStats stats() const { return CaptureStats{}; }
 };
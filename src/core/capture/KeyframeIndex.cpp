@@ -0,0 +1,133 @@
+#include "core/capture/KeyframeIndex.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#include <opencv2/videoio.hpp>
+
+namespace {
+constexpr char kMagic[8] = {'K', 'F', 'I', 'D', 'X', '0', '0', '1'};
+
+// 缓存有效性校验：视频文件大小 + 修改时间
+struct VideoStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+bool statVideo(const std::string &video_path, VideoStamp &stamp) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(video_path, ec);
+    if (ec) return false;
+    const auto mtime = std::filesystem::last_write_time(video_path, ec);
+    if (ec) return false;
+    stamp.size = static_cast<uint64_t>(size);
+    stamp.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+template <typename T>
+void writePod(std::ofstream &out, const T &v) {
+    out.write(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::ifstream &in, T &v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&v), sizeof(T)));
+}
+}  // namespace
+
+KeyframeIndex::KeyframeIndex(std::vector<int> keyframes, std::vector<double> timestamps_ms)
+    : keyframes_(std::move(keyframes)), timestamps_ms_(std::move(timestamps_ms)) {
+    std::sort(keyframes_.begin(), keyframes_.end());
+}
+
+KeyframeIndex KeyframeIndex::build(const std::string &video_path) {
+    cv::VideoCapture cap(video_path, cv::CAP_FFMPEG);
+    if (!cap.isOpened()) return {};
+    // 原始包模式：grab 只读取压缩包，不解码
+    if (!cap.set(cv::CAP_PROP_FORMAT, -1)) return {};
+
+    std::vector<int> keyframes;
+    std::vector<double> timestamps;
+    for (int n = 0; cap.grab(); ++n) {
+        if (cap.get(cv::CAP_PROP_LRF_HAS_KEY_FRAME) != 0.0) keyframes.push_back(n);
+        timestamps.push_back(cap.get(cv::CAP_PROP_POS_MSEC));
+    }
+    // 包按解码顺序输出，排序后即为显示顺序的时间戳
+    std::sort(timestamps.begin(), timestamps.end());
+    return KeyframeIndex(std::move(keyframes), std::move(timestamps));
+}
+
+KeyframeIndex KeyframeIndex::loadOrBuild(const std::string &video_path, bool use_cache) {
+    KeyframeIndex index;
+    const std::string cache = cachePath(video_path);
+    if (use_cache && index.load(cache, video_path)) return index;
+
+    index = build(video_path);
+    if (use_cache && !index.empty()) index.save(cache, video_path);
+    return index;
+}
+
+std::string KeyframeIndex::cachePath(const std::string &video_path) { return video_path + ".kfidx"; }
+
+bool KeyframeIndex::load(const std::string &cache_path, const std::string &video_path) {
+    VideoStamp expect;
+    if (!statVideo(video_path, expect)) return false;
+
+    std::ifstream in(cache_path, std::ios::binary);
+    if (!in) return false;
+    char magic[sizeof(kMagic)] = {};
+    VideoStamp stamp;
+    int32_t key_count = 0;
+    int32_t frame_count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (!readPod(in, stamp.size) || !readPod(in, stamp.mtime)) return false;
+    if (stamp.size != expect.size || stamp.mtime != expect.mtime) return false;
+    if (!readPod(in, key_count) || !readPod(in, frame_count) || key_count < 0 || frame_count < 0) return false;
+
+    std::vector<int> keyframes(static_cast<size_t>(key_count));
+    std::vector<double> timestamps(static_cast<size_t>(frame_count));
+    for (auto &k : keyframes) {
+        int32_t v = 0;
+        if (!readPod(in, v)) return false;
+        k = v;
+    }
+    for (auto &t : timestamps) {
+        if (!readPod(in, t)) return false;
+    }
+    keyframes_ = std::move(keyframes);
+    timestamps_ms_ = std::move(timestamps);
+    return true;
+}
+
+bool KeyframeIndex::save(const std::string &cache_path, const std::string &video_path) const {
+    VideoStamp stamp;
+    if (!statVideo(video_path, stamp)) return false;
+
+    std::ofstream out(cache_path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(kMagic, sizeof(kMagic));
+    writePod(out, stamp.size);
+    writePod(out, stamp.mtime);
+    writePod(out, static_cast<int32_t>(keyframes_.size()));
+    writePod(out, static_cast<int32_t>(timestamps_ms_.size()));
+    for (int k : keyframes_) writePod(out, static_cast<int32_t>(k));
+    for (double t : timestamps_ms_) writePod(out, t);
+    return static_cast<bool>(out);
+}
+
+int KeyframeIndex::keyframeAtOrBefore(int frame) const {
+    const auto it = std::upper_bound(keyframes_.begin(), keyframes_.end(), frame);
+    return it == keyframes_.begin() ? 0 : *std::prev(it);
+}
+
+double KeyframeIndex::timestampMs(int frame) const {
+    if (frame < 0 || frame >= frameCount()) return -1.0;
+    return timestamps_ms_[static_cast<size_t>(frame)];
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// 视频关键帧 / 时间戳索引：打开文件时只解复用（不解码）扫描一遍得到，缓存在视频旁的 <视频>.kfidx 文件中。
+// 用途：稀疏采样时判断跳到关键帧是否比逐帧 grab 更划算；以及 O(GOP) 地随机访问任意帧（见 VideoSeeker）。
+// 帧号按包顺序计数，存在 B 帧时关键帧位置是近似值，只用于估算跳转代价，精确定位交给 VideoCapture。
+class KeyframeIndex {
+public:
+    KeyframeIndex() = default;
+    KeyframeIndex(std::vector<int> keyframes, std::vector<double> timestamps_ms);
+
+    // 扫描视频文件（FFmpeg 原始包模式，不解码）；后端不支持时返回空索引
+    static KeyframeIndex build(const std::string &video_path);
+    // 优先读取缓存（视频大小与修改时间一致才有效），否则重新扫描并尽量写回缓存（目录只读时忽略）
+    static KeyframeIndex loadOrBuild(const std::string &video_path, bool use_cache = true);
+    static std::string cachePath(const std::string &video_path);
+
+    bool load(const std::string &cache_path, const std::string &video_path);
+    bool save(const std::string &cache_path, const std::string &video_path) const;
+
+    bool empty() const { return keyframes_.empty(); }
+    int frameCount() const { return static_cast<int>(timestamps_ms_.size()); }
+    const std::vector<int> &keyframes() const { return keyframes_; }
+
+    // 不晚于 frame 的最近关键帧（frame 之前没有关键帧时返回 0）
+    int keyframeAtOrBefore(int frame) const;
+    // 帧的显示时间戳（毫秒）；超出范围返回 -1
+    double timestampMs(int frame) const;
+
+private:
+    std::vector<int> keyframes_;         // 升序
+    std::vector<double> timestamps_ms_;  // 按显示顺序
+};
@@ -0,0 +1,89 @@
+#include "core/capture/LiveFrameGrabber.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/capture/MatBuffer.h"
+
+LiveFrameGrabber::LiveFrameGrabber(ReadFn read, size_t keep)
+    : read_(std::move(read)), keep_(std::max<size_t>(keep, 1)) {
+    worker_ = std::thread(&LiveFrameGrabber::grabLoop, this);
+}
+
+LiveFrameGrabber::~LiveFrameGrabber() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_.notify_all();
+    // 采集线程最多再阻塞在一次驱动读取上
+    if (worker_.joinable()) worker_.join();
+}
+
+bool LiveFrameGrabber::next(cv::Mat &frame) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // 调用方不再引用上一帧时，把缓冲交回采集线程复用（包装外部数据的 Mat 不回收）
+    if (IsSoleOwner(frame) && spare_.size() <= keep_) spare_.push_back(std::move(frame));
+    frame.release();
+
+    ready_.wait(lock, [&] { return finished_ || !frames_.empty(); });
+    if (frames_.empty()) {
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+        return false;
+    }
+
+    Slot slot = std::move(frames_.front());
+    frames_.pop_front();
+    frame = std::move(slot.frame);
+    stats_.last_capture_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(slot.stamp.time_since_epoch()).count();
+    stats_.last_wait_ms = std::chrono::duration<double, std::milli>(Clock::now() - slot.stamp).count();
+    return true;
+}
+
+CaptureStats LiveFrameGrabber::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void LiveFrameGrabber::grabLoop() {
+    try {
+        cv::Mat buf;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stop_) break;
+                if (buf.empty() && !spare_.empty()) {
+                    buf = std::move(spare_.back());
+                    spare_.pop_back();
+                }
+            }
+
+            // 驱动读取在锁外进行，不阻塞消费方
+            if (!read_(buf) || buf.empty()) break;
+            const Clock::time_point stamp = Clock::now();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.captured;
+                frames_.push_back({std::move(buf), stamp});
+                buf.release();
+                if (frames_.size() > keep_) {
+                    // 最旧的帧来不及处理：丢弃，并把它的缓冲留作下一次读取的目标
+                    buf = std::move(frames_.front().frame);
+                    frames_.pop_front();
+                    ++stats_.dropped;
+                }
+            }
+            ready_.notify_one();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+    }
+    ready_.notify_all();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "core/capture/IImageIterator.h"
+
+// 实时采集器（最新帧优先）：采集线程以驱动速率持续读取，只保留最新的 keep 帧；
+// 消费方处理得慢时，旧帧被新帧挤掉并计入丢帧数，因此取到的帧最多比最新画面落后 keep 帧。
+// 被挤掉的帧与调用方交回的帧缓冲会回收给采集线程复用。
+class LiveFrameGrabber {
+public:
+    // read 在采集线程上调用：成功读到一帧写入参数并返回 true；返回 false 表示数据源结束
+    using ReadFn = std::function<bool(cv::Mat &)>;
+
+    LiveFrameGrabber(ReadFn read, size_t keep);
+    ~LiveFrameGrabber();
+
+    LiveFrameGrabber(const LiveFrameGrabber &) = delete;
+    LiveFrameGrabber &operator=(const LiveFrameGrabber &) = delete;
+
+    // 阻塞直到有尚未取走的帧；多帧时按采集顺序取最早的一帧。数据源结束且已取完时返回 false
+    bool next(cv::Mat &frame);
+
+    CaptureStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        cv::Mat frame;
+        Clock::time_point stamp;
+    };
+
+    void grabLoop();
+
+    ReadFn read_;
+    const size_t keep_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Slot> frames_;
+    std::vector<cv::Mat> spare_;   // 可复用的空闲缓冲
+    CaptureStats stats_;
+    bool stop_ = false;
+    bool finished_ = false;
+    std::exception_ptr error_;
+    std::thread worker_;
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+// m 的像素缓冲是否只被 m 自己引用（即可以安全地复用、覆盖写入）。
+// 引用计数由其它线程上的 Mat 拷贝/析构通过 CV_XADD 原子修改，这里同样用 CV_XADD(..., 0) 原子读取；
+// 包装外部数据的 Mat（u 为空）不归 OpenCV 管理，一律视为不可复用
+inline bool IsSoleOwner(const cv::Mat &m) {
+    return !m.empty() && m.u && CV_XADD(&m.u->refcount, 0) == 1;
+}
@@ -13,8 +13,9 @@ int calcFrameStep(double source_fps, double sample_fps) {
 }
 }  // namespace
 
-VideoFileIterator::VideoFileIterator(const std::string &path, double sample_fps)
-    : cap_(path), sample_fps_(sample_fps) {
+VideoFileIterator::VideoFileIterator(const std::string &path, double sample_fps, const CaptureConfig &cfg,
+                                     const SampleRange &range)
+    : cap_(path), seeker_(cap_, cfg.seek_overhead_frames), sample_fps_(sample_fps) {
     if (!cap_.isOpened()) {
         throw std::runtime_error("无法打开视频文件: " + path);
     }
@@ -30,6 +31,25 @@ VideoFileIterator::VideoFileIterator(const std::string &path, double sample_fps)
         total_frames_ = static_cast<int>(total);
         sample_total_frames_ = (total_frames_ + frame_step_ - 1) / frame_step_;
     }
+    if (range.end >= 0) {
+        sample_total_frames_ = sample_total_frames_ > 0 ? std::min(sample_total_frames_, range.end) : range.end;
+    }
+
+    // 步长足够大、跳转可能省下解码时才建立关键帧索引
+    if (cfg.seek_sampling && frame_step_ - 1 > cfg.seek_overhead_frames) {
+        seeker_.setIndex(KeyframeIndex::loadOrBuild(path, cfg.cache_keyframe_index));
+    }
+
+    // 从区间起点开始：直接定位到第一个采样帧（seek 失败时由 readSample 逐帧 grab 过去）
+    range_begin_ = std::max(0, range.begin);
+    sample_index_ = decoded_ = range_begin_;
+    if (range_begin_ > 0) seeker_.seek(range_begin_ * frame_step_ + frame_step_ - 1);
+
+    // 预解码：之后 cap_ 只由解码线程访问
+    if (cfg.prefetch_depth > 0) {
+        prefetcher_ = std::make_unique<FramePrefetcher>(
+            [this](cv::Mat &frame) { return readSample(frame); }, static_cast<size_t>(cfg.prefetch_depth));
+    }
 }
 
 bool VideoFileIterator::hasNext() const {
@@ -41,15 +61,8 @@ bool VideoFileIterator::hasNext() const {
 bool VideoFileIterator::next(cv::Mat &frame) {
     if (!hasNext()) return false;
 
-    // 先快速跳过 frame_step_-1 帧，再读取一帧作为输出
-    for (int i = 0; i < frame_step_ - 1; ++i) {
-        if (!cap_.grab()) {
-            finished_ = true;
-            return false;
-        }
-    }
-
-    if (!cap_.read(frame) || frame.empty()) {
+    const bool ok = prefetcher_ ? prefetcher_->next(frame) : readSample(frame);
+    if (!ok) {
         finished_ = true;
         return false;
     }
@@ -57,17 +70,28 @@ bool VideoFileIterator::next(cv::Mat &frame) {
     return true;
 }
 
+bool VideoFileIterator::readSample(cv::Mat &frame) {
+    // 与同步模式一致：不超出按总帧数计算出的采样帧数
+    if (sample_total_frames_ > 0 && decoded_ >= sample_total_frames_) return false;
+
+    // 第 k 个采样帧为源帧 k*step + step-1（先跳过 frame_step_-1 帧，再读取一帧作为输出）
+    const int target = decoded_ * frame_step_ + frame_step_ - 1;
+    if (!seeker_.read(target, frame)) return false;
+    ++decoded_;
+    return true;
+}
+
 FrameSourceInfo VideoFileIterator::info() const {
     FrameSourceInfo info;
     info.is_live = false;
-    info.total_frames = sample_total_frames_;
+    info.total_frames = sample_total_frames_ >= 0 ? std::max(0, sample_total_frames_ - range_begin_) : -1;
     info.source_fps = source_fps_;
     info.sample_fps = sample_fps_;
     info.frame_step = frame_step_;
     return info;
 }
 
-CameraIterator::CameraIterator(int cameraIndex, double sample_fps)
+CameraIterator::CameraIterator(int cameraIndex, double sample_fps, const CaptureConfig &cfg)
     : cap_(cameraIndex), sample_fps_(sample_fps) {
     if (!cap_.isOpened()) {
         throw std::runtime_error("无法打开摄像头: index=" + std::to_string(cameraIndex));
@@ -81,6 +105,13 @@ CameraIterator::CameraIterator(int cameraIndex, double sample_fps)
     if (sample_fps_ > 0.0 && source_fps_ > 0.0) {
         sample_fps_ = source_fps_ / static_cast<double>(frame_step_);
     }
+
+    // 实时模式：驱动侧缓冲尽量缩小（部分后端不支持，忽略返回值），之后 cap_ 只由采集线程访问
+    if (cfg.live_mode) {
+        cap_.set(cv::CAP_PROP_BUFFERSIZE, 1);
+        grabber_ = std::make_unique<LiveFrameGrabber>(
+            [this](cv::Mat &frame) { return readSample(frame); }, static_cast<size_t>(std::max(1, cfg.live_keep_frames)));
+    }
 }
 
 bool CameraIterator::hasNext() const {
@@ -91,21 +122,22 @@ bool CameraIterator::hasNext() const {
 bool CameraIterator::next(cv::Mat &frame) {
     if (finished_) return false;
 
-    // 跳过多余帧（若 frame_step_ > 1）
-    for (int i = 0; i < frame_step_ - 1; ++i) {
-        if (!cap_.grab()) {
-            finished_ = true;
-            return false;
-        }
-    }
-
-    if (!cap_.read(frame) || frame.empty()) {
+    const bool ok = grabber_ ? grabber_->next(frame) : readSample(frame);
+    if (!ok) {
         finished_ = true;
         return false;
     }
     return true;
 }
 
+bool CameraIterator::readSample(cv::Mat &frame) {
+    // 跳过多余帧（若 frame_step_ > 1）
+    for (int i = 0; i < frame_step_ - 1; ++i) {
+        if (!cap_.grab()) return false;
+    }
+    return cap_.read(frame) && !frame.empty();
+}
+
 FrameSourceInfo CameraIterator::info() const {
     FrameSourceInfo info;
     info.is_live = true;
@@ -116,15 +148,20 @@ FrameSourceInfo CameraIterator::info() const {
     return info;
 }
 
-VideoFrameSource::VideoFrameSource(const std::string &path, double sample_fps)
-    : source_(path), sample_fps_(sample_fps) {}
+CaptureStats CameraIterator::stats() const {
+    // 同步读取模式不统计
+    return grabber_ ? grabber_->stats() : CaptureStats{};
+}
+
+VideoFrameSource::VideoFrameSource(const std::string &path, double sample_fps, const CaptureConfig &cfg)
+    : source_(path), sample_fps_(sample_fps), cfg_(cfg) {}
 
-VideoFrameSource::VideoFrameSource(int cameraIndex, double sample_fps)
-    : source_(cameraIndex), sample_fps_(sample_fps) {}
+VideoFrameSource::VideoFrameSource(int cameraIndex, double sample_fps, const CaptureConfig &cfg)
+    : source_(cameraIndex), sample_fps_(sample_fps), cfg_(cfg) {}
 
 std::unique_ptr<IImageIterator> VideoFrameSource::createIterator() const {
     if (std::holds_alternative<std::string>(source_)) {
-        return std::make_unique<VideoFileIterator>(std::get<std::string>(source_), sample_fps_);
+        return std::make_unique<VideoFileIterator>(std::get<std::string>(source_), sample_fps_, cfg_);
     }
-    return std::make_unique<CameraIterator>(std::get<int>(source_), sample_fps_);
+    return std::make_unique<CameraIterator>(std::get<int>(source_), sample_fps_, cfg_);
 }
@@ -1,51 +1,79 @@
 #pragma once
 
+#include "core/capture/CaptureConfig.h"
+#include "core/capture/FramePrefetcher.h"
 #include "core/capture/IImageIterator.h"
+#include "core/capture/LiveFrameGrabber.h"
+#include "core/capture/VideoSeeker.h"
 #include <opencv2/videoio.hpp>
 #include <memory>
 #include <string>
 #include <variant>
 
+// 采样帧区间 [begin, end)；end<0 表示直到文件结束
+struct SampleRange {
+    int begin = 0;
+    int end = -1;
+};
+
+// 视频文件迭代器；可只读取部分采样帧（分段离线处理时，起点通过 seek 直接定位）
 class VideoFileIterator : public IImageIterator {
 public:
-    explicit VideoFileIterator(const std::string &path, double sample_fps = 0.0);
+    explicit VideoFileIterator(const std::string &path, double sample_fps = 0.0, const CaptureConfig &cfg = {},
+                               const SampleRange &range = {});
     bool hasNext() const override;
     bool next(cv::Mat &frame) override;
     FrameSourceInfo info() const override;
 private:
+    // 按采样步长解码下一帧（预解码模式下在解码线程上调用）
+    bool readSample(cv::Mat &frame);
+
     cv::VideoCapture cap_;
+    VideoSeeker seeker_;
     bool finished_ = false;
     double source_fps_ = 0.0;
     double sample_fps_ = 0.0;
     int frame_step_ = 1;
     int total_frames_ = -1;
     int sample_total_frames_ = -1;
+    int range_begin_ = 0;
     int sample_index_ = 0;
+    // 已解码的采样帧数（预解码时领先于 sample_index_）
+    int decoded_ = 0;
+    // 最后声明：析构时先停止解码线程，再释放 cap_
+    std::unique_ptr<FramePrefetcher> prefetcher_;
 };
 
 // 摄像头迭代器（实时读取，不会自然结束；除非读取失败或摄像头被关闭）
 class CameraIterator : public IImageIterator {
 public:
-    explicit CameraIterator(int cameraIndex, double sample_fps = 0.0);
+    explicit CameraIterator(int cameraIndex, double sample_fps = 0.0, const CaptureConfig &cfg = {});
     bool hasNext() const override;
     bool next(cv::Mat &frame) override;
     FrameSourceInfo info() const override;
+    CaptureStats stats() const override;
 private:
+    // 按采样步长读取下一帧（实时模式下在采集线程上调用）
+    bool readSample(cv::Mat &frame);
+
     cv::VideoCapture cap_;
     bool finished_ = false;
     double source_fps_ = 0.0;
     double sample_fps_ = 0.0;
     int frame_step_ = 1;
+    // 最后声明：析构时先停止采集线程，再释放 cap_
+    std::unique_ptr<LiveFrameGrabber> grabber_;
 };
 
 class VideoFrameSource {
 public:
-    explicit VideoFrameSource(const std::string &path, double sample_fps = 0.0);
+    explicit VideoFrameSource(const std::string &path, double sample_fps = 0.0, const CaptureConfig &cfg = {});
     // 新增摄像头数据源（例如 0 号摄像头）
-    explicit VideoFrameSource(int cameraIndex, double sample_fps = 0.0);
+    explicit VideoFrameSource(int cameraIndex, double sample_fps = 0.0, const CaptureConfig &cfg = {});
     std::unique_ptr<IImageIterator> createIterator() const;
 private:
     // 用 variant 表示“文件”或“摄像头”两种数据源
     std::variant<std::string, int> source_;
     double sample_fps_ = 0.0;
+    CaptureConfig cfg_;
 };
@@ -0,0 +1,29 @@
+#include "core/capture/VideoSeeker.h"
+
+#include <algorithm>
+
+VideoSeeker::VideoSeeker(cv::VideoCapture &cap, int seek_overhead_frames)
+    : cap_(cap), seek_overhead_frames_(std::max(0, seek_overhead_frames)) {}
+
+bool VideoSeeker::read(int frame, cv::Mat &out) {
+    if (frame < 0) return false;
+
+    // 逐帧 grab 需要解码 frame-pos_ 帧；seek 只需从 frame 之前的关键帧解码起
+    const bool backward = frame < pos_;
+    const bool cheaper = !index_.empty() && index_.keyframeAtOrBefore(frame) - pos_ > seek_overhead_frames_;
+    if ((backward || cheaper) && !seek(frame) && backward) return false;
+
+    for (; pos_ < frame; ++pos_, ++grabs_) {
+        if (!cap_.grab()) return false;
+    }
+    if (!cap_.read(out) || out.empty()) return false;
+    ++pos_;
+    return true;
+}
+
+bool VideoSeeker::seek(int frame) {
+    if (frame < 0 || !cap_.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(frame))) return false;
+    pos_ = frame;
+    ++seeks_;
+    return true;
+}
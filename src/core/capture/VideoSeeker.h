@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include <opencv2/videoio.hpp>
+
+#include "core/capture/KeyframeIndex.h"
+
+// 按源帧号读取视频帧：向后跳读时，若目标之前、当前位置之后存在关键帧，且省下的解码帧数超过跳转开销，
+// 就直接 seek（从关键帧解码到目标，O(GOP)），否则逐帧 grab；向前（回退）读取总是 seek。
+// 没有索引时退化为逐帧 grab，结果与顺序读取一致。
+class VideoSeeker {
+public:
+    explicit VideoSeeker(cv::VideoCapture &cap, int seek_overhead_frames = 2);
+
+    void setIndex(KeyframeIndex index) { index_ = std::move(index); }
+    const KeyframeIndex &index() const { return index_; }
+
+    // 读取源帧号为 frame 的一帧；失败（越界/读取出错）返回 false
+    bool read(int frame, cv::Mat &out);
+    // 定位到源帧号 frame（下一次顺序读取即得到该帧）
+    bool seek(int frame);
+
+    // 下一次顺序读取将得到的帧号
+    int position() const { return pos_; }
+    size_t seeks() const { return seeks_; }
+    size_t grabs() const { return grabs_; }
+
+private:
+    cv::VideoCapture &cap_;
+    KeyframeIndex index_;
+    int seek_overhead_frames_ = 2;
+    int pos_ = 0;
+    size_t seeks_ = 0;
+    size_t grabs_ = 0;
+};
@@ -0,0 +1,261 @@
+#include "FrameProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "TrackingEngine.h"
+
+namespace {
+// 判断 bbox（像素坐标）中心点是否在 ROI 内
+bool centerInRoi(const cv::Rect &bbox, const RoiLayout &roi) {
+    const float cx = static_cast<float>(bbox.x) + static_cast<float>(bbox.width) * 0.5F;
+    const float cy = static_cast<float>(bbox.y) + static_cast<float>(bbox.height) * 0.5F;
+    return roi.contains(cv::Point2f(cx, cy));
+}
+
+// 各区域的检测结果（区域局部坐标）按区域左上角偏移映射回原帧坐标系，追加到 out
+void appendRegionBoxes(const std::vector<cv::Rect> &regions, std::vector<std::vector<BBox>> &region_boxes,
+                       std::vector<BBox> &out) {
+    for (size_t k = 0; k < region_boxes.size() && k < regions.size(); ++k) {
+        for (auto &b : region_boxes[k]) {
+            b.box.x += static_cast<float>(regions[k].x);
+            b.box.y += static_cast<float>(regions[k].y);
+            out.push_back(b);
+        }
+    }
+}
+
+// 检测框裁剪到帧内后的整数像素区域；为空时返回 false
+bool cropRect(const BBox &box, const cv::Rect2f &frame_rect, cv::Rect &roi) {
+    const cv::Rect2f roi_f = box.box & frame_rect;
+    if (roi_f.width <= 0 || roi_f.height <= 0) return false;
+    roi = cv::Rect(cv::Point(static_cast<int>(roi_f.x), static_cast<int>(roi_f.y)),
+                   cv::Size(static_cast<int>(roi_f.width), static_cast<int>(roi_f.height)));
+    return roi.width > 0 && roi.height > 0;
+}
+}  // namespace
+
+FrameProcessor::FrameProcessor(std::unique_ptr<IDetector> detector,
+                               std::unique_ptr<IFeatureExtractor> extractor,
+                               std::unique_ptr<TrackerManager> tracker_mgr,
+                               const TrackingEngineConfig &cfg,
+                               double dt)
+    : detector_(std::move(detector)),
+      extractor_(std::move(extractor)),
+      tracker_mgr_(std::move(tracker_mgr)),
+      roi_(cfg.roi),
+      dt_(dt),
+      selective_reid_(cfg.tracker_mgr.reid_gate.enabled),
+      keyframe_interval_(std::max(1, cfg.keyframe.interval)),
+      keyframe_adaptive_(cfg.keyframe.adaptive),
+      keyframe_max_interval_(std::max(keyframe_interval_, cfg.keyframe.max_interval)),
+      adaptive_interval_(keyframe_interval_),
+      local_detection_(cfg.local_detection.enabled),
+      full_frame_interval_(std::max(1, cfg.local_detection.full_frame_interval)),
+      local_padding_(std::max(0.0F, cfg.local_detection.padding)),
+      min_region_size_(std::max(1, cfg.local_detection.min_region_size)),
+      max_area_ratio_(cfg.local_detection.max_area_ratio) {}
+
+bool FrameProcessor::isKeyframe(int frame_index) const {
+    if (keyframe_adaptive_) {
+        // 流水线模式下 track 步骤稍有滞后，读到旧值只会让检测更频繁，不会漏掉关键帧
+        return frame_index >= next_keyframe_.load(std::memory_order_acquire);
+    }
+    return frame_index % keyframe_interval_ == 0;
+}
+
+void FrameProcessor::scheduleKeyframe(int frame_index) {
+    if (!keyframe_adaptive_) return;
+    // 没有新目标、没有轨迹增减时视为稳定，间隔翻倍；否则回到最小间隔
+    const TrackerUpdateStats &stats = tracker_mgr_->lastUpdateStats();
+    const bool stable = stats.created == 0 && stats.removed == 0 && stats.pending == 0;
+    adaptive_interval_ = stable ? std::min(adaptive_interval_ * 2, keyframe_max_interval_) : keyframe_interval_;
+    next_keyframe_.store(frame_index + adaptive_interval_, std::memory_order_release);
+}
+
+void FrameProcessor::detect(FrameTask &task) {
+    detect(task, *detector_);
+}
+
+void FrameProcessor::detect(FrameTask &task, IDetector &detector) {
+    // 根据当前帧尺寸换算 ROI（区域固定，但像素值依赖视频分辨率；尺寸不变时复用预计算的几何与掩膜）
+    {
+        std::lock_guard<std::mutex> lock(roi_mutex_);
+        if (!roi_layout_ || roi_layout_->frameSize() != task.frame.size()) {
+            roi_layout_ = std::make_shared<const RoiLayout>(roi_, task.frame.size());
+        }
+        task.roi = roi_layout_;
+    }
+    const RoiLayout &roi = *task.roi;
+
+    task.keyframe = isKeyframe(task.frame_index);
+    task.boxes.clear();
+    if (!task.keyframe) return;
+
+    // 局部检测：两次整帧检测之间只检测轨迹周围的区域（合成一个 batch 推理），
+    // 与 ROI 一样按区域左上角偏移映射回原帧坐标系
+    if (local_detection_ && task.frame_index < next_full_frame_ && buildLocalRegions(roi.bounds())) {
+        if (local_regions_.empty()) return;
+        auto region_boxes = detector.detectRegions(task.frame, local_regions_, task.frame_index);
+        appendRegionBoxes(local_regions_, region_boxes, task.boxes);
+        return;
+    }
+    if (local_detection_) next_full_frame_ = task.frame_index + full_frame_interval_;
+
+    // 检测结果直接写入 task.boxes（串行模式下 task 帧间复用，容量保留）
+    if (!roi.active()) {
+        detector.detect(task.frame, task.frame_index, task.boxes);
+        return;
+    }
+
+    // 若启用 ROI，则仅对各区域的裁剪（重叠的已合并）做检测，计算量随覆盖面积增长；
+    // 多个裁剪合成一个 batch 推理，检测结果加上裁剪左上角偏移映射回原帧坐标系。
+    const std::vector<cv::Rect> &crops = roi.crops();
+    if (crops.size() == 1) {
+        detector.detect(task.frame(crops.front()), task.frame_index, task.boxes);
+        for (auto &b : task.boxes) {
+            b.box.x += static_cast<float>(crops.front().x);
+            b.box.y += static_cast<float>(crops.front().y);
+        }
+        return;
+    }
+    auto region_boxes = detector.detectRegions(task.frame, crops, task.frame_index);
+    appendRegionBoxes(crops, region_boxes, task.boxes);
+}
+
+bool FrameProcessor::buildLocalRegions(const cv::Rect &bounds) {
+    {
+        std::lock_guard<std::mutex> lock(guide_mutex_);
+        guide_snapshot_.assign(guide_boxes_.begin(), guide_boxes_.end());
+    }
+
+    // 1) 每个框向四周外扩（不小于最小边长），裁剪到检测范围内
+    local_regions_.clear();
+    for (const auto &box : guide_snapshot_) {
+        const float w = std::max(box.width * (1.0F + 2.0F * local_padding_), static_cast<float>(min_region_size_));
+        const float h = std::max(box.height * (1.0F + 2.0F * local_padding_), static_cast<float>(min_region_size_));
+        const float cx = box.x + box.width * 0.5F;
+        const float cy = box.y + box.height * 0.5F;
+        const cv::Rect region = cv::Rect(cv::Point(static_cast<int>(std::floor(cx - w * 0.5F)),
+                                                   static_cast<int>(std::floor(cy - h * 0.5F))),
+                                         cv::Point(static_cast<int>(std::ceil(cx + w * 0.5F)),
+                                                   static_cast<int>(std::ceil(cy + h * 0.5F)))) & bounds;
+        if (region.area() > 0) local_regions_.push_back(region);
+    }
+
+    // 2) 相互重叠的区域合并为外接矩形
+    MergeOverlappingRects(local_regions_);
+
+    // 3) 区域覆盖了检测范围的大部分时，局部检测不再划算
+    int64_t area = 0;
+    for (const auto &region : local_regions_) area += region.area();
+    return static_cast<double>(area) <= static_cast<double>(max_area_ratio_) * static_cast<double>(bounds.area());
+}
+
+void FrameProcessor::publishGuideBoxes() {
+    std::lock_guard<std::mutex> lock(guide_mutex_);
+    guide_boxes_.clear();
+    for (const auto &inner : tracker_mgr_->tracks().inners()) guide_boxes_.push_back(inner.box.box);
+    for (const auto &pending : tracker_mgr_->pendingDetections()) guide_boxes_.push_back(pending.box.box);
+}
+
+void FrameProcessor::extract(FrameTask &task) {
+    task.dets.clear();
+    // 选择性 ReID 需要最新的轨迹状态，抽特征推迟到 track 步骤中进行
+    if (!task.keyframe || selective_reid_) return;
+    task.dets.reserve(task.boxes.size());
+
+    // 先收集所有裁剪区域，再一次性批量抽特征（同一次 ORT Run 处理整帧的框）
+    // rois/box_indices 为成员缓冲，帧间复用容量
+    auto &rois = extract_rois_;
+    auto &box_indices = extract_box_indices_;
+    rois.clear();
+    box_indices.clear();
+    const cv::Rect2f frame_rect(0, 0, static_cast<float>(task.frame.cols), static_cast<float>(task.frame.rows));
+    for (size_t i = 0; i < task.boxes.size(); ++i) {
+        // 裁剪区域；若超界则 clip
+        cv::Rect roi;
+        if (!cropRect(task.boxes[i], frame_rect, roi)) continue;
+        rois.push_back(roi);
+        box_indices.push_back(i);
+    }
+
+    const size_t dim = extractor_->extractBatch(task.frame, rois, extract_feats_);
+    const size_t rows = dim > 0 ? extract_feats_.size() / dim : 0;
+    for (size_t k = 0; k < rows && k < box_indices.size(); ++k) {
+        task.dets.push_back(TrackerInner{task.boxes[box_indices[k]], TrackFeature(extract_feats_.data() + k * dim, dim)});
+    }
+}
+
+void FrameProcessor::track(FrameTask &task) {
+    // ===卡尔曼滤波根据上一帧的状态对这一帧的结果进行预测===
+    // 1) 预测所有轨迹
+    tracker_mgr_->predictAll(static_cast<float>(dt_));
+
+    // 2) 输出所有traker对于当前这一帧的预测结果（统一由 TrackerManager 负责组装，避免各处重复实现）
+    tracker_mgr_->fillLabeledFrame(task.frame_index, task.label);
+
+    // ROI 模式下，只输出中心落在某个区域内的标注（bbox 坐标仍是原帧坐标系）
+    if (task.roi && task.roi->active()) {
+        auto &objs = task.label.objs;
+        objs.erase(
+            std::remove_if(objs.begin(), objs.end(), [&](const LabeledObject &obj) {
+                return !centerInRoi(obj.bbox, *task.roi);
+            }),
+            objs.end()
+        );
+    }
+
+    // 3) 用本帧检测结果更新所有tracker的状态；非关键帧没有检测，
+    //    只输出预测，也不做未命中更新（否则轨迹会在跳过检测的帧上被扣血）
+    if (task.keyframe) {
+        if (selective_reid_) {
+            // 先按运动预测规划，只为有歧义/新目标/特征过旧的检测抽取特征
+            tracker_mgr_->planReid(task.boxes, reid_plan_);
+            extractPlanned(task);
+            tracker_mgr_->update(task.dets, reid_plan_);
+        } else {
+            tracker_mgr_->update(task.dets);
+        }
+        scheduleKeyframe(task.frame_index);
+    }
+    if (local_detection_) publishGuideBoxes();
+}
+
+void FrameProcessor::extractPlanned(FrameTask &task) {
+    // task.dets 与检测框一一对应；不需要特征的检测保留空特征
+    task.dets.resize(task.boxes.size());
+    auto &rois = extract_rois_;
+    auto &box_indices = extract_box_indices_;
+    rois.clear();
+    box_indices.clear();
+    const cv::Rect2f frame_rect(0, 0, static_cast<float>(task.frame.cols), static_cast<float>(task.frame.rows));
+    for (size_t i = 0; i < task.boxes.size(); ++i) {
+        task.dets[i].box = task.boxes[i];
+        task.dets[i].feature = TrackFeature();
+        task.dets[i].age = 0;
+        ReidAction &action = reid_plan_.actions[i];
+        if (action != ReidAction::Extract && action != ReidAction::Refresh) continue;
+        cv::Rect roi;
+        if (!cropRect(task.boxes[i], frame_rect, roi)) {
+            // 无法裁剪：刷新推迟，有歧义的检测本帧放弃
+            action = action == ReidAction::Refresh ? ReidAction::Reuse : ReidAction::Drop;
+            continue;
+        }
+        rois.push_back(roi);
+        box_indices.push_back(i);
+    }
+
+    const size_t dim = extractor_->extractBatch(task.frame, rois, extract_feats_);
+    const size_t rows = dim > 0 ? extract_feats_.size() / dim : 0;
+    for (size_t k = 0; k < box_indices.size(); ++k) {
+        const size_t i = box_indices[k];
+        if (k < rows) {
+            task.dets[i].feature = TrackFeature(extract_feats_.data() + k * dim, dim);
+        } else {
+            ReidAction &action = reid_plan_.actions[i];
+            action = action == ReidAction::Refresh ? ReidAction::Reuse : ReidAction::Drop;
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "model/detector/IDetector.h"
+#include "model/feature_extractor/IFeatureExtractor.h"
+#include "tracker_manager/TrackerManager.h"
+#include "RoiLayout.h"
+#include "config/RoiConfig.h"
+#include "structure/LabeledData.h"
+
+struct TrackingEngineConfig;
+
+// 单帧在引擎各步骤之间流转的数据（串行与流水线模式共用）
+struct FrameTask {
+    int frame_index = 0;
+    cv::Mat frame;                    // 原始帧
+    std::shared_ptr<const RoiLayout> roi;  // 本帧尺寸下的像素 ROI 几何（detect 步骤设置）
+    bool keyframe = true;             // 本帧是否运行检测（非关键帧只输出卡尔曼预测）
+    std::vector<BBox> boxes;          // 检测结果（已映射回原帧坐标系）
+    std::vector<TrackerInner> dets;   // 带特征的检测结果
+    LabeledFrame label;               // 本帧输出
+};
+
+// 把一帧的处理拆成 detect / extract / track 三个步骤：
+// 串行模式按顺序调用；流水线模式下每个步骤固定在某一个阶段线程里执行，
+// 因此同一个组件（检测器/特征提取器/TrackerManager）永远只会被一个线程访问。
+// 选择性 ReID 模式下特征提取器只在 track 步骤中使用（extract 为空操作），该性质不变。
+class FrameProcessor {
+public:
+    FrameProcessor(std::unique_ptr<IDetector> detector,
+                   std::unique_ptr<IFeatureExtractor> extractor,
+                   std::unique_ptr<TrackerManager> tracker_mgr,
+                   const TrackingEngineConfig &cfg,
+                   double dt);
+
+    // 计算 ROI、判定关键帧并检测边界框（非关键帧不检测；局部检测模式下只检测轨迹周围的区域）
+    void detect(FrameTask &task);
+    // 同上，但使用指定的检测器。statelessDetection() 为 true 时可在多个线程上（各用各的检测器）
+    // 对不同帧并发调用，供前瞻并行检测使用
+    void detect(FrameTask &task, IDetector &detector);
+    // 检测是否与轨迹状态无关（未开启自适应关键帧与局部检测）：此时各帧的检测可以乱序、并发执行
+    bool statelessDetection() const { return !keyframe_adaptive_ && !local_detection_; }
+    // 为检测框抽取 ReID 特征（选择性 ReID 模式下为空操作，由 track 按规划抽取）
+    void extract(FrameTask &task);
+    // 卡尔曼预测 + 输出标注 + 用本帧检测更新轨迹（必须按帧序调用）
+    void track(FrameTask &task);
+
+private:
+    // 选择性 ReID：按 reid_plan_ 只为需要的检测抽取特征
+    void extractPlanned(FrameTask &task);
+    // 该帧是否需要运行检测
+    bool isKeyframe(int frame_index) const;
+    // 关键帧更新后，自适应模式根据场景稳定程度安排下一个关键帧
+    void scheduleKeyframe(int frame_index);
+    // 局部检测：由最近发布的轨迹框生成外扩、合并后的检测区域（写入 local_regions_）；
+    // 区域总面积过大时返回 false，改做整帧检测
+    bool buildLocalRegions(const cv::Rect &bounds);
+    // track 步骤结束时发布当前轨迹与待确认检测的框，供后续帧的 detect 步骤生成局部区域
+    void publishGuideBoxes();
+
+    std::unique_ptr<IDetector> detector_;
+    std::unique_ptr<IFeatureExtractor> extractor_;
+    std::unique_ptr<TrackerManager> tracker_mgr_;
+    RoiConfig roi_;
+    // 帧尺寸变化时重建；前瞻并行检测时多个检测线程共享，由 roi_mutex_ 保护
+    std::mutex roi_mutex_;
+    std::shared_ptr<const RoiLayout> roi_layout_;
+    double dt_ = 1.0;
+
+    bool selective_reid_ = false;
+    ReidPlan reid_plan_;
+
+    int keyframe_interval_ = 1;
+    bool keyframe_adaptive_ = false;
+    int keyframe_max_interval_ = 1;
+    // 自适应模式：track 步骤写入下一个关键帧序号，detect 步骤读取（流水线下两者在不同线程）
+    std::atomic<int> next_keyframe_{0};
+    int adaptive_interval_ = 1;  // 只被 track 步骤访问
+
+    bool local_detection_ = false;
+    int full_frame_interval_ = 1;
+    float local_padding_ = 0.0F;
+    int min_region_size_ = 0;
+    float max_area_ratio_ = 1.0F;
+    int next_full_frame_ = 0;                 // 只被 detect 步骤访问
+    std::vector<cv::Rect> local_regions_;     // 只被 detect 步骤访问
+    std::vector<cv::Rect2f> guide_snapshot_;  // 只被 detect 步骤访问
+    // track 步骤写入、detect 步骤读取（流水线下两者在不同线程，读到稍旧的框由外扩余量吸收）
+    std::mutex guide_mutex_;
+    std::vector<cv::Rect2f> guide_boxes_;
+
+    // 抽特征的帧间复用缓冲（只被抽特征所在的那一个线程访问：
+    // 常规模式为 extract 步骤，选择性 ReID 模式为 track 步骤）
+    std::vector<cv::Rect> extract_rois_;
+    std::vector<size_t> extract_box_indices_;
+    std::vector<float> extract_feats_;  // 按行排列的本帧特征（extractBatch 原地输出）
+};
@@ -0,0 +1,147 @@
+#include "LookaheadDataIterator.h"
+
+#include <algorithm>
+
+LookaheadDataIterator::LookaheadDataIterator(std::unique_ptr<IImageIterator> iter,
+                                             std::unique_ptr<FrameProcessor> processor,
+                                             std::vector<std::unique_ptr<IDetector>> extra_detectors,
+                                             const LookaheadConfig &cfg)
+    : image_iter_(std::move(iter)),
+      processor_(std::move(processor)),
+      extra_detectors_(std::move(extra_detectors)),
+      order_(static_cast<size_t>(std::max(1, cfg.depth))),
+      work_(static_cast<size_t>(std::max(1, cfg.depth))) {
+    if (!image_iter_) {
+        order_.close();
+        work_.close();
+        return;
+    }
+
+    workers_.reserve(extra_detectors_.size() + 2);
+    workers_.emplace_back(&LookaheadDataIterator::decodeLoop, this);
+    workers_.emplace_back(&LookaheadDataIterator::detectLoop, this, nullptr);
+    for (auto &detector : extra_detectors_) {
+        workers_.emplace_back(&LookaheadDataIterator::detectLoop, this, detector.get());
+    }
+}
+
+LookaheadDataIterator::~LookaheadDataIterator() {
+    shutdown();
+}
+
+void LookaheadDataIterator::shutdown() {
+    // 关闭队列：解码线程的 push 失败退出；检测线程取完剩余的帧（不再检测）后退出
+    stop_.store(true, std::memory_order_release);
+    order_.close();
+    work_.close();
+    for (auto &t : workers_) {
+        if (t.joinable()) t.join();
+    }
+    workers_.clear();
+}
+
+void LookaheadDataIterator::fail(std::exception_ptr err) {
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) error_ = err;
+    }
+    stop_.store(true, std::memory_order_release);
+    order_.close();
+    work_.close();
+}
+
+void LookaheadDataIterator::decodeLoop() {
+    try {
+        int frame_index = 0;
+        while (image_iter_->hasNext()) {
+            auto job = std::make_shared<Job>();
+            job->task = std::make_unique<FrameTask>();
+            job->ready = job->detected.get_future();
+            if (!image_iter_->next(job->task->frame)) break;
+            job->task->frame_index = frame_index++;
+            // 先占住输出顺序上的位置（队列满即前瞻达到上限，在此阻塞），再交给检测线程
+            if (!order_.push(job)) return;
+            if (!work_.push(job)) {
+                // 已关闭：保证等待该帧的消费方能被唤醒
+                job->detected.set_value();
+                return;
+            }
+        }
+    } catch (...) {
+        fail(std::current_exception());
+        return;
+    }
+    order_.close();
+    work_.close();
+}
+
+void LookaheadDataIterator::detectLoop(IDetector *detector) {
+    JobPtr job;
+    while (work_.pop(job)) {
+        // 已停止时不再检测，但仍要兑现 promise，避免消费方永久等待
+        if (!stop_.load(std::memory_order_acquire)) {
+            try {
+                if (detector) {
+                    processor_->detect(*job->task, *detector);
+                } else {
+                    processor_->detect(*job->task);
+                }
+            } catch (...) {
+                fail(std::current_exception());
+            }
+        }
+        job->detected.set_value();
+        job.reset();
+    }
+}
+
+bool LookaheadDataIterator::fetch() const {
+    if (pending_) return true;
+    if (drained_) return false;
+    JobPtr job;
+    if (!order_.pop(job)) {
+        drained_ = true;
+        return false;
+    }
+    job->ready.wait();
+    // 出错停止后的帧没有做检测，不能交给跟踪
+    if (stop_.load(std::memory_order_acquire)) {
+        drained_ = true;
+        return false;
+    }
+    pending_ = std::move(job);
+    return true;
+}
+
+bool LookaheadDataIterator::hasNext() const {
+    if (fetch()) return true;
+    // 出错时仍返回 true，让下一次 next() 把异常抛给调用方
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    return error_ != nullptr;
+}
+
+bool LookaheadDataIterator::next(LabeledFrame &outFrame) {
+    if (!fetch()) {
+        std::exception_ptr err;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            err = error_;
+            error_ = nullptr;
+        }
+        if (err) std::rethrow_exception(err);
+        return false;
+    }
+
+    // ReID 与跟踪在调用方线程上严格按帧序执行
+    current_ = std::move(pending_);
+    FrameTask &task = *current_->task;
+    processor_->extract(task);
+    processor_->track(task);
+    outFrame = std::move(task.label);
+    return true;
+}
+
+const cv::Mat &LookaheadDataIterator::getFrame() const {
+    static const cv::Mat kEmpty;
+    return current_ ? current_->task->frame : kEmpty;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ILabeledDataIterator.h"
+#include "FrameProcessor.h"
+#include "TrackingEngine.h"
+#include "../capture/IImageIterator.h"
+#include "core/concurrency/BoundedQueue.h"
+
+// 前瞻并行检测的标注迭代器：
+// 解码线程按帧序读帧，同时放入“待检测”与“按序输出”两个队列；每个检测线程独占一个检测器，
+// 从待检测队列取帧并发检测；next() 按序取帧，等该帧检测完成后在调用方线程上做 ReID 与跟踪。
+// 按序输出队列的容量即前瞻深度：检测领先跟踪超过 depth 帧时解码阻塞。
+// 检测与轨迹状态无关（FrameProcessor::statelessDetection），因此输出与串行模式完全一致。
+class LookaheadDataIterator : public ILabeledDataIterator {
+public:
+    // 检测线程数为 1 + extra_detectors.size()：线程 0 使用 processor 自带的检测器，其余各用一个 extra_detectors
+    LookaheadDataIterator(std::unique_ptr<IImageIterator> iter,
+                          std::unique_ptr<FrameProcessor> processor,
+                          std::vector<std::unique_ptr<IDetector>> extra_detectors,
+                          const LookaheadConfig &cfg);
+    ~LookaheadDataIterator() override;
+
+    bool hasNext() const override;
+    bool next(LabeledFrame &outFrame) override;
+    const cv::Mat &getFrame() const override;
+
+private:
+    struct Job {
+        std::unique_ptr<FrameTask> task;
+        std::promise<void> detected;
+        std::future<void> ready;
+    };
+    using JobPtr = std::shared_ptr<Job>;
+
+    void decodeLoop();
+    // detector 为空时使用 processor 自带的检测器
+    void detectLoop(IDetector *detector);
+    void fail(std::exception_ptr err);
+    void shutdown();
+    // 取下一帧并等待其检测完成（hasNext 会预取一帧缓存起来）
+    bool fetch() const;
+
+    std::unique_ptr<IImageIterator> image_iter_;
+    std::unique_ptr<FrameProcessor> processor_;
+    std::vector<std::unique_ptr<IDetector>> extra_detectors_;
+
+    mutable BoundedQueue<JobPtr> order_;   // 按帧序等待跟踪（hasNext 预取时也要出队）
+    BoundedQueue<JobPtr> work_;            // 等待检测
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    mutable JobPtr pending_;   // hasNext 预取的帧（已检测完成）
+    mutable bool drained_ = false;
+    JobPtr current_;           // 最近一次 next 输出的帧（getFrame 返回其原图）
+};
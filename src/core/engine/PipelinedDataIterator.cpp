@@ -0,0 +1,139 @@
+#include "PipelinedDataIterator.h"
+
+#include <algorithm>
+
+PipelinedDataIterator::PipelinedDataIterator(std::unique_ptr<IImageIterator> iter,
+                                             std::unique_ptr<FrameProcessor> processor,
+                                             const PipelineConfig &cfg)
+    : image_iter_(std::move(iter)),
+      processor_(std::move(processor)) {
+    // 阶段 0 固定为解码；其余步骤依次各占一个阶段，放不下的全部合并进最后一个阶段
+    const std::vector<Step> steps = {Step::Detect, Step::Extract, Step::Track};
+    const size_t stage_count = static_cast<size_t>(std::clamp(cfg.stage_count, 2, 4));
+    stage_steps_.resize(stage_count);
+    stage_steps_[0] = {Step::Decode};
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const size_t stage = std::min(i + 1, stage_count - 1);
+        stage_steps_[stage].push_back(steps[i]);
+    }
+
+    queues_.reserve(stage_count);
+    queues_.push_back(std::make_unique<TaskQueue>(static_cast<size_t>(std::max(1, cfg.decode_queue_depth))));
+    for (size_t k = 1; k < stage_count; ++k) {
+        queues_.push_back(std::make_unique<TaskQueue>(static_cast<size_t>(std::max(1, cfg.queue_depth))));
+    }
+
+    if (!image_iter_) {
+        for (auto &q : queues_) q->close();
+        return;
+    }
+
+    workers_.reserve(stage_count);
+    workers_.emplace_back(&PipelinedDataIterator::decodeLoop, this);
+    for (size_t k = 1; k < stage_count; ++k) {
+        workers_.emplace_back(&PipelinedDataIterator::stageLoop, this, k);
+    }
+}
+
+PipelinedDataIterator::~PipelinedDataIterator() {
+    shutdown();
+}
+
+void PipelinedDataIterator::shutdown() {
+    // 关闭全部队列：阻塞在 push/pop 上的阶段线程都会被唤醒并退出
+    for (auto &q : queues_) q->close();
+    for (auto &t : workers_) {
+        if (t.joinable()) t.join();
+    }
+    workers_.clear();
+}
+
+void PipelinedDataIterator::fail(std::exception_ptr err) {
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) error_ = err;
+    }
+    for (auto &q : queues_) q->close();
+}
+
+void PipelinedDataIterator::decodeLoop() {
+    try {
+        int frame_index = 0;
+        while (image_iter_->hasNext()) {
+            auto task = std::make_unique<FrameTask>();
+            if (!image_iter_->next(task->frame)) break;
+            task->frame_index = frame_index++;
+            if (!queues_[0]->push(std::move(task))) return;
+        }
+    } catch (...) {
+        fail(std::current_exception());
+        return;
+    }
+    queues_[0]->close();
+}
+
+void PipelinedDataIterator::stageLoop(size_t stage) {
+    TaskQueue &in = *queues_[stage - 1];
+    TaskQueue &out = *queues_[stage];
+    try {
+        TaskPtr task;
+        while (in.pop(task)) {
+            for (Step step : stage_steps_[stage]) {
+                runStep(step, *task);
+            }
+            if (!out.push(std::move(task))) return;
+        }
+    } catch (...) {
+        fail(std::current_exception());
+        return;
+    }
+    out.close();
+}
+
+void PipelinedDataIterator::runStep(Step step, FrameTask &task) {
+    switch (step) {
+    case Step::Detect: processor_->detect(task); break;
+    case Step::Extract: processor_->extract(task); break;
+    case Step::Track: processor_->track(task); break;
+    case Step::Decode: break;  // 解码由 decodeLoop 单独负责
+    }
+}
+
+bool PipelinedDataIterator::fetch() const {
+    if (pending_) return true;
+    if (drained_) return false;
+    if (!queues_.back()->pop(pending_)) {
+        drained_ = true;
+        return false;
+    }
+    return true;
+}
+
+bool PipelinedDataIterator::hasNext() const {
+    if (fetch()) return true;
+    // 出错时仍返回 true，让下一次 next() 把异常抛给调用方
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    return error_ != nullptr;
+}
+
+bool PipelinedDataIterator::next(LabeledFrame &outFrame) {
+    if (!fetch()) {
+        std::exception_ptr err;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            err = error_;
+            error_ = nullptr;
+        }
+        if (err) std::rethrow_exception(err);
+        return false;
+    }
+
+    current_ = std::move(pending_);
+    outFrame = std::move(current_->label);
+    return true;
+}
+
+const cv::Mat &PipelinedDataIterator::getFrame() const {
+    static const cv::Mat kEmpty;
+    return current_ ? current_->frame : kEmpty;
+}
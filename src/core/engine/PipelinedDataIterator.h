@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ILabeledDataIterator.h"
+#include "FrameProcessor.h"
+#include "TrackingEngine.h"
+#include "../capture/IImageIterator.h"
+#include "core/concurrency/BoundedQueue.h"
+
+// 流水线模式的标注迭代器：
+// 解码 / 检测 / ReID / 跟踪 四个步骤按 PipelineConfig::stage_count 合并成若干阶段，
+// 每个阶段一个线程，阶段之间用有界队列衔接。每个阶段单线程且队列先进先出，
+// 因此输出帧序与串行模式完全一致，跟踪结果也相同。
+class PipelinedDataIterator : public ILabeledDataIterator {
+public:
+    PipelinedDataIterator(std::unique_ptr<IImageIterator> iter,
+                          std::unique_ptr<FrameProcessor> processor,
+                          const PipelineConfig &cfg);
+    ~PipelinedDataIterator() override;
+
+    bool hasNext() const override;
+    bool next(LabeledFrame &outFrame) override;
+    const cv::Mat &getFrame() const override;
+
+private:
+    using TaskPtr = std::unique_ptr<FrameTask>;
+    using TaskQueue = BoundedQueue<TaskPtr>;
+
+    // 每一帧要依次经过的步骤
+    enum class Step { Decode, Detect, Extract, Track };
+
+    void decodeLoop();
+    void stageLoop(size_t stage);
+    void runStep(Step step, FrameTask &task);
+    void fail(std::exception_ptr err);
+    void shutdown();
+    // 从输出队列取下一帧（hasNext 会预取一帧缓存起来）
+    bool fetch() const;
+
+    std::unique_ptr<IImageIterator> image_iter_;
+    std::unique_ptr<FrameProcessor> processor_;
+
+    // stage_steps_[k] 为第 k 个阶段负责的步骤；queues_[k] 为第 k 个阶段的输出队列
+    std::vector<std::vector<Step>> stage_steps_;
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    mutable TaskPtr pending_;   // hasNext 预取的帧
+    mutable bool drained_ = false;
+    TaskPtr current_;           // 最近一次 next 输出的帧（getFrame 返回其原图）
+};
@@ -0,0 +1,61 @@
+#include "RoiLayout.h"
+
+#include <opencv2/imgproc.hpp>
+
+void MergeOverlappingRects(std::vector<cv::Rect> &rects) {
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                if ((rects[i] & rects[j]).area() <= 0) continue;
+                rects[i] |= rects[j];
+                rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(j));
+                merged = true;
+                break;
+            }
+        }
+    }
+}
+
+RoiLayout::RoiLayout(const RoiConfig &cfg, const cv::Size &frame_size)
+    : frame_size_(frame_size),
+      zones_(RoiToPixelZones(cfg, frame_size)),
+      bounds_(0, 0, frame_size.width, frame_size.height) {
+    if (zones_.empty()) return;
+
+    masks_.resize(zones_.size());
+    bounds_ = zones_.front().bounds;
+    for (size_t i = 0; i < zones_.size(); ++i) {
+        const PixelRoi &zone = zones_[i];
+        bounds_ |= zone.bounds;
+        crops_.push_back(zone.bounds);
+        if (zone.polygon.empty()) continue;
+
+        // 掩膜只覆盖外接矩形，顶点平移到外接矩形的局部坐标后栅格化
+        cv::Mat &mask = masks_[i];
+        mask = cv::Mat::zeros(zone.bounds.size(), CV_8U);
+        std::vector<cv::Point> local;
+        local.reserve(zone.polygon.size());
+        for (const auto &p : zone.polygon) local.push_back(p - zone.bounds.tl());
+        const std::vector<std::vector<cv::Point>> contours = {local};
+        cv::fillPoly(mask, contours, cv::Scalar(255));
+    }
+    MergeOverlappingRects(crops_);
+}
+
+bool RoiLayout::contains(const cv::Point2f &pt) const {
+    if (zones_.empty()) return true;
+    for (size_t i = 0; i < zones_.size(); ++i) {
+        const cv::Rect &b = zones_[i].bounds;
+        if (pt.x < static_cast<float>(b.x) || pt.y < static_cast<float>(b.y) ||
+            pt.x >= static_cast<float>(b.x + b.width) || pt.y >= static_cast<float>(b.y + b.height)) {
+            continue;
+        }
+        if (masks_[i].empty()) return true;
+        const int mx = static_cast<int>(pt.x) - b.x;
+        const int my = static_cast<int>(pt.y) - b.y;
+        if (masks_[i].at<unsigned char>(my, mx) != 0) return true;
+    }
+    return false;
+}
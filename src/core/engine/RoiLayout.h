@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "config/RoiConfig.h"
+
+// 某一帧尺寸下的 ROI 几何（构造时预计算，之后只读，可在流水线各阶段之间共享）：
+// - crops：检测用的裁剪区域，即各区域外接矩形合并重叠后的结果（互不重叠），计算量随覆盖面积增长
+// - 输出过滤：矩形区域直接比较坐标，多边形区域查外接矩形内预先栅格化的掩膜
+class RoiLayout {
+public:
+    RoiLayout(const RoiConfig &cfg, const cv::Size &frame_size);
+
+    // 启用且至少有一个有效区域
+    bool active() const { return !zones_.empty(); }
+    const cv::Size &frameSize() const { return frame_size_; }
+    const std::vector<PixelRoi> &zones() const { return zones_; }
+    const std::vector<cv::Rect> &crops() const { return crops_; }
+    // 所有区域的外接矩形（未启用时为整帧）
+    const cv::Rect &bounds() const { return bounds_; }
+
+    // 像素点是否落在任一区域内（未启用时恒为 true）
+    bool contains(const cv::Point2f &pt) const;
+
+private:
+    cv::Size frame_size_;
+    std::vector<PixelRoi> zones_;
+    std::vector<cv::Mat> masks_;  // 与 zones_ 一一对应：多边形区域外接矩形内的掩膜，矩形区域为空
+    std::vector<cv::Rect> crops_;
+    cv::Rect bounds_;
+};
+
+// 把相互重叠的矩形合并为外接矩形，直到没有重叠（合并后的矩形可能与更多矩形重叠，需重新扫描）
+void MergeOverlappingRects(std::vector<cv::Rect> &rects);
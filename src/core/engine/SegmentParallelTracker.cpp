@@ -0,0 +1,117 @@
+#include "SegmentParallelTracker.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "core/recorder/StatsRecorder.h"
+
+SegmentParallelTracker::SegmentParallelTracker(const TrackingEngineConfig &cfg, const CaptureConfig &capture)
+    : cfg_(cfg), capture_(capture) {}
+
+std::vector<SampleRange> SegmentParallelTracker::planSegments(int total_frames, const OfflineConfig &cfg,
+                                                              int hardware_threads) {
+    if (total_frames <= 0) return {SampleRange{}};
+    int n = cfg.segments > 0 ? cfg.segments : std::max(1, hardware_threads);
+    n = std::min(n, std::max(1, total_frames / std::max(1, cfg.min_segment_frames)));
+
+    std::vector<SampleRange> ranges;
+    ranges.reserve(static_cast<size_t>(n));
+    for (int k = 0; k < n; ++k) {
+        const int begin = static_cast<int>(static_cast<long long>(total_frames) * k / n);
+        const int end = static_cast<int>(static_cast<long long>(total_frames) * (k + 1) / n);
+        ranges.push_back({begin, end});
+    }
+    return ranges;
+}
+
+std::vector<LabeledFrame> SegmentParallelTracker::run(const std::string &video_path, double sample_fps) const {
+    int total = -1;
+    {
+        CaptureConfig probe = capture_;
+        probe.prefetch_depth = 0;
+        probe.seek_sampling = false;
+        total = VideoFileIterator(video_path, sample_fps, probe).info().total_frames;
+    }
+    const int hw = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    const std::vector<SampleRange> owned = planSegments(total, cfg_.offline, hw);
+    const size_t n = owned.size();
+
+    // 重叠窗口不能超过最短的一段，否则热身会越过前一段的起点
+    int overlap = std::max(0, cfg_.offline.overlap_frames);
+    for (const auto &r : owned) {
+        if (r.end > r.begin) overlap = std::min(overlap, r.end - r.begin);
+    }
+
+    // 各段引擎独立：拼接需要轨迹特征；段内不再开流水线或前瞻检测，推理线程按段数均分，避免超额订阅
+    TrackingEngineConfig seg_cfg = cfg_;
+    seg_cfg.tracker_mgr.export_features = true;
+    seg_cfg.pipeline.enabled = false;
+    seg_cfg.lookahead.enabled = false;
+    const int threads_per_segment = std::max(1, hw / static_cast<int>(n));
+    if (seg_cfg.detector.ort_env_config.intra_op_threads <= 0) {
+        seg_cfg.detector.ort_env_config.intra_op_threads = threads_per_segment;
+    }
+    if (seg_cfg.extractor.ort_env_config.intra_op_threads <= 0) {
+        seg_cfg.extractor.ort_env_config.intra_op_threads = threads_per_segment;
+    }
+
+    std::vector<SegmentResult> results(n);
+    std::vector<std::exception_ptr> errors(n);
+    std::vector<std::thread> workers;
+    workers.reserve(n);
+    for (size_t k = 0; k < n; ++k) {
+        workers.emplace_back([&, k] {
+            try {
+                results[k] = runSegment(video_path, sample_fps, owned[k], k > 0 ? overlap : 0, k + 1 < n ? overlap : 0,
+                                        seg_cfg);
+            } catch (...) {
+                errors[k] = std::current_exception();
+            }
+        });
+    }
+    for (auto &w : workers) w.join();
+    for (const auto &err : errors) {
+        if (err) std::rethrow_exception(err);
+    }
+    return StitchSegments(results, cfg_.offline);
+}
+
+SegmentResult SegmentParallelTracker::runSegment(const std::string &video_path, double sample_fps,
+                                                 const SampleRange &owned, int head_overlap, int tail_overlap,
+                                                 const TrackingEngineConfig &cfg) const {
+    const SampleRange read{owned.begin - head_overlap, owned.end};
+    // 特征只在两端的重叠窗口内导出（引擎内帧号从 read.begin 起算），段中间的帧不拷贝特征
+    TrackingEngineConfig engine_cfg = cfg;
+    engine_cfg.tracker_mgr.export_feature_windows = {{0, head_overlap},
+                                                     {owned.end - tail_overlap - read.begin, owned.end - read.begin}};
+    TrackingEngine engine(engine_cfg);
+    auto iter = engine.run(std::make_unique<VideoFileIterator>(video_path, sample_fps, capture_, read));
+
+    SegmentResult result;
+    result.begin = owned.begin;
+    WindowCollector head(read.begin, owned.begin);
+    WindowCollector tail(owned.end - tail_overlap, owned.end);
+
+    LabeledFrame label;
+    while (iter->hasNext() && iter->next(label)) {
+        label.frame_index += read.begin;
+        head.add(label);
+        tail.add(label);
+        if (label.frame_index < owned.begin) continue;
+        // 尾部窗口内的帧带有特征，只用于窗口拼接，不随整段结果保留
+        for (auto &obj : label.objs) std::vector<float>().swap(obj.feature);
+        result.frames.push_back(std::move(label));
+    }
+    result.head = head.tracks();
+    result.tail = tail.tracks();
+    return result;
+}
+
+void SegmentParallelTracker::exportCsv(const std::vector<LabeledFrame> &frames, const RecorderConfig &cfg) {
+    StatsRecorder recorder(cfg);
+    for (const auto &frame : frames) recorder.consume(frame);
+    recorder.finalize();
+}
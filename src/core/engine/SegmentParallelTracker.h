@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "TrackStitcher.h"
+#include "TrackingEngine.h"
+#include "core/capture/CaptureConfig.h"
+#include "core/capture/VideoFrameSource.h"
+#include "core/recorder/RecorderConfig.h"
+#include "structure/LabeledData.h"
+
+// 离线分段并行跟踪（见 OfflineConfig）：每段一个独立的 TrackingEngine（各自的模型会话与轨迹状态）并行运行，
+// 段首从前一段末尾的重叠窗口开始热身，结束后在窗口内拼接轨迹 ID。
+// 输出与串行处理同一视频的帧序、帧号一致，轨迹 ID 全局唯一；段边界处的 ID 连续性取决于拼接是否成功。
+class SegmentParallelTracker {
+public:
+    explicit SegmentParallelTracker(const TrackingEngineConfig &cfg, const CaptureConfig &capture = {});
+
+    // 处理整个视频文件，返回全部采样帧的标注
+    std::vector<LabeledFrame> run(const std::string &video_path, double sample_fps = 0.0) const;
+
+    // 按 StatsRecorder 的 CSV 格式写出
+    static void exportCsv(const std::vector<LabeledFrame> &frames, const RecorderConfig &cfg);
+
+    // 把 total_frames 个采样帧切成各段负责输出的区间 [begin, end)
+    static std::vector<SampleRange> planSegments(int total_frames, const OfflineConfig &cfg, int hardware_threads);
+
+private:
+    // 读取 [owned.begin - head_overlap, owned.end)；末尾 tail_overlap 帧作为与后一段拼接的窗口
+    SegmentResult runSegment(const std::string &video_path, double sample_fps, const SampleRange &owned,
+                             int head_overlap, int tail_overlap, const TrackingEngineConfig &cfg) const;
+
+    TrackingEngineConfig cfg_;
+    CaptureConfig capture_;
+};
@@ -0,0 +1,128 @@
+#include "TrackStitcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+float cosine(const std::vector<float> &a, const std::vector<float> &b) {
+    double dot = 0.0;
+    double na = 0.0;
+    double nb = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        dot += static_cast<double>(a[i]) * b[i];
+        na += static_cast<double>(a[i]) * a[i];
+        nb += static_cast<double>(b[i]) * b[i];
+    }
+    if (na <= 0.0 || nb <= 0.0) return 0.0F;
+    return static_cast<float>(dot / std::sqrt(na * nb));
+}
+
+float rectIou(const cv::Rect &a, const cv::Rect &b) {
+    const float inter = static_cast<float>((a & b).area());
+    const float uni = static_cast<float>(a.area() + b.area()) - inter;
+    return uni > 0.0F ? inter / uni : 0.0F;
+}
+
+// 把一段的局部 ID 改写为全局 ID；未出现在 mapping 中的局部 ID 分配新的全局 ID
+void relabel(std::vector<LabeledFrame> &frames, std::unordered_map<int, int> &mapping, int &next_global) {
+    for (auto &frame : frames) {
+        for (auto &obj : frame.objs) {
+            auto it = mapping.find(obj.id);
+            if (it == mapping.end()) it = mapping.emplace(obj.id, next_global++).first;
+            obj.id = it->second;
+        }
+    }
+}
+}  // namespace
+
+void WindowCollector::add(const LabeledFrame &frame) {
+    if (frame.frame_index < begin_ || frame.frame_index >= end_) return;
+    for (const auto &obj : frame.objs) {
+        WindowTrack &track = tracks_[obj.id];
+        track.id = obj.id;
+        track.boxes[frame.frame_index] = obj.bbox;
+        if (obj.feature.empty()) continue;
+        if (track.feature.empty()) track.feature.assign(obj.feature.size(), 0.0F);
+        if (track.feature.size() != obj.feature.size()) continue;
+        for (size_t i = 0; i < obj.feature.size(); ++i) track.feature[i] += obj.feature[i];
+    }
+}
+
+std::vector<WindowTrack> WindowCollector::tracks() const {
+    std::vector<WindowTrack> out;
+    out.reserve(tracks_.size());
+    for (const auto &[id, track] : tracks_) out.push_back(track);
+    return out;
+}
+
+std::vector<std::pair<int, int>> MatchWindowTracks(const std::vector<WindowTrack> &prev,
+                                                   const std::vector<WindowTrack> &curr,
+                                                   const OfflineConfig &cfg) {
+    struct Candidate {
+        float ratio;
+        size_t p;
+        size_t c;
+    };
+    std::vector<Candidate> candidates;
+    for (size_t p = 0; p < prev.size(); ++p) {
+        for (size_t c = 0; c < curr.size(); ++c) {
+            const auto &a = prev[p];
+            const auto &b = curr[c];
+            int co = 0;
+            for (const auto &[frame, box] : a.boxes) {
+                const auto it = b.boxes.find(frame);
+                if (it != b.boxes.end() && rectIou(box, it->second) >= cfg.stitch_iou) ++co;
+            }
+            const size_t denom = std::min(a.boxes.size(), b.boxes.size());
+            if (co == 0 || denom == 0) continue;
+            const float ratio = static_cast<float>(co) / static_cast<float>(denom);
+            if (ratio < cfg.stitch_min_ratio) continue;
+            // 外观否决：两框重合但外观明显不同（例如交错而过的两个人）时不拼接
+            if (!a.feature.empty() && a.feature.size() == b.feature.size() &&
+                cosine(a.feature, b.feature) < cfg.stitch_reid_threshold) {
+                continue;
+            }
+            candidates.push_back({ratio, p, c});
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Candidate &x, const Candidate &y) { return x.ratio > y.ratio; });
+    std::vector<char> prev_used(prev.size(), 0);
+    std::vector<char> curr_used(curr.size(), 0);
+    std::vector<std::pair<int, int>> matches;
+    for (const auto &cand : candidates) {
+        if (prev_used[cand.p] || curr_used[cand.c]) continue;
+        prev_used[cand.p] = curr_used[cand.c] = 1;
+        matches.emplace_back(prev[cand.p].id, curr[cand.c].id);
+    }
+    return matches;
+}
+
+std::vector<LabeledFrame> StitchSegments(std::vector<SegmentResult> &segments, const OfflineConfig &cfg) {
+    std::vector<LabeledFrame> out;
+    size_t total = 0;
+    for (const auto &seg : segments) total += seg.frames.size();
+    out.reserve(total);
+
+    int next_global = 0;
+    std::unordered_map<int, int> prev_mapping;
+    for (size_t k = 0; k < segments.size(); ++k) {
+        SegmentResult &seg = segments[k];
+        std::unordered_map<int, int> mapping;
+        if (k > 0) {
+            for (const auto &[prev_id, curr_id] : MatchWindowTracks(segments[k - 1].tail, seg.head, cfg)) {
+                const auto it = prev_mapping.find(prev_id);
+                if (it != prev_mapping.end()) mapping.emplace(curr_id, it->second);
+            }
+        }
+        relabel(seg.frames, mapping, next_global);
+        for (auto &frame : seg.frames) out.push_back(std::move(frame));
+        seg.frames.clear();
+        prev_mapping = std::move(mapping);
+    }
+    std::stable_sort(out.begin(), out.end(),
+                     [](const LabeledFrame &a, const LabeledFrame &b) { return a.frame_index < b.frame_index; });
+    return out;
+}
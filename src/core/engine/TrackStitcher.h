@@ -0,0 +1,49 @@
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "TrackingEngine.h"
+#include "structure/LabeledData.h"
+
+// 重叠窗口内一条轨迹的观测
+struct WindowTrack {
+    int id = -1;
+    std::map<int, cv::Rect> boxes;   // 全局帧号 -> 框
+    std::vector<float> feature;      // 窗口内各帧特征之和（方向即平均特征方向）；为空表示没有特征
+};
+
+// 收集一个分段在窗口 [begin, end)（全局帧号）内输出的轨迹
+class WindowCollector {
+public:
+    WindowCollector(int begin, int end) : begin_(begin), end_(end) {}
+
+    // frame.frame_index 为全局帧号；窗口外的帧被忽略
+    void add(const LabeledFrame &frame);
+    std::vector<WindowTrack> tracks() const;
+
+private:
+    int begin_ = 0;
+    int end_ = 0;
+    std::map<int, WindowTrack> tracks_;
+};
+
+// 一个分段的跟踪结果（轨迹 ID 为该段引擎内的局部 ID）
+struct SegmentResult {
+    int begin = 0;                      // 本段负责输出的第一个全局帧号
+    std::vector<LabeledFrame> frames;   // 本段输出的帧（全局帧号，不含热身窗口）
+    std::vector<WindowTrack> head;      // 与前一段重叠的热身窗口内的轨迹
+    std::vector<WindowTrack> tail;      // 本段末尾、与后一段重叠窗口内的轨迹
+};
+
+// 匹配相邻两段在同一重叠窗口内的轨迹，返回 (前一段 ID, 后一段 ID)：
+// 同帧框 IoU 达到 stitch_iou 记一次共现，共现比例达标且（双方都有特征时）外观相似度达标才可匹配，
+// 按共现比例从高到低一对一贪心
+std::vector<std::pair<int, int>> MatchWindowTracks(const std::vector<WindowTrack> &prev,
+                                                   const std::vector<WindowTrack> &curr,
+                                                   const OfflineConfig &cfg);
+
+// 按顺序拼接各段：局部 ID 映射为全局唯一 ID（按首次出现从 0 递增，拼接上的沿用前一段的全局 ID），
+// 输出所有段的帧（按帧序）
+std::vector<LabeledFrame> StitchSegments(std::vector<SegmentResult> &segments, const OfflineConfig &cfg);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "model/detector/IDetector.h"
 #include "model/feature_extractor/IFeatureExtractor.h"
@@ -10,11 +11,62 @@
 #include "../capture/IImageIterator.h"
 #include "config/RoiConfig.h"
 
+// 流水线配置：把 解码 / 检测 / ReID / 跟踪 拆到不同线程，相邻阶段之间用有界队列衔接
+// 例如第 N 帧在做 ReID 与跟踪时，第 N+1 帧已经在解码和检测；输出顺序与串行模式一致。
+struct PipelineConfig {
+    bool enabled = false;         // 关闭时逐帧串行执行（默认行为）
+    int stage_count = 4;          // 线程化的阶段数（2~4）：2=解码|其余，3=解码|检测|ReID+跟踪，4=四段全拆
+    int decode_queue_depth = 2;   // 解码阶段输出队列容量（原始帧较大，单独控制）
+    int queue_depth = 2;          // 其余阶段之间（含最终输出）的队列容量
+};
+
+// 前瞻数据并行检测（离线吞吐）：检测器会话池中的 workers 个检测器同时检测第 N..N+depth 帧，
+// ReID 与跟踪仍严格按帧序逐帧进行，结果与串行模式一致。与流水线不同，目标是让检测本身占满所有核心。
+// 需要检测与轨迹状态无关：开启自适应关键帧或局部检测时该配置不生效；同时开启时优先于流水线模式
+struct LookaheadConfig {
+    bool enabled = false;
+    int workers = 4;   // 并行检测的会话数（每个会话独立加载模型，推理线程按会话数均分 CPU 核心）
+    int depth = 8;     // 检测最多领先跟踪的帧数（同时在内存中的帧数上限）
+};
+
+// 关键帧检测：只在部分帧上运行检测器与 ReID，其余帧输出卡尔曼预测（不做未命中扣血）
+struct KeyframeConfig {
+    int interval = 1;        // 每 interval 帧检测一次；1 表示每帧检测（默认行为）
+    bool adaptive = false;   // 自适应：场景稳定时逐步拉长间隔（最多 max_interval），出现新目标/轨迹增减时回到 interval
+    int max_interval = 8;    // 自适应模式下的最大检测间隔
+};
+
+// 轨迹引导的局部检测：两次整帧检测之间，只在各轨迹（含待确认检测）的框周围外扩、合并后的区域上
+// 合批检测，结果按区域偏移映射回原帧；整帧检测定期运行，用于发现新目标
+struct LocalDetectionConfig {
+    bool enabled = false;           // 关闭时每次检测都是整帧（默认行为）
+    int full_frame_interval = 10;   // 每隔多少帧至少做一次整帧检测
+    float padding = 0.5F;           // 区域在框四周外扩的比例（相对框的宽/高）
+    int min_region_size = 64;       // 区域的最小边长（像素）
+    float max_area_ratio = 0.5F;    // 合并后区域总面积超过检测范围的该比例时，直接整帧检测
+};
+
+// 离线分段并行：把视频按采样帧切成 segments 段，每段一个独立引擎并行跟踪；相邻段重叠 overlap_frames 帧，
+// 后一段在重叠窗口内热身，并在窗口内按同帧框重叠与 ReID 相似度把两段的轨迹 ID 拼接起来
+struct OfflineConfig {
+    int segments = 0;                 // 分段数；<=0 时取 CPU 核心数
+    int overlap_frames = 30;          // 相邻分段重叠的采样帧数
+    int min_segment_frames = 300;     // 每段至少的采样帧数（视频较短时自动减少分段数）
+    float stitch_iou = 0.5F;          // 同一帧两框 IoU 达到该值记为一次共现
+    float stitch_min_ratio = 0.5F;    // 共现帧数 / 两轨迹在窗口内出现帧数的较小者，低于该值不拼接
+    float stitch_reid_threshold = 0.5F; // 两轨迹窗口内平均特征的余弦相似度下限（任一侧无特征时不检查）
+};
+
 struct TrackingEngineConfig {
     DetectorConfig detector;
     FeatureExtractorConfig extractor;
     TrackerManagerConfig tracker_mgr;
     RoiConfig roi;
+    PipelineConfig pipeline;
+    KeyframeConfig keyframe;
+    LocalDetectionConfig local_detection;
+    OfflineConfig offline;
+    LookaheadConfig lookahead;
 };
 
 class TrackingEngine {
@@ -25,7 +77,12 @@ public:
     std::unique_ptr<ILabeledDataIterator> run(std::unique_ptr<IImageIterator> imageIter);
 
 private:
+    // 前瞻并行检测开启且检测与轨迹状态无关
+    bool lookaheadActive() const;
+
     std::unique_ptr<IDetector> detector_;
+    // 前瞻并行检测的额外检测器（与 detector_ 一起组成 workers 个会话）
+    std::vector<std::unique_ptr<IDetector>> detector_pool_;
     std::unique_ptr<IFeatureExtractor> extractor_;
     std::unique_ptr<TrackerManager> tracker_mgr_;
     TrackingEngineConfig cfg_;
@@ -39,8 +39,9 @@ std::unique_ptr<Ort::Session> CreateSession(const OrtEnvConfig& config){
         // 设置优化级别
         session_opts.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
         
-        // 设置执行线程数（根据CPU核心数）
-        unsigned int num_threads = std::thread::hardware_concurrency();
+        // 设置执行线程数（默认根据CPU核心数）
+        unsigned int num_threads = config.intra_op_threads > 0 ? static_cast<unsigned int>(config.intra_op_threads)
+                                                               : std::thread::hardware_concurrency();
         if (num_threads > 0) {
             session_opts.SetIntraOpNumThreads(num_threads);
             session_opts.SetInterOpNumThreads(num_threads);
@@ -9,6 +9,8 @@ struct OrtEnvConfig {
     // 此处仅保留配置标志，仅当设置使用gpu时才会生效
     int device_id = 0;
     size_t gpu_mem_limit = 2ULL * 1024 * 1024 * 1024;  // 2GB
+    // CPU 推理线程数；0 表示使用全部核心（多个会话并行时应按会话数均分，避免线程超额订阅）
+    int intra_op_threads = 0;
 };
 
 
@@ -0,0 +1,192 @@
+#include "OrtIoBinding.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+size_t ElementCount(const std::vector<int64_t> &shape) {
+    size_t count = 1;
+    for (int64_t d : shape) {
+        if (d <= 0) return 0;
+        count *= static_cast<size_t>(d);
+    }
+    return count;
+}
+}  // namespace
+
+OrtIoBindingCache::OrtIoBindingCache(Ort::Session &session)
+    : session_(session),
+      memory_info_(Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU)) {
+    Ort::AllocatorWithDefaultOptions allocator;
+    input_name_ = session_.GetInputNameAllocated(0, allocator).get();
+    model_input_shape_ = session_.GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+
+    const size_t output_count = session_.GetOutputCount();
+    output_names_.reserve(output_count);
+    model_output_shapes_.reserve(output_count);
+    for (size_t i = 0; i < output_count; ++i) {
+        output_names_.emplace_back(session_.GetOutputNameAllocated(i, allocator).get());
+        model_output_shapes_.push_back(session_.GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
+    }
+    output_buffers_.resize(output_count);
+}
+
+bool OrtIoBindingCache::resolveOutputShape(const std::vector<int64_t> &input_shape, size_t index,
+                                           std::vector<int64_t> &out) const {
+    out = model_output_shapes_[index];
+    for (size_t d = 0; d < out.size(); ++d) {
+        if (out[d] > 0) continue;
+        // 约定第 0 维为 batch，与输入 batch 一致；其他动态维度无法预知
+        if (d == 0 && !input_shape.empty()) {
+            out[d] = input_shape[0];
+        } else {
+            return false;
+        }
+    }
+    return !out.empty();
+}
+
+void OrtIoBindingCache::buildEntry(Entry &entry) {
+    const size_t input_count = ElementCount(entry.input_shape);
+    entry.input = Ort::Value::CreateTensor<float>(
+        memory_info_, input_buffer_.data(), input_count,
+        entry.input_shape.data(), entry.input_shape.size());
+    entry.binding = Ort::IoBinding(session_);
+    entry.binding.BindInput(input_name_.c_str(), entry.input);
+    ++allocation_count_;
+
+    entry.outputs.clear();
+    entry.outputs.reserve(output_names_.size());
+    for (size_t i = 0; i < output_names_.size(); ++i) {
+        if (entry.output_preallocated[i]) {
+            const auto &shape = entry.output_shapes[i];
+            entry.outputs.push_back(Ort::Value::CreateTensor<float>(
+                memory_info_, output_buffers_[i].data(), ElementCount(shape),
+                shape.data(), shape.size()));
+            entry.binding.BindOutput(output_names_[i].c_str(), entry.outputs.back());
+        } else {
+            entry.outputs.emplace_back(nullptr);
+            entry.binding.BindOutput(output_names_[i].c_str(), memory_info_);
+        }
+        ++allocation_count_;
+    }
+}
+
+OrtIoBindingCache::Entry &OrtIoBindingCache::entryFor(const std::vector<int64_t> &shape) {
+    for (auto &e : entries_) {
+        if (e.input_shape == shape) return e;
+    }
+
+    if (ElementCount(shape) == 0) {
+        throw std::invalid_argument("OrtIoBindingCache: 输入 shape 含非法维度");
+    }
+
+    Entry entry;
+    entry.input_shape = shape;
+    entry.output_shapes.resize(output_names_.size());
+    entry.output_preallocated.resize(output_names_.size());
+    for (size_t i = 0; i < output_names_.size(); ++i) {
+        entry.output_preallocated[i] = resolveOutputShape(shape, i, entry.output_shapes[i]);
+    }
+
+    // 缓冲需要扩容时，已有张量包装的指针全部失效，需重建所有绑定
+    bool grown = false;
+    if (input_buffer_.size() < ElementCount(shape)) {
+        input_buffer_.resize(ElementCount(shape));
+        ++allocation_count_;
+        grown = true;
+    }
+    for (size_t i = 0; i < output_names_.size(); ++i) {
+        if (!entry.output_preallocated[i]) continue;
+        const size_t need = ElementCount(entry.output_shapes[i]);
+        if (output_buffers_[i].size() < need) {
+            output_buffers_[i].resize(need);
+            ++allocation_count_;
+            grown = true;
+        }
+    }
+    if (grown) {
+        for (auto &e : entries_) buildEntry(e);
+    }
+
+    buildEntry(entry);
+    entries_.push_back(std::move(entry));
+    return entries_.back();
+}
+
+float *OrtIoBindingCache::prepareInput(const std::vector<int64_t> &shape) {
+    if (!current_ || current_->input_shape != shape) {
+        current_ = &entryFor(shape);
+    }
+    return input_buffer_.data();
+}
+
+void OrtIoBindingCache::run() {
+    if (!current_) {
+        throw std::runtime_error("OrtIoBindingCache: run 之前需要先 prepareInput");
+    }
+    session_.Run(run_options_, current_->binding);
+
+    // 存在 ORT 分配的输出时，需要取回本次的输出张量及其实际 shape
+    bool has_dynamic = false;
+    for (bool pre : current_->output_preallocated) has_dynamic = has_dynamic || !pre;
+    if (has_dynamic) {
+        current_->ort_outputs = current_->binding.GetOutputValues();
+        for (size_t i = 0; i < current_->ort_outputs.size() && i < output_names_.size(); ++i) {
+            if (!current_->output_preallocated[i]) {
+                current_->output_shapes[i] = current_->ort_outputs[i].GetTensorTypeAndShapeInfo().GetShape();
+            }
+        }
+        ++allocation_count_;
+        if (learn_output_shapes_) adoptOutputShapes(*current_);
+    }
+}
+
+void OrtIoBindingCache::adoptOutputShapes(Entry &entry) {
+    for (size_t i = 0; i < output_names_.size(); ++i) {
+        if (!entry.output_preallocated[i] && ElementCount(entry.output_shapes[i]) == 0) return;
+    }
+
+    bool grown = false;
+    for (size_t i = 0; i < output_names_.size(); ++i) {
+        if (entry.output_preallocated[i]) continue;
+        const size_t need = ElementCount(entry.output_shapes[i]);
+        if (output_buffers_[i].size() < need) {
+            output_buffers_[i].resize(need);
+            ++allocation_count_;
+            grown = true;
+        }
+        // 本次结果仍在 ORT 输出里，拷入持久缓冲后 outputData 照常可读
+        const float *src = entry.ort_outputs[i].GetTensorData<float>();
+        std::copy(src, src + need, output_buffers_[i].data());
+        entry.output_preallocated[i] = true;
+    }
+    entry.ort_outputs.clear();
+
+    // 缓冲扩容后已有张量包装的指针全部失效，需重建所有绑定
+    if (grown) {
+        for (auto &e : entries_) buildEntry(e);
+    } else {
+        buildEntry(entry);
+    }
+}
+
+const float *OrtIoBindingCache::outputData(size_t index) const {
+    if (!current_ || index >= output_names_.size()) {
+        throw std::out_of_range("OrtIoBindingCache: 输出索引越界");
+    }
+    if (current_->output_preallocated[index]) {
+        return output_buffers_[index].data();
+    }
+    if (index >= current_->ort_outputs.size()) {
+        throw std::runtime_error("OrtIoBindingCache: 输出尚未生成");
+    }
+    return current_->ort_outputs[index].GetTensorData<float>();
+}
+
+const std::vector<int64_t> &OrtIoBindingCache::outputShape(size_t index) const {
+    if (!current_ || index >= output_names_.size()) {
+        throw std::out_of_range("OrtIoBindingCache: 输出索引越界");
+    }
+    return current_->output_shapes[index];
+}
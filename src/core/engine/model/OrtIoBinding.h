@@ -0,0 +1,76 @@
+#pragma once
+
+#include <onnxruntime_cxx_api.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// 持久化的 ORT 输入/输出绑定缓存：
+// - 输入/输出缓冲由本类持有，按首次遇到的最大尺寸分配，之后复用
+// - 每种输入 shape 对应一份预先建好的 Ort::IoBinding（输入/输出张量都已绑定），
+//   稳态推理只做 Run，不再重建 MemoryInfo / 名字数组 / shape 数组 / 张量
+// - 输出 shape 中除 batch 以外仍有未知维度时，退化为由 ORT 分配输出（每次计入分配次数）；
+//   若输出 shape 只由输入 shape 决定（setLearnOutputShapes），首次推理后记下实际 shape 并改为预分配
+// allocationCount() 统计本类的缓冲分配、张量创建与绑定次数，用于验证预热之后绑定不再变化
+// （只覆盖推理缓冲与绑定，不含调用方自己的临时对象或输出容器）。
+class OrtIoBindingCache {
+public:
+    explicit OrtIoBindingCache(Ort::Session &session);
+
+    // 切换到指定输入 shape，返回可直接写入的输入缓冲（元素个数 = shape 各维乘积）
+    float *prepareInput(const std::vector<int64_t> &shape);
+    // 以最近一次 prepareInput 的 shape 执行推理
+    void run();
+    // 声明输出 shape 完全由输入 shape 决定（如 YOLO 检测头）：动态输出维度在每种输入 shape
+    // 首次推理后固定下来，之后该 shape 的推理与静态模型一样不再分配
+    void setLearnOutputShapes(bool enabled) { learn_output_shapes_ = enabled; }
+
+    size_t outputCount() const { return output_names_.size(); }
+    const float *outputData(size_t index) const;
+    const std::vector<int64_t> &outputShape(size_t index) const;
+
+    const std::string &inputName() const { return input_name_; }
+    const std::vector<int64_t> &modelInputShape() const { return model_input_shape_; }
+
+    // 累计的分配/绑定次数（预热完成后应保持不变）
+    size_t allocationCount() const { return allocation_count_; }
+
+private:
+    struct Entry {
+        std::vector<int64_t> input_shape;
+        std::vector<std::vector<int64_t>> output_shapes;
+        std::vector<bool> output_preallocated;   // false 表示由 ORT 分配
+        Ort::Value input{nullptr};
+        std::vector<Ort::Value> outputs;         // 预分配输出的张量包装
+        std::vector<Ort::Value> ort_outputs;     // ORT 分配的输出（每次 run 后更新）
+        Ort::IoBinding binding{nullptr};
+    };
+
+    Entry &entryFor(const std::vector<int64_t> &shape);
+    void buildEntry(Entry &entry);
+    // 把本次 ORT 分配的输出拷入持久缓冲，并把该 entry 的输出改为预分配绑定
+    void adoptOutputShapes(Entry &entry);
+    // 按输入 shape 推导输出 shape；返回 false 表示存在无法推导的动态维度
+    bool resolveOutputShape(const std::vector<int64_t> &input_shape, size_t index,
+                            std::vector<int64_t> &out) const;
+
+    Ort::Session &session_;
+    Ort::MemoryInfo memory_info_;
+    Ort::RunOptions run_options_{nullptr};
+
+    std::string input_name_;
+    std::vector<std::string> output_names_;
+    std::vector<int64_t> model_input_shape_;
+    std::vector<std::vector<int64_t>> model_output_shapes_;
+
+    std::vector<float> input_buffer_;
+    std::vector<std::vector<float>> output_buffers_;
+
+    std::deque<Entry> entries_;  // deque 追加时不搬移已有元素，current_ 保持有效
+    Entry *current_ = nullptr;
+    size_t allocation_count_ = 0;
+    bool learn_output_shapes_ = false;
+};
@@ -12,6 +12,17 @@ float BBox::operator&(const BBox &other) const {
     return intersection / union_area;
 }
 
+float BBox::operator&&(const BBox &other) const {
+    const float intersect_w = std::max(0.0F, std::min(box.br().x, other.box.br().x) - std::max(box.tl().x, other.box.tl().x));
+    const float intersect_h = std::max(0.0F, std::min(box.br().y, other.box.br().y) - std::max(box.tl().y, other.box.tl().y));
+    const float intersection = intersect_w * intersect_h;
+    if (intersection <= 0.0F) return 0.0F;
+
+    // IoM：交集 / 较小框面积，适合抑制"大框套小框"
+    const float min_area = std::min(box.area(), other.box.area()) + 1e-6F;
+    return intersection / min_area;
+}
+
 cv::Point2f BBox::center() const {
     return cv::Point2f(box.x + box.width * 0.5F, box.y + box.height * 0.5F);
 }
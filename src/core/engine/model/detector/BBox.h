@@ -9,7 +9,8 @@ public:
 
     // 计算 IoU，重载 & 运算符，便于 NMS 调用
     float operator&(const BBox &other) const;
-    
+
+    // 计算 IoM（交集 / 较小框面积），重载 && 运算符
     float operator&&(const BBox &other) const;
 
     // 获取中心点坐标
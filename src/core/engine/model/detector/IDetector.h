@@ -1,6 +1,8 @@
 #pragma once
 
 #include "BBox.h"
+#include "NmsEngine.h"
+#include "TileLayout.h"
 #include <opencv2/core.hpp>
 #include <vector>
 #include "../OrtEnvSingleton.h"
@@ -9,12 +11,30 @@
 struct DetectorConfig {
     int input_width = 640;       // 模型期望的输入宽度
     int input_height = 640;      // 模型期望的输入高度
+    // 矩形推理：模型输入 H/W 为动态维度时，不再固定填充到 input_width x input_height，
+    // 而是选能容纳源图宽高比的最小 input_stride 对齐尺寸（input_width/height 作为上限）
+    bool rect_inference = true;
+    int input_stride = 32;       // 矩形推理的尺寸对齐（YOLO 的最大下采样倍数）
     float score_threshold = 0.5F;   // objectness 与类别融合后的阈值
-    float nms_threshold = 0.8F;     // 同类别框的 IoM NMS 阈值
+    float nms_threshold = 0.8F;     // 同类别框的 NMS 重叠阈值（Greedy 模式）
+    NmsMethod nms_method = NmsMethod::Greedy;  // NMS 方式：Greedy / Matrix / Soft
+    bool nms_use_iom = false;       // 重叠度量：false 为 IoU，true 为 IoM
+    float nms_sigma = 0.5F;         // Matrix/Soft 的高斯衰减参数
+    float nms_min_score = 0.25F;    // Matrix/Soft 衰减后低于该分数的框被丢弃
     bool filter_edge_boxes = true; // 是否过滤触边框（某边位于或超过画面边界）
     // 检测器关注的类别 ID 列表；为空表示不过滤（接受所有类别）
-    // 说明：我们在推理热路径里会把它预处理成 unordered_set 来做 O(1) 判断，避免逐个遍历。
+    // 说明：解码时只扫描这些类别的分数，低于阈值的 anchor 不再做全类别 argmax。
     std::vector<int> focus_class_ids = {};
+    // anchor 数达到该值时解码按区间切分到多线程（每段至少 4096 个 anchor）：
+    // 默认下 640 输入的 8400 个 anchor 与 640x384 矩形输入的 5040 个 anchor 都走多线程；设为很大的值可关闭
+    int decode_parallel_min_anchors = 4096;
+    // detectRegions（多个子区域合批检测）：每个区域 letterbox 到 region_input_size 见方；
+    // 仅当模型输入 H/W 为动态维度时生效，固定尺寸的模型仍使用 input_width x input_height
+    int region_input_size = 320;
+    // detectRegions 单次推理的最大 batch；超出部分自动分块。若模型 batch 维是固定值，则以模型为准。
+    int region_max_batch = 8;
+    // 高分辨率画面的切片检测（切片按 input_width x input_height 合批推理）
+    TilingConfig tiling;
 
     OrtEnvConfig ort_env_config;
 };
@@ -26,4 +46,22 @@ public:
 
     // 对输入帧做检测并输出结构化结果
     virtual std::vector<BBox> detect(const cv::Mat &frame, int frame_index) = 0;
+
+    // 同上，结果写入调用方持有、帧间复用的 out（先清空，保留容量）。
+    // 默认实现转调返回值版本；支持原地输出的实现应覆盖它，预热后逐帧检测不再分配
+    virtual void detect(const cv::Mat &frame, int frame_index, std::vector<BBox> &out) {
+        out = detect(frame, frame_index);
+    }
+
+    // 对同一帧中的多个子区域检测，返回值与 regions 一一对应（坐标为各区域的局部坐标）。
+    // 默认实现逐个调用 detect；支持批推理的实现应覆盖它。
+    virtual std::vector<std::vector<BBox>> detectRegions(const cv::Mat &frame, const std::vector<cv::Rect> &regions,
+                                                         int frame_index) {
+        std::vector<std::vector<BBox>> boxes;
+        boxes.reserve(regions.size());
+        for (const auto &region : regions) {
+            boxes.push_back(detect(frame(region), frame_index));
+        }
+        return boxes;
+    }
 };
@@ -0,0 +1,201 @@
+#include "LetterboxKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "core/simd/Simd.h"
+
+LetterboxLayout ComputeLetterboxLayout(const cv::Size &src_size, int dst_w, int dst_h) {
+    LetterboxLayout layout;
+    layout.dst_w = dst_w;
+    layout.dst_h = dst_h;
+    layout.scale = std::min(
+        static_cast<float>(dst_w) / static_cast<float>(src_size.width),
+        static_cast<float>(dst_h) / static_cast<float>(src_size.height)
+    );
+    layout.resize_w = static_cast<int>(std::round(src_size.width * layout.scale));
+    layout.resize_h = static_cast<int>(std::round(src_size.height * layout.scale));
+    layout.pad_x = (dst_w - layout.resize_w) / 2;
+    layout.pad_y = (dst_h - layout.resize_h) / 2;
+    return layout;
+}
+
+cv::Size ComputeRectInputSize(const cv::Size &src_size, int max_w, int max_h, int stride) {
+    const LetterboxLayout full = ComputeLetterboxLayout(src_size, max_w, max_h);
+    stride = std::max(1, stride);
+    auto align = [stride](int v, int limit) {
+        const int aligned = (std::max(1, v) + stride - 1) / stride * stride;
+        return std::min(aligned, limit);
+    };
+    return cv::Size(align(full.resize_w, max_w), align(full.resize_h, max_h));
+}
+
+namespace {
+// 按 cv::resize(INTER_LINEAR) 的规则生成一维插值表：
+// 源坐标 = (d + 0.5) * (src/dst) - 0.5，越界时夹到边缘且权重归零
+void buildAxisTable(int src_len, int dst_len, int channels, std::vector<int> &ofs, std::vector<float> &alpha) {
+    ofs.resize(static_cast<size_t>(dst_len));
+    alpha.resize(static_cast<size_t>(dst_len));
+    const double inv_scale = static_cast<double>(src_len) / static_cast<double>(dst_len);
+    for (int d = 0; d < dst_len; ++d) {
+        float f = static_cast<float>((d + 0.5) * inv_scale - 0.5);
+        int s = static_cast<int>(std::floor(f));
+        f -= static_cast<float>(s);
+        if (s < 0) {
+            s = 0;
+            f = 0.0F;
+        }
+        if (s >= src_len - 1) {
+            s = src_len - 1;
+            f = 0.0F;
+        }
+        ofs[static_cast<size_t>(d)] = s * channels;
+        alpha[static_cast<size_t>(d)] = f;
+    }
+}
+}  // namespace
+
+void LetterboxKernel::prepare(const cv::Size &src_size, const LetterboxLayout &layout) {
+    if (src_size == src_size_ && layout == layout_ && !x_ofs_.empty()) return;
+
+    src_size_ = src_size;
+    layout_ = layout;
+    buildAxisTable(src_size.width, layout.resize_w, 3, x_ofs_, x_alpha_);
+    buildAxisTable(src_size.height, layout.resize_h, 1, y_ofs_, y_alpha_);
+    for (auto &buf : row_buf_) buf.resize(static_cast<size_t>(3 * layout.resize_w));
+}
+
+void LetterboxKernel::fillPadding(const LetterboxLayout &layout, float *dst) const {
+    const size_t plane = static_cast<size_t>(layout.dst_w) * static_cast<size_t>(layout.dst_h);
+    for (int c = 0; c < 3; ++c) {
+        float *p = dst + c * plane;
+        // 上下整行填充
+        std::fill(p, p + static_cast<size_t>(layout.pad_y) * layout.dst_w, kPadValue);
+        const int bottom = layout.pad_y + layout.resize_h;
+        std::fill(p + static_cast<size_t>(bottom) * layout.dst_w, p + plane, kPadValue);
+        // 中间行的左右两侧
+        const int right = layout.pad_x + layout.resize_w;
+        for (int y = layout.pad_y; y < bottom; ++y) {
+            float *row = p + static_cast<size_t>(y) * layout.dst_w;
+            std::fill(row, row + layout.pad_x, kPadValue);
+            std::fill(row + right, row + layout.dst_w, kPadValue);
+        }
+    }
+}
+
+void LetterboxKernel::interpolateRow(const cv::Mat &src, int sy, float *out) const {
+    const uchar *row = src.ptr<uchar>(sy);
+    const int n = layout_.resize_w;
+    const int last = (src_size_.width - 1) * 3;
+    float *out_r = out;
+    float *out_g = out + n;
+    float *out_b = out + 2 * n;
+    for (int dx = 0; dx < n; ++dx) {
+        const int sx = x_ofs_[static_cast<size_t>(dx)];
+        const int sx1 = std::min(sx + 3, last);
+        const float a = x_alpha_[static_cast<size_t>(dx)];
+        const float b = 1.0F - a;
+        // 源为 BGR，输出按 RGB 平面排列
+        out_b[dx] = static_cast<float>(row[sx + 0]) * b + static_cast<float>(row[sx1 + 0]) * a;
+        out_g[dx] = static_cast<float>(row[sx + 1]) * b + static_cast<float>(row[sx1 + 1]) * a;
+        out_r[dx] = static_cast<float>(row[sx + 2]) * b + static_cast<float>(row[sx1 + 2]) * a;
+    }
+}
+
+int LetterboxKernel::findCachedRow(int sy) const {
+    if (row_src_[0] == sy) return 0;
+    if (row_src_[1] == sy) return 1;
+    return -1;
+}
+
+void LetterboxKernel::blendRows(const float *a, const float *b, float fy, float *out, int n) const {
+    constexpr float kInv255 = 1.0F / 255.0F;
+    int i = 0;
+    if (use_simd_) {
+#if defined(MTT_SIMD_AVX2)
+        const __m256 vfy = _mm256_set1_ps(fy);
+        const __m256 vscale = _mm256_set1_ps(kInv255);
+        for (; i + 8 <= n; i += 8) {
+            const __m256 va = _mm256_loadu_ps(a + i);
+            const __m256 vb = _mm256_loadu_ps(b + i);
+            const __m256 v = _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(vb, va), vfy));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(v, vscale));
+        }
+#endif
+#if defined(MTT_SIMD_SSE2)
+        const __m128 vfy4 = _mm_set1_ps(fy);
+        const __m128 vscale4 = _mm_set1_ps(kInv255);
+        for (; i + 4 <= n; i += 4) {
+            const __m128 va = _mm_loadu_ps(a + i);
+            const __m128 vb = _mm_loadu_ps(b + i);
+            const __m128 v = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vfy4));
+            _mm_storeu_ps(out + i, _mm_mul_ps(v, vscale4));
+        }
+#elif defined(MTT_SIMD_NEON)
+        const float32x4_t vfy4 = vdupq_n_f32(fy);
+        const float32x4_t vscale4 = vdupq_n_f32(kInv255);
+        for (; i + 4 <= n; i += 4) {
+            const float32x4_t va = vld1q_f32(a + i);
+            const float32x4_t vb = vld1q_f32(b + i);
+            const float32x4_t v = vaddq_f32(va, vmulq_f32(vsubq_f32(vb, va), vfy4));
+            vst1q_f32(out + i, vmulq_f32(v, vscale4));
+        }
+#endif
+    }
+    for (; i < n; ++i) {
+        out[i] = (a[i] + (b[i] - a[i]) * fy) * kInv255;
+    }
+}
+
+void LetterboxKernel::run(const cv::Mat &src, const LetterboxLayout &layout, float *dst) {
+    if (src.empty() || src.type() != CV_8UC3) {
+        throw std::invalid_argument("LetterboxKernel: 仅支持非空 8UC3 (BGR) 输入");
+    }
+    if (layout.resize_w <= 0 || layout.resize_h <= 0 ||
+        layout.resize_w + layout.pad_x > layout.dst_w || layout.resize_h + layout.pad_y > layout.dst_h) {
+        throw std::invalid_argument("LetterboxKernel: letterbox 布局非法");
+    }
+
+    prepare(src.size(), layout);
+    // 行缓存只在本次 run 内有效：几何不变时 prepare 直接返回，上一张图的插值行不能带到这一张
+    row_src_[0] = row_src_[1] = -1;
+
+    // 目标缓冲是持久的：布局不变时 padding 区保持上次写入的值，无需重复填充
+    if (padded_dst_ != dst || padded_layout_ != layout) {
+        fillPadding(layout, dst);
+        padded_dst_ = dst;
+        padded_layout_ = layout;
+    }
+
+    const int n = layout.resize_w;
+    const size_t plane = static_cast<size_t>(layout.dst_w) * static_cast<size_t>(layout.dst_h);
+    const int last_row = src_size_.height - 1;
+
+    for (int dy = 0; dy < layout.resize_h; ++dy) {
+        const int sy0 = y_ofs_[static_cast<size_t>(dy)];
+        const int sy1 = std::min(sy0 + 1, last_row);
+        const float fy = y_alpha_[static_cast<size_t>(dy)];
+
+        // 取出（或复用）两条水平插值行；新算的行不能覆盖本行另一条要用的缓存
+        int slot0 = findCachedRow(sy0);
+        if (slot0 < 0) {
+            slot0 = (row_src_[0] == sy1) ? 1 : 0;
+            interpolateRow(src, sy0, row_buf_[slot0].data());
+            row_src_[slot0] = sy0;
+        }
+        int slot1 = findCachedRow(sy1);
+        if (slot1 < 0) {
+            slot1 = 1 - slot0;
+            interpolateRow(src, sy1, row_buf_[slot1].data());
+            row_src_[slot1] = sy1;
+        }
+        const float *rows[2] = {row_buf_[slot0].data(), row_buf_[slot1].data()};
+
+        // 垂直插值 + 归一化，直接写入三个平面的对应行
+        const size_t offset = static_cast<size_t>(dy + layout.pad_y) * layout.dst_w + layout.pad_x;
+        for (int c = 0; c < 3; ++c) {
+            blendRows(rows[0] + c * n, rows[1] + c * n, fy, dst + c * plane + offset, n);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+// letterbox 布局：等比例缩放到 resize_w x resize_h，再居中放入 dst_w x dst_h 的画布
+struct LetterboxLayout {
+    int dst_w = 0;
+    int dst_h = 0;
+    int resize_w = 0;
+    int resize_h = 0;
+    int pad_x = 0;
+    int pad_y = 0;
+    float scale = 1.0F;
+
+    bool operator==(const LetterboxLayout &o) const {
+        return dst_w == o.dst_w && dst_h == o.dst_h && resize_w == o.resize_w &&
+               resize_h == o.resize_h && pad_x == o.pad_x && pad_y == o.pad_y;
+    }
+    bool operator!=(const LetterboxLayout &o) const { return !(*this == o); }
+};
+
+// 与原 preprocess 相同的布局计算（scale 取宽高方向的较小值，余量两侧均分）
+LetterboxLayout ComputeLetterboxLayout(const cv::Size &src_size, int dst_w, int dst_h);
+
+// 矩形推理（模型 H/W 为动态维度时）：按与 max_w x max_h 相同的缩放比例缩放源图，
+// 再把宽高各自向上对齐到 stride 的倍数（不超过上限），得到能容纳源图宽高比的最小输入尺寸
+cv::Size ComputeRectInputSize(const cv::Size &src_size, int max_w, int max_h, int stride);
+
+// 融合 letterbox 预处理内核：
+// 一次遍历输出画布，完成 双线性缩放 + BGR->RGB + /255 + HWC->CHW，
+// 直接写入调用方持有的平面 float 缓冲（dst 需容纳 3*dst_w*dst_h 个 float）。
+// - 缩放插值与 cv::resize(INTER_LINEAR) 使用相同的像素中心对齐方式
+// - 灰色填充区（114/255）只在布局或目标缓冲变化时重新写入
+// - 垂直插值与归一化走 SIMD（AVX2/SSE2/NEON），并保留标量兜底
+class LetterboxKernel {
+public:
+    void run(const cv::Mat &src, const LetterboxLayout &layout, float *dst);
+
+    // 强制走标量路径（用于测试 SIMD 与标量结果一致）
+    void setUseSimd(bool enabled) { use_simd_ = enabled; }
+
+    static constexpr float kPadValue = 114.0F / 255.0F;
+
+private:
+    void prepare(const cv::Size &src_size, const LetterboxLayout &layout);
+    void fillPadding(const LetterboxLayout &layout, float *dst) const;
+    // 对源图第 sy 行做水平插值，按 RGB 平面写入 out（3 * resize_w 个 float）
+    void interpolateRow(const cv::Mat &src, int sy, float *out) const;
+    int findCachedRow(int sy) const;
+    // out = (a + (b - a) * fy) / 255
+    void blendRows(const float *a, const float *b, float fy, float *out, int n) const;
+
+    bool use_simd_ = true;
+
+    // 插值表：仅在源尺寸/布局变化时重建
+    cv::Size src_size_;
+    LetterboxLayout layout_;
+    std::vector<int> x_ofs_;      // 每个输出列对应的左侧源像素（已乘通道数 3）
+    std::vector<float> x_alpha_;  // 右侧源像素权重
+    std::vector<int> y_ofs_;
+    std::vector<float> y_alpha_;
+
+    // 两行水平插值缓存（相邻输出行常共用源行，放大时尤其明显）
+    std::vector<float> row_buf_[2];
+    int row_src_[2] = {-1, -1};
+
+    // 最近一次填充过 padding 的目标缓冲与布局
+    const float *padded_dst_ = nullptr;
+    LetterboxLayout padded_layout_;
+};
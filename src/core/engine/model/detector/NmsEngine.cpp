@@ -0,0 +1,365 @@
+#include "NmsEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "core/simd/Simd.h"
+
+namespace {
+// 网格单边最多的单元数（框分布极稀疏时避免网格过大）
+constexpr int kMaxGridCells = 64;
+// IoU/IoM 分母中的平滑项，与 BBox::operator& 保持一致
+constexpr float kOverlapEps = 1e-6F;
+}  // namespace
+
+void NmsEngine::sortByScore(const std::vector<BBox> &boxes) {
+    const size_t n = boxes.size();
+    order_.resize(n);
+    std::iota(order_.begin(), order_.end(), 0);
+    std::stable_sort(order_.begin(), order_.end(), [&](int lhs, int rhs) {
+        return boxes[static_cast<size_t>(lhs)].score > boxes[static_cast<size_t>(rhs)].score;
+    });
+    rank_.resize(n);
+    for (size_t r = 0; r < n; ++r) {
+        rank_[static_cast<size_t>(order_[r])] = static_cast<int>(r);
+    }
+}
+
+void NmsEngine::buildGrid(const std::vector<BBox> &boxes) {
+    const size_t n = boxes.size();
+    x0_.resize(n);
+    y0_.resize(n);
+    x1_.resize(n);
+    y1_.resize(n);
+    area_.resize(n);
+    class_.resize(n);
+
+    float min_x = 0.0F, min_y = 0.0F, max_x = 0.0F, max_y = 0.0F;
+    double size_sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const cv::Rect2f &r = boxes[i].box;
+        // 与 BBox::operator& 相同：右下角取 br()，面积取 area()
+        x0_[i] = r.x;
+        y0_[i] = r.y;
+        x1_[i] = r.br().x;
+        y1_[i] = r.br().y;
+        area_[i] = r.area();
+        class_[i] = boxes[i].class_id;
+        if (i == 0) {
+            min_x = x0_[i];
+            min_y = y0_[i];
+            max_x = x1_[i];
+            max_y = y1_[i];
+        } else {
+            min_x = std::min(min_x, x0_[i]);
+            min_y = std::min(min_y, y0_[i]);
+            max_x = std::max(max_x, x1_[i]);
+            max_y = std::max(max_y, y1_[i]);
+        }
+        size_sum += std::max(r.width, r.height);
+    }
+
+    // 单元边长取平均框尺寸：一个框通常只覆盖 1~4 个单元
+    const float extent = std::max(max_x - min_x, max_y - min_y);
+    const float mean_size = n > 0 ? static_cast<float>(size_sum / static_cast<double>(n)) : 1.0F;
+    cell_size_ = std::max({mean_size, extent / static_cast<float>(kMaxGridCells), 1.0F});
+    grid_x0_ = min_x;
+    grid_y0_ = min_y;
+    grid_cols_ = std::clamp(static_cast<int>((max_x - min_x) / cell_size_) + 1, 1, kMaxGridCells + 1);
+    grid_rows_ = std::clamp(static_cast<int>((max_y - min_y) / cell_size_) + 1, 1, kMaxGridCells + 1);
+
+    const size_t cell_count = static_cast<size_t>(grid_cols_ * grid_rows_);
+    if (cells_.size() < cell_count) cells_.resize(cell_count);
+    for (size_t c = 0; c < cell_count; ++c) cells_[c].clear();
+
+    visit_stamp_.assign(n, 0);
+    stamp_ = 0;
+}
+
+namespace {
+int CellIndex(float v, float origin, float cell, int count) {
+    const int c = static_cast<int>(std::floor((v - origin) / cell));
+    return std::clamp(c, 0, count - 1);
+}
+}  // namespace
+
+void NmsEngine::insertToGrid(int idx) {
+    const size_t i = static_cast<size_t>(idx);
+    const int cx0 = CellIndex(x0_[i], grid_x0_, cell_size_, grid_cols_);
+    const int cx1 = CellIndex(x1_[i], grid_x0_, cell_size_, grid_cols_);
+    const int cy0 = CellIndex(y0_[i], grid_y0_, cell_size_, grid_rows_);
+    const int cy1 = CellIndex(y1_[i], grid_y0_, cell_size_, grid_rows_);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            cells_[static_cast<size_t>(cy * grid_cols_ + cx)].push_back(idx);
+        }
+    }
+}
+
+void NmsEngine::collectNeighbors(int idx) {
+    const size_t i = static_cast<size_t>(idx);
+    if (++stamp_ == 0) {
+        std::fill(visit_stamp_.begin(), visit_stamp_.end(), 0);
+        stamp_ = 1;
+    }
+    visit_stamp_[i] = stamp_;  // 排除自身
+    neighbors_.clear();
+
+    // 两个框有正面积交集时，交集内任一点所在的单元同时被两者覆盖
+    const int cx0 = CellIndex(x0_[i], grid_x0_, cell_size_, grid_cols_);
+    const int cx1 = CellIndex(x1_[i], grid_x0_, cell_size_, grid_cols_);
+    const int cy0 = CellIndex(y0_[i], grid_y0_, cell_size_, grid_rows_);
+    const int cy1 = CellIndex(y1_[i], grid_y0_, cell_size_, grid_rows_);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            for (int j : cells_[static_cast<size_t>(cy * grid_cols_ + cx)]) {
+                const size_t sj = static_cast<size_t>(j);
+                if (visit_stamp_[sj] == stamp_ || class_[sj] != class_[i]) continue;
+                visit_stamp_[sj] = stamp_;
+                neighbors_.push_back(j);
+            }
+        }
+    }
+
+    // 邻居坐标收集为连续 SoA，便于批量计算
+    const size_t m = neighbors_.size();
+    nx0_.resize(m);
+    ny0_.resize(m);
+    nx1_.resize(m);
+    ny1_.resize(m);
+    narea_.resize(m);
+    for (size_t k = 0; k < m; ++k) {
+        const size_t j = static_cast<size_t>(neighbors_[k]);
+        nx0_[k] = x0_[j];
+        ny0_[k] = y0_[j];
+        nx1_[k] = x1_[j];
+        ny1_[k] = y1_[j];
+        narea_[k] = area_[j];
+    }
+}
+
+void NmsEngine::computeOverlaps(int idx, bool use_iom) {
+    const size_t i = static_cast<size_t>(idx);
+    const size_t m = neighbors_.size();
+    overlaps_.resize(m);
+    const float bx0 = x0_[i], by0 = y0_[i], bx1 = x1_[i], by1 = y1_[i], barea = area_[i];
+
+    size_t k = 0;
+    if (use_simd_) {
+#if defined(MTT_SIMD_AVX2)
+        const __m256 vx0 = _mm256_set1_ps(bx0), vy0 = _mm256_set1_ps(by0);
+        const __m256 vx1 = _mm256_set1_ps(bx1), vy1 = _mm256_set1_ps(by1);
+        const __m256 varea = _mm256_set1_ps(barea);
+        const __m256 zero = _mm256_setzero_ps(), eps = _mm256_set1_ps(kOverlapEps);
+        for (; k + 8 <= m; k += 8) {
+            const __m256 iw = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(_mm256_loadu_ps(&nx1_[k]), vx1),
+                                                          _mm256_max_ps(_mm256_loadu_ps(&nx0_[k]), vx0)), zero);
+            const __m256 ih = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(_mm256_loadu_ps(&ny1_[k]), vy1),
+                                                          _mm256_max_ps(_mm256_loadu_ps(&ny0_[k]), vy0)), zero);
+            const __m256 inter = _mm256_mul_ps(iw, ih);
+            const __m256 na = _mm256_loadu_ps(&narea_[k]);
+            const __m256 denom = use_iom
+                ? _mm256_add_ps(_mm256_min_ps(na, varea), eps)
+                : _mm256_add_ps(_mm256_sub_ps(_mm256_add_ps(na, varea), inter), eps);
+            const __m256 valid = _mm256_cmp_ps(inter, zero, _CMP_GT_OQ);
+            _mm256_storeu_ps(&overlaps_[k], _mm256_and_ps(valid, _mm256_div_ps(inter, denom)));
+        }
+#endif
+#if defined(MTT_SIMD_SSE2)
+        const __m128 vx04 = _mm_set1_ps(bx0), vy04 = _mm_set1_ps(by0);
+        const __m128 vx14 = _mm_set1_ps(bx1), vy14 = _mm_set1_ps(by1);
+        const __m128 varea4 = _mm_set1_ps(barea);
+        const __m128 zero4 = _mm_setzero_ps(), eps4 = _mm_set1_ps(kOverlapEps);
+        for (; k + 4 <= m; k += 4) {
+            const __m128 iw4 = _mm_max_ps(_mm_sub_ps(_mm_min_ps(_mm_loadu_ps(&nx1_[k]), vx14),
+                                                     _mm_max_ps(_mm_loadu_ps(&nx0_[k]), vx04)), zero4);
+            const __m128 ih4 = _mm_max_ps(_mm_sub_ps(_mm_min_ps(_mm_loadu_ps(&ny1_[k]), vy14),
+                                                     _mm_max_ps(_mm_loadu_ps(&ny0_[k]), vy04)), zero4);
+            const __m128 inter4 = _mm_mul_ps(iw4, ih4);
+            const __m128 na4 = _mm_loadu_ps(&narea_[k]);
+            const __m128 denom4 = use_iom
+                ? _mm_add_ps(_mm_min_ps(na4, varea4), eps4)
+                : _mm_add_ps(_mm_sub_ps(_mm_add_ps(na4, varea4), inter4), eps4);
+            const __m128 valid4 = _mm_cmpgt_ps(inter4, zero4);
+            _mm_storeu_ps(&overlaps_[k], _mm_and_ps(valid4, _mm_div_ps(inter4, denom4)));
+        }
+#elif defined(MTT_SIMD_NEON)
+        const float32x4_t vx04 = vdupq_n_f32(bx0), vy04 = vdupq_n_f32(by0);
+        const float32x4_t vx14 = vdupq_n_f32(bx1), vy14 = vdupq_n_f32(by1);
+        const float32x4_t varea4 = vdupq_n_f32(barea);
+        const float32x4_t zero4 = vdupq_n_f32(0.0F), eps4 = vdupq_n_f32(kOverlapEps);
+        for (; k + 4 <= m; k += 4) {
+            const float32x4_t iw4 = vmaxq_f32(vsubq_f32(vminq_f32(vld1q_f32(&nx1_[k]), vx14),
+                                                        vmaxq_f32(vld1q_f32(&nx0_[k]), vx04)), zero4);
+            const float32x4_t ih4 = vmaxq_f32(vsubq_f32(vminq_f32(vld1q_f32(&ny1_[k]), vy14),
+                                                        vmaxq_f32(vld1q_f32(&ny0_[k]), vy04)), zero4);
+            const float32x4_t inter4 = vmulq_f32(iw4, ih4);
+            const float32x4_t na4 = vld1q_f32(&narea_[k]);
+            const float32x4_t denom4 = use_iom
+                ? vaddq_f32(vminq_f32(na4, varea4), eps4)
+                : vaddq_f32(vsubq_f32(vaddq_f32(na4, varea4), inter4), eps4);
+            const uint32x4_t valid4 = vcgtq_f32(inter4, zero4);
+            const float32x4_t ov4 = vdivq_f32(inter4, denom4);
+            vst1q_f32(&overlaps_[k], vreinterpretq_f32_u32(vandq_u32(valid4, vreinterpretq_u32_f32(ov4))));
+        }
+#endif
+    }
+    for (; k < m; ++k) {
+        const float iw = std::max(0.0F, std::min(nx1_[k], bx1) - std::max(nx0_[k], bx0));
+        const float ih = std::max(0.0F, std::min(ny1_[k], by1) - std::max(ny0_[k], by0));
+        const float inter = iw * ih;
+        if (inter <= 0.0F) {
+            overlaps_[k] = 0.0F;
+            continue;
+        }
+        const float denom = use_iom ? std::min(narea_[k], barea) + kOverlapEps
+                                    : narea_[k] + barea - inter + kOverlapEps;
+        overlaps_[k] = inter / denom;
+    }
+}
+
+void NmsEngine::runGreedy(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out) {
+    // 网格中只放已保留的框：候选被删除当且仅当与某个更高分的已保留框重叠超过阈值
+    for (int idx : order_) {
+        collectNeighbors(idx);
+        computeOverlaps(idx, params.use_iom);
+        const bool suppressed = std::any_of(overlaps_.begin(), overlaps_.end(), [&](float ov) {
+            return ov > params.overlap_threshold;
+        });
+        if (suppressed) continue;
+        insertToGrid(idx);
+        out.push_back(boxes[static_cast<size_t>(idx)]);
+    }
+}
+
+void NmsEngine::runMatrix(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out) {
+    // Matrix-NMS（高斯核）：
+    //   decay_j = min_{i 更高分} exp(-(ov_ij^2 - comp_i^2) / sigma)，comp_i = max_{k 比 i 更高分} ov_ki
+    // 不重叠的框对贡献 exp(comp_i^2 / sigma) >= 1，不影响取最小值，因此只需遍历网格邻居
+    const size_t n = boxes.size();
+    for (int idx : order_) insertToGrid(idx);
+    compensate_.assign(n, 0.0F);
+    scores_.resize(n);
+
+    for (int idx : order_) {
+        const size_t i = static_cast<size_t>(idx);
+        collectNeighbors(idx);
+        computeOverlaps(idx, params.use_iom);
+        float comp = 0.0F;
+        float decay = 1.0F;
+        for (size_t k = 0; k < neighbors_.size(); ++k) {
+            const size_t j = static_cast<size_t>(neighbors_[k]);
+            if (rank_[j] > rank_[i]) continue;  // 只看更高分的框
+            const float ov = overlaps_[k];
+            comp = std::max(comp, ov);
+            const float c = compensate_[j];
+            decay = std::min(decay, std::exp(-(ov * ov - c * c) / params.sigma));
+        }
+        compensate_[i] = comp;
+        scores_[i] = boxes[i].score * decay;
+    }
+
+    for (int idx : order_) {
+        const size_t i = static_cast<size_t>(idx);
+        if (scores_[i] < params.min_score) continue;
+        out.push_back(boxes[i]);
+        out.back().score = scores_[i];
+    }
+    std::stable_sort(out.begin(), out.end(), [](const BBox &a, const BBox &b) { return a.score > b.score; });
+}
+
+void NmsEngine::runSoft(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out) {
+    // 高斯 Soft-NMS：每次取当前最高分框，仅对其网格邻居衰减分数；
+    // 分数只会下降，用惰性更新的最大堆代替每轮线性找最大值
+    const size_t n = boxes.size();
+    for (int idx : order_) insertToGrid(idx);
+    scores_.resize(n);
+    done_.assign(n, 0);
+
+    std::vector<std::pair<float, int>> &heap = heap_;
+    heap.clear();
+    auto less = [&](const std::pair<float, int> &a, const std::pair<float, int> &b) {
+        if (a.first != b.first) return a.first < b.first;
+        return rank_[static_cast<size_t>(a.second)] > rank_[static_cast<size_t>(b.second)];
+    };
+    for (size_t i = 0; i < n; ++i) {
+        scores_[i] = boxes[i].score;
+        heap.emplace_back(scores_[i], static_cast<int>(i));
+    }
+    std::make_heap(heap.begin(), heap.end(), less);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), less);
+        const auto [score, idx] = heap.back();
+        heap.pop_back();
+        const size_t i = static_cast<size_t>(idx);
+        if (done_[i] || score != scores_[i]) continue;  // 过期条目
+        if (score < params.min_score) break;            // 剩余的分数都更低
+
+        done_[i] = 1;
+        out.push_back(boxes[i]);
+        out.back().score = score;
+
+        collectNeighbors(idx);
+        computeOverlaps(idx, params.use_iom);
+        for (size_t k = 0; k < neighbors_.size(); ++k) {
+            const size_t j = static_cast<size_t>(neighbors_[k]);
+            const float ov = overlaps_[k];
+            if (done_[j] || ov <= 0.0F) continue;
+            scores_[j] *= std::exp(-(ov * ov) / params.sigma);
+            heap.emplace_back(scores_[j], neighbors_[k]);
+            std::push_heap(heap.begin(), heap.end(), less);
+        }
+    }
+}
+
+void NmsEngine::runMerge(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out) {
+    // 与 Greedy 相同的遍历顺序，但被抑制的框不丢弃，而是并入与之重叠最大的已保留框（取外接矩形）。
+    // 重叠度按已保留框的原始范围计算，被切缝截断的半个目标会拼回到完整框上，分数取较高者（即保留框的分数）
+    out_slot_.assign(boxes.size(), -1);
+    for (int idx : order_) {
+        collectNeighbors(idx);
+        computeOverlaps(idx, params.use_iom);
+        int target = -1;
+        float best = params.overlap_threshold;
+        for (size_t k = 0; k < neighbors_.size(); ++k) {
+            if (overlaps_[k] > best) {
+                best = overlaps_[k];
+                target = neighbors_[k];
+            }
+        }
+        const size_t i = static_cast<size_t>(idx);
+        if (target >= 0) {
+            BBox &kept = out[static_cast<size_t>(out_slot_[static_cast<size_t>(target)])];
+            kept.box |= boxes[i].box;
+            continue;
+        }
+        insertToGrid(idx);
+        out_slot_[i] = static_cast<int>(out.size());
+        out.push_back(boxes[i]);
+    }
+}
+
+void NmsEngine::run(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out) {
+    out.clear();
+    if (boxes.empty()) return;
+
+    sortByScore(boxes);
+    buildGrid(boxes);
+    switch (params.method) {
+        case NmsMethod::Matrix:
+            runMatrix(boxes, params, out);
+            break;
+        case NmsMethod::Soft:
+            runSoft(boxes, params, out);
+            break;
+        case NmsMethod::Merge:
+            runMerge(boxes, params, out);
+            break;
+        case NmsMethod::Greedy:
+        default:
+            runGreedy(boxes, params, out);
+            break;
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BBox.h"
+
+// NMS 方式
+enum class NmsMethod {
+    Greedy = 0,  // 经典硬 NMS：与高分框重叠超过阈值即删除
+    Matrix = 1,  // Matrix-NMS：按与更高分框的重叠一次性衰减分数
+    Soft = 2,    // 高斯 Soft-NMS：逐个选出最高分框，衰减其邻居分数
+    Merge = 3,   // 非极大值合并：与高分框重叠超过阈值的框并入该框（取外接矩形），用于切片检测的跨缝合并
+};
+
+struct NmsParams {
+    NmsMethod method = NmsMethod::Greedy;
+    float overlap_threshold = 0.8F;  // Greedy/Merge 的重叠阈值
+    bool use_iom = false;            // 重叠度量：false 为 IoU，true 为 IoM（交集 / 较小框面积）
+    float sigma = 0.5F;              // Matrix/Soft 的高斯衰减参数
+    float min_score = 0.25F;         // Matrix/Soft 衰减后低于该分数的框被丢弃
+};
+
+// 基于均匀网格的同类别 NMS：
+// - 只有落在相同网格单元的框才可能重叠，候选只与附近的框计算重叠度
+// - 邻居的坐标先收集为 SoA，再用 SIMD（AVX2/SSE2/NEON）批量计算 IoU/IoM，保留标量兜底
+// - Greedy 与逐对比较的 O(n^2) 实现结果一致（按分数降序输出，同分按输入顺序）
+// 内部缓冲在多次调用间复用。
+class NmsEngine {
+public:
+    void run(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out);
+
+    // 强制走标量路径（用于测试 SIMD 与标量结果一致）
+    void setUseSimd(bool enabled) { use_simd_ = enabled; }
+
+private:
+    void sortByScore(const std::vector<BBox> &boxes);
+    void buildGrid(const std::vector<BBox> &boxes);
+    void insertToGrid(int idx);
+    // 收集与 idx 同类别、落在相同网格单元的框（去重），写入 neighbors_
+    void collectNeighbors(int idx);
+    // 计算 idx 与 neighbors_ 中各框的重叠度，写入 overlaps_
+    void computeOverlaps(int idx, bool use_iom);
+
+    void runGreedy(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out);
+    void runMatrix(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out);
+    void runSoft(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out);
+    void runMerge(const std::vector<BBox> &boxes, const NmsParams &params, std::vector<BBox> &out);
+
+    bool use_simd_ = true;
+
+    // 所有框的 SoA 坐标（x1/y1 为右下角）
+    std::vector<float> x0_, y0_, x1_, y1_, area_;
+    std::vector<int> class_;
+    std::vector<int> order_;  // 按分数降序（同分按输入顺序）
+    std::vector<int> rank_;   // order_ 的逆映射
+
+    // 网格：每个单元保存已插入的框索引
+    float grid_x0_ = 0.0F;
+    float grid_y0_ = 0.0F;
+    float cell_size_ = 1.0F;
+    int grid_cols_ = 1;
+    int grid_rows_ = 1;
+    std::vector<std::vector<int>> cells_;
+
+    // 邻居查询缓冲
+    std::vector<uint32_t> visit_stamp_;
+    uint32_t stamp_ = 0;
+    std::vector<int> neighbors_;
+    std::vector<float> nx0_, ny0_, nx1_, ny1_, narea_;
+    std::vector<float> overlaps_;
+
+    // Matrix/Soft 使用的分数缓冲
+    std::vector<float> scores_;
+    std::vector<float> compensate_;
+    std::vector<unsigned char> done_;
+    std::vector<std::pair<float, int>> heap_;  // Soft-NMS 的 (分数, 索引) 最大堆
+    std::vector<int> out_slot_;                // Merge：已保留框在输出中的位置
+};
@@ -0,0 +1,39 @@
+#include "TileLayout.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 返回各切片在该方向上的起点
+std::vector<int> TileStarts(int length, int tile, float overlap) {
+    if (length <= tile) return {0};
+    const int stride = std::max(1, tile - static_cast<int>(std::lround(static_cast<float>(tile) * overlap)));
+    const int count = (length - tile + stride - 1) / stride + 1;
+    // 在首尾贴边的前提下把余量均匀分给各个间隔，实际重叠不小于配置值
+    std::vector<int> starts(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        starts[static_cast<size_t>(i)] = static_cast<int>(
+            std::lround(static_cast<double>(length - tile) * i / std::max(1, count - 1)));
+    }
+    return starts;
+}
+}  // namespace
+
+std::vector<cv::Rect> ComputeTileGrid(const cv::Size &frame_size, const TilingConfig &config) {
+    std::vector<cv::Rect> tiles;
+    if (frame_size.width <= 0 || frame_size.height <= 0) return tiles;
+
+    const int tile_w = std::max(1, config.tile_width);
+    const int tile_h = std::max(1, config.tile_height);
+    const float overlap = std::clamp(config.overlap, 0.0F, 0.9F);
+    const std::vector<int> xs = TileStarts(frame_size.width, tile_w, overlap);
+    const std::vector<int> ys = TileStarts(frame_size.height, tile_h, overlap);
+
+    tiles.reserve(xs.size() * ys.size());
+    for (int y : ys) {
+        for (int x : xs) {
+            tiles.emplace_back(x, y, std::min(tile_w, frame_size.width), std::min(tile_h, frame_size.height));
+        }
+    }
+    return tiles;
+}
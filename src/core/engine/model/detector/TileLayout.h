@@ -0,0 +1,19 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+// 切片检测：高分辨率画面按原生尺度切成相互重叠的切片，合成一个 batch 推理，
+// 再用合并 NMS 把被切缝截断的框拼回完整目标，远处的小目标不会因整图缩放而丢失
+struct TilingConfig {
+    bool enabled = false;          // 关闭时整帧 letterbox 到模型输入（默认行为）
+    int tile_width = 640;          // 切片宽（原帧像素）；与模型输入等大时切片不缩放
+    int tile_height = 640;         // 切片高（原帧像素）
+    float overlap = 0.2F;          // 相邻切片的重叠比例（相对切片宽/高），应覆盖常见目标尺寸
+    bool include_full_frame = true;  // 额外把整帧缩放后放进同一个 batch，用于检出跨越多个切片的大目标
+    float merge_threshold = 0.5F;  // 跨切片合并的 IoM 阈值（交集 / 较小框面积）
+};
+
+// 按行优先生成切片网格：每个方向上切片数尽量少，首尾切片贴齐画面边界，相邻切片至少重叠 overlap；
+// 画面在某个方向上不大于切片时，该方向只有一个切片
+std::vector<cv::Rect> ComputeTileGrid(const cv::Size &frame_size, const TilingConfig &config);
@@ -0,0 +1,296 @@
+#include "YoloDecoder.h"
+
+#include <opencv2/core/utility.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/simd/Simd.h"
+
+YoloOutputLayout ResolveYoloOutputLayout(const std::vector<int64_t> &shape) {
+    if (shape.size() < 2) {
+        throw std::runtime_error("YoloDetector: 不支持的输出维度");
+    }
+
+    YoloOutputLayout layout;
+    // YOLO 输出有可能是 [1, 85, 25200]（channels first）
+    // 或 [1, 25200, 85]（channels last）
+    if (shape.size() == 3) {
+        const int64_t dim1 = shape[1];
+        const int64_t dim2 = shape[2];
+        layout.channels_first = dim1 <= dim2;
+        layout.attr_count = static_cast<size_t>(layout.channels_first ? dim1 : dim2);
+        layout.num_boxes = static_cast<size_t>(layout.channels_first ? dim2 : dim1);
+    } else {
+        // 若是 [N,85]
+        layout.num_boxes = static_cast<size_t>(shape[0]);
+        layout.attr_count = static_cast<size_t>(shape[1]);
+    }
+
+    if (layout.attr_count < 6) {
+        throw std::runtime_error("YoloDetector: 输出维度不足以解析检测框");
+    }
+    // 部分导出的 YOLO（如 yolo11/12）输出形状为 [batch, 84, 8400]，仅包含 4+80 项（无 obj）
+    layout.class_start = layout.attr_count == 84 ? 4 : 5;
+    return layout;
+}
+
+namespace {
+// 每次在 L1 内处理的 anchor 数：best_score_/best_class_ 各 4KB，逐类别行扫描时常驻缓存
+constexpr size_t kTileAnchors = 1024;
+// 单个线程分到的最少 anchor 数，避免切得过碎
+constexpr size_t kMinAnchorsPerChunk = 4096;
+
+// cx, cy, w, h（YOLO 格式）反 letterbox 映射到原图并做边界过滤，与原标量解码逐步一致
+void EmitBox(float cx, float cy, float w, float h, int cls, float score,
+             const YoloDecodeParams &params, std::vector<BBox> &out) {
+    const float width = static_cast<float>(params.original_size.width);
+    const float height = static_cast<float>(params.original_size.height);
+
+    float x0 = (cx - w / 2.0F - params.pad_x) / params.scale;
+    float y0 = (cy - h / 2.0F - params.pad_y) / params.scale;
+    float x1 = (cx + w / 2.0F - params.pad_x) / params.scale;
+    float y1 = (cy + h / 2.0F - params.pad_y) / params.scale;
+
+    // 超出边界需要裁剪
+    x0 = std::clamp(x0, 0.0F, width);
+    y0 = std::clamp(y0, 0.0F, height);
+    x1 = std::clamp(x1, 0.0F, width);
+    y1 = std::clamp(y1, 0.0F, height);
+
+    // 可选过滤触边框（某边位于或超过画面边界）
+    if (params.filter_edge_boxes) {
+        if (x0 <= 0.0F || y0 <= 0.0F || x1 >= width || y1 >= height) {
+            return;
+        }
+    }
+    if (x1 <= x0 || y1 <= y0) {
+        return;  // 非法框
+    }
+    out.emplace_back(cv::Rect2f(cv::Point2f(x0, y0), cv::Point2f(x1, y1)), cls, score);
+}
+
+// 与原实现相同的 argmax 语义：初值 0 / -1，严格大于才更新（并列时取较小类别）
+int ArgMaxStrided(const float *scores, size_t stride, size_t count, float &best) {
+    best = 0.0F;
+    int best_class = -1;
+    for (size_t c = 0; c < count; ++c) {
+        const float v = scores[c * stride];
+        if (v > best) {
+            best = v;
+            best_class = static_cast<int>(c);
+        }
+    }
+    return best_class;
+}
+}  // namespace
+
+void YoloDecoder::setFocusClasses(const std::vector<int> &class_ids) {
+    focus_classes_ = class_ids;
+    std::sort(focus_classes_.begin(), focus_classes_.end());
+    focus_classes_.erase(std::unique(focus_classes_.begin(), focus_classes_.end()), focus_classes_.end());
+    focus_active_ = !focus_classes_.empty();
+}
+
+void YoloDecoder::scanClassRow(const float *row, int cls, size_t count, float *best, int32_t *best_class) const {
+    size_t i = 0;
+    if (use_simd_) {
+#if defined(MTT_SIMD_AVX2)
+        const __m256i vcls = _mm256_set1_epi32(cls);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 v = _mm256_loadu_ps(row + i);
+            const __m256 b = _mm256_loadu_ps(best + i);
+            const __m256 gt = _mm256_cmp_ps(v, b, _CMP_GT_OQ);
+            _mm256_storeu_ps(best + i, _mm256_blendv_ps(b, v, gt));
+            const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(best_class + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(best_class + i),
+                                _mm256_blendv_epi8(idx, vcls, _mm256_castps_si256(gt)));
+        }
+#endif
+#if defined(MTT_SIMD_SSE2)
+        const __m128i vcls4 = _mm_set1_epi32(cls);
+        for (; i + 4 <= count; i += 4) {
+            const __m128 v = _mm_loadu_ps(row + i);
+            const __m128 b = _mm_loadu_ps(best + i);
+            const __m128 gt = _mm_cmpgt_ps(v, b);
+            _mm_storeu_ps(best + i, _mm_or_ps(_mm_and_ps(gt, v), _mm_andnot_ps(gt, b)));
+            const __m128i mask = _mm_castps_si128(gt);
+            const __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(best_class + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(best_class + i),
+                             _mm_or_si128(_mm_and_si128(mask, vcls4), _mm_andnot_si128(mask, idx)));
+        }
+#elif defined(MTT_SIMD_NEON)
+        const int32x4_t vcls4 = vdupq_n_s32(cls);
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t v = vld1q_f32(row + i);
+            const float32x4_t b = vld1q_f32(best + i);
+            const uint32x4_t gt = vcgtq_f32(v, b);
+            vst1q_f32(best + i, vbslq_f32(gt, v, b));
+            vst1q_s32(best_class + i, vbslq_s32(gt, vcls4, vld1q_s32(best_class + i)));
+        }
+#endif
+    }
+    for (; i < count; ++i) {
+        if (row[i] > best[i]) {
+            best[i] = row[i];
+            best_class[i] = cls;
+        }
+    }
+}
+
+bool YoloDecoder::confirmFocus(const float *scores, size_t stride, size_t class_count,
+                               int &best_class, float &best_score) const {
+    best_class = ArgMaxStrided(scores, stride, class_count, best_score);
+    return best_class >= 0 && focus_mask_[static_cast<size_t>(best_class)] != 0;
+}
+
+void YoloDecoder::decodeChannelsFirst(const float *data, const YoloOutputLayout &layout,
+                                      const YoloDecodeParams &params, size_t begin, size_t end,
+                                      std::vector<BBox> &out) {
+    const size_t n = layout.num_boxes;
+    const size_t class_count = layout.classCount();
+    const float *class_rows = data + layout.class_start * n;
+    const float *obj_row = layout.hasObjectness() ? data + 4 * n : nullptr;
+    const float threshold = params.score_threshold;
+
+    for (size_t tile = begin; tile < end; tile += kTileAnchors) {
+        const size_t count = std::min(kTileAnchors, end - tile);
+        float *best = best_score_.data() + tile;
+        int32_t *best_class = best_class_.data() + tile;
+        std::fill(best, best + count, 0.0F);
+        std::fill(best_class, best_class + count, -1);
+
+        // 1. 按类别行连续扫描：只访问需要的类别（关注类别或全部类别）
+        for (int c : scan_classes_) {
+            scanClassRow(class_rows + static_cast<size_t>(c) * n + tile, c, count, best, best_class);
+        }
+
+        // 2. 阈值淘汰；设置了关注类别时，幸存者还需确认全类别最高分属于关注类别
+        for (size_t k = 0; k < count; ++k) {
+            const size_t i = tile + k;
+            const float objectness = obj_row ? obj_row[i] : 1.0F;
+            float best_score = best[k];
+            int cls = best_class[k];
+            if (objectness * best_score < threshold) {
+                continue;  // 太小的框不要
+            }
+            if (focus_active_) {
+                if (!confirmFocus(class_rows + i, n, class_count, cls, best_score)) {
+                    continue;
+                }
+            }
+            // 最终置信度 = objectness * class_score
+            const float final_score = objectness * best_score;
+            if (final_score < threshold) {
+                continue;
+            }
+            EmitBox(data[i], data[n + i], data[2 * n + i], data[3 * n + i], cls, final_score, params, out);
+        }
+    }
+}
+
+void YoloDecoder::decodeChannelsLast(const float *data, const YoloOutputLayout &layout,
+                                     const YoloDecodeParams &params, size_t begin, size_t end,
+                                     std::vector<BBox> &out) const {
+    const size_t class_count = layout.classCount();
+    const float threshold = params.score_threshold;
+
+    for (size_t i = begin; i < end; ++i) {
+        const float *row = data + i * layout.attr_count;
+        const float *scores = row + layout.class_start;
+        const float objectness = layout.hasObjectness() ? row[4] : 1.0F;
+
+        float best_score = 0.0F;
+        int cls = -1;
+        if (focus_active_) {
+            // 先只看关注类别，整行 argmax 仅对幸存者执行
+            for (int c : scan_classes_) {
+                const float v = scores[c];
+                if (v > best_score) {
+                    best_score = v;
+                    cls = c;
+                }
+            }
+            if (objectness * best_score < threshold) {
+                continue;
+            }
+            if (!confirmFocus(scores, 1, class_count, cls, best_score)) {
+                continue;
+            }
+        } else {
+            cls = ArgMaxStrided(scores, 1, class_count, best_score);
+        }
+
+        // 最终置信度 = objectness * class_score
+        const float final_score = objectness * best_score;
+        if (final_score < threshold) {
+            continue;  // 太小的框不要
+        }
+        EmitBox(row[0], row[1], row[2], row[3], cls, final_score, params, out);
+    }
+}
+
+void YoloDecoder::decode(const float *data, const YoloOutputLayout &layout, const YoloDecodeParams &params,
+                         std::vector<BBox> &out) {
+    const size_t class_count = layout.classCount();
+
+    // 关注类别映射到当前输出的类别范围；越界的类别永远不会被选中
+    scan_classes_.clear();
+    focus_mask_.assign(class_count, focus_active_ ? 0 : 1);
+    if (focus_active_) {
+        for (int c : focus_classes_) {
+            if (c >= 0 && static_cast<size_t>(c) < class_count) {
+                scan_classes_.push_back(c);
+                focus_mask_[static_cast<size_t>(c)] = 1;
+            }
+        }
+        if (scan_classes_.empty()) {
+            return;
+        }
+    } else {
+        for (size_t c = 0; c < class_count; ++c) {
+            scan_classes_.push_back(static_cast<int>(c));
+        }
+    }
+
+    if (layout.channels_first && best_score_.size() < layout.num_boxes) {
+        best_score_.resize(layout.num_boxes);
+        best_class_.resize(layout.num_boxes);
+    }
+
+    // anchor 数较多时按区间切分到多线程，各区间结果按顺序拼接，保证输出与单线程一致
+    size_t chunks = 1;
+    if (layout.num_boxes >= parallel_min_anchors_) {
+        const size_t by_size = (layout.num_boxes + kMinAnchorsPerChunk - 1) / kMinAnchorsPerChunk;
+        chunks = std::clamp<size_t>(static_cast<size_t>(std::max(1, cv::getNumThreads())), 1, by_size);
+    }
+
+    auto decodeRange = [&](size_t begin, size_t end, std::vector<BBox> &dst) {
+        if (layout.channels_first) {
+            decodeChannelsFirst(data, layout, params, begin, end, dst);
+        } else {
+            decodeChannelsLast(data, layout, params, begin, end, dst);
+        }
+    };
+
+    if (chunks <= 1) {
+        decodeRange(0, layout.num_boxes, out);
+        return;
+    }
+
+    if (chunk_boxes_.size() < chunks) chunk_boxes_.resize(chunks);
+    // 区间边界按 tile 对齐，避免不同线程共享同一段扫描缓冲
+    const size_t per_chunk = ((layout.num_boxes + chunks - 1) / chunks + kTileAnchors - 1) / kTileAnchors * kTileAnchors;
+    cv::parallel_for_(cv::Range(0, static_cast<int>(chunks)), [&](const cv::Range &range) {
+        for (int r = range.start; r < range.end; ++r) {
+            const size_t begin = static_cast<size_t>(r) * per_chunk;
+            const size_t end = std::min(layout.num_boxes, begin + per_chunk);
+            auto &dst = chunk_boxes_[static_cast<size_t>(r)];
+            dst.clear();
+            if (begin < end) decodeRange(begin, end, dst);
+        }
+    });
+    for (size_t r = 0; r < chunks; ++r) {
+        out.insert(out.end(), chunk_boxes_[r].begin(), chunk_boxes_[r].end());
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BBox.h"
+
+// YOLO 输出布局：[1, A, N]（channels first）、[1, N, A]（channels last）或 [N, A]
+struct YoloOutputLayout {
+    size_t num_boxes = 0;        // anchor 数 N
+    size_t attr_count = 0;       // 每个 anchor 的属性数 A
+    bool channels_first = false;
+    size_t class_start = 5;      // 类别分数起始列（无 objectness 时为 4）
+
+    bool hasObjectness() const { return class_start == 5; }
+    size_t classCount() const { return attr_count - class_start; }
+};
+
+// 按输出 shape 推断布局（与原解码逻辑一致：A=84 视为 yolo11/12 的 4+80 无 objectness 格式）
+YoloOutputLayout ResolveYoloOutputLayout(const std::vector<int64_t> &shape);
+
+// 反 letterbox 映射与过滤参数
+struct YoloDecodeParams {
+    float score_threshold = 0.5F;
+    float scale = 1.0F;
+    float pad_x = 0.0F;
+    float pad_y = 0.0F;
+    cv::Size original_size;
+    bool filter_edge_boxes = true;
+};
+
+// 按布局特化的 YOLO 输出解码器，结果与逐 anchor 的标量解码逐框一致：
+// - channels first：按类别行连续扫描，SIMD 维护每个 anchor 的最高分与类别
+// - 设置了关注类别时只扫描关注类别的分数，低于阈值的 anchor 直接淘汰；
+//   极少数幸存者再做一次全类别 argmax，确认最高类别确实属于关注类别
+// - anchor 数超过 parallel_min_anchors 时按 anchor 区间切分到多线程
+class YoloDecoder {
+public:
+    // 设置关注类别（空表示不过滤）
+    void setFocusClasses(const std::vector<int> &class_ids);
+    void setParallelMinAnchors(size_t anchors) { parallel_min_anchors_ = anchors; }
+    // 强制走标量路径（用于测试 SIMD 与标量结果一致）
+    void setUseSimd(bool enabled) { use_simd_ = enabled; }
+
+    // 解码结果按 anchor 顺序追加到 out
+    void decode(const float *data, const YoloOutputLayout &layout, const YoloDecodeParams &params,
+                std::vector<BBox> &out);
+
+private:
+    // 对 [begin, end) 区间的 anchor 解码，结果追加到 out
+    void decodeChannelsFirst(const float *data, const YoloOutputLayout &layout,
+                             const YoloDecodeParams &params, size_t begin, size_t end,
+                             std::vector<BBox> &out);
+    void decodeChannelsLast(const float *data, const YoloOutputLayout &layout,
+                            const YoloDecodeParams &params, size_t begin, size_t end,
+                            std::vector<BBox> &out) const;
+    // 对 count 个连续 anchor 执行 best = max(best, row[c])，并在严格大于时记录类别 c
+    void scanClassRow(const float *row, int cls, size_t count, float *best, int32_t *best_class) const;
+    // 确认幸存 anchor 的全类别最高分属于关注类别；通过时返回 true 并写出类别与分数
+    bool confirmFocus(const float *scores, size_t stride, size_t class_count,
+                      int &best_class, float &best_score) const;
+
+    bool use_simd_ = true;
+    size_t parallel_min_anchors_ = 4096;
+
+    bool focus_active_ = false;
+    std::vector<int> focus_classes_;     // 用户配置的关注类别（去重后）
+    std::vector<int> scan_classes_;      // 本次输出布局下实际要扫描的类别
+    std::vector<unsigned char> focus_mask_;  // 按类别索引的关注标记
+
+    // 复用的扫描缓冲（每个 anchor 一项，各线程只写自己的区间）
+    std::vector<float> best_score_;
+    std::vector<int32_t> best_class_;
+    std::vector<std::vector<BBox>> chunk_boxes_;
+};
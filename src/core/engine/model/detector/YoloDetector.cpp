@@ -1,12 +1,12 @@
 #include "YoloDetector.h"
 #include "IDetector.h"
+#include "TileLayout.h"
 #include "../OrtEnvSingleton.h"
+#include "../OrtIoBinding.h"
 
 #include <algorithm>
 #include <cmath>
-#include <cstring>
 #include <filesystem>
-#include <numeric>
 #include <stdexcept>
 
 // --------------------------
@@ -14,7 +14,6 @@
 // --------------------------
 YoloDetector::YoloDetector(const DetectorConfig &config)
     : config_(config),
-      focus_class_id_set_(),
       session_(nullptr) {
 
     // 1. 检查模型路径是否合法
@@ -23,14 +22,19 @@ YoloDetector::YoloDetector(const DetectorConfig &config)
         throw std::invalid_argument("YoloDetector: 模型路径为空");
     }
 
-    // 预处理关注类别列表（空列表表示不过滤）
-    // 这样在推理循环里就能用 O(1) 的 unordered_set 查找，避免每次遍历 vector。
-    if (!config_.focus_class_ids.empty()) {
-        focus_class_id_set_.reserve(config_.focus_class_ids.size());
-        for (int id : config_.focus_class_ids) {
-            focus_class_id_set_.insert(id);
-        }
-    }
+    // 关注类别交给解码器（空列表表示不过滤）：解码时只扫描这些类别的分数行
+    decoder_.setFocusClasses(config_.focus_class_ids);
+    decoder_.setParallelMinAnchors(static_cast<size_t>(std::max(0, config_.decode_parallel_min_anchors)));
+
+    nms_params_.method = config_.nms_method;
+    nms_params_.overlap_threshold = config_.nms_threshold;
+    nms_params_.use_iom = config_.nms_use_iom;
+    nms_params_.sigma = config_.nms_sigma;
+    nms_params_.min_score = config_.nms_min_score;
+    // 跨切片合并：被切缝截断的框是完整框的一部分，用 IoM 度量
+    merge_params_.method = NmsMethod::Merge;
+    merge_params_.use_iom = true;
+    merge_params_.overlap_threshold = config_.tiling.merge_threshold;
 
     if (!std::filesystem::exists(model_path)) {
         throw std::runtime_error("YoloDetector: 模型文件不存在 -> " + model_path);
@@ -39,320 +43,213 @@ YoloDetector::YoloDetector(const DetectorConfig &config)
     // 2. 创建 ONNX 运行时环境
     session_ = CreateSession(config.ort_env_config);
 
-    // 3. 获取输入形状、输入名、输出名
-    Ort::AllocatorWithDefaultOptions allocator;
-
-    // 获取输入 shape（模型要求的输入维度）
-    input_shape_ = session_->GetInputTypeInfo(0)
-                       .GetTensorTypeAndShapeInfo()
-                       .GetShape();
-
-    // 输入名
-    auto input_name_alloc = session_->GetInputNameAllocated(0, allocator);
-    input_name_ = input_name_alloc.get();
-
-    // 输出名（可能有多个输出）
-    const size_t output_count = session_->GetOutputCount();
-    output_names_.reserve(output_count);
-    for (size_t i = 0; i < output_count; ++i) {
-        auto name_alloc = session_->GetOutputNameAllocated(i, allocator);
-        output_names_.emplace_back(name_alloc.get());
-    }
+    // 3. 建立持久化的输入/输出绑定（输入名、输出名与 shape 均由绑定缓存从模型读取）
+    binding_ = std::make_unique<OrtIoBindingCache>(*session_);
+    input_shape_ = binding_->modelInputShape();
+
+    // ONNX 输入 shape：一般是 [1,3,H,W]，H/W 以配置为准；构造期就完成绑定，推理时不再分配
+    run_shape_ = input_shape_;
+    if (run_shape_.empty()) {
+        run_shape_ = {1, 3, config_.input_height, config_.input_width};
+    }
+    if (run_shape_.size() == 4) {
+        run_shape_[0] = 1;
+        run_shape_[1] = 3;
+        run_shape_[2] = config_.input_height;
+        run_shape_[3] = config_.input_width;
+    }
+    // 按上限尺寸先绑定一次：输入缓冲一次分配到位，矩形推理的较小 shape 只新增绑定、不再扩容
+    binding_->prepareInput(run_shape_);
+    // YOLO 检测头的输出 shape 只取决于输入 shape：动态输出在每种输入 shape 首次推理后改为预分配
+    binding_->setLearnOutputShapes(true);
+    rect_inference_ = config_.rect_inference && input_shape_.size() == 4 && run_shape_.size() == 4 &&
+                      input_shape_[2] <= 0 && input_shape_[3] <= 0;
+
+    // 区域检测：batch 维为动态时才能一次塞多个区域；H/W 为动态时使用较小的区域输入尺寸
+    model_batch_ = input_shape_.size() == 4 && input_shape_[0] > 0 ? input_shape_[0] : 0;
+    region_max_batch_ = model_batch_ > 0 ? static_cast<size_t>(model_batch_)
+                                         : static_cast<size_t>(std::max(1, config_.region_max_batch));
+    region_shape_ = run_shape_;
+    if (region_shape_.size() == 4 && input_shape_.size() == 4 && input_shape_[2] <= 0 && input_shape_[3] <= 0) {
+        const int64_t size = std::max(32, config_.region_input_size);
+        region_shape_[2] = size;
+        region_shape_[3] = size;
+    }
+    tile_shape_ = run_shape_;
 }
 
 // --------------------------
 //        预处理图像
 // --------------------------
-YoloDetector::PreprocessResult YoloDetector::preprocess(const cv::Mat &frame) const {
+YoloDetector::PreprocessResult YoloDetector::preprocess(const cv::Mat &frame) {
     if (frame.empty()) {
         throw std::invalid_argument("YoloDetector: 输入图像为空");
     }
 
-    // 原图尺寸
-    const int src_w = frame.cols;
-    const int src_h = frame.rows;
-
-    // YOLO 输入通常需要 Letterbox：等比例缩放 + 填充灰色
-    const float scale = std::min(
-        static_cast<float>(config_.input_width) / static_cast<float>(src_w),
-        static_cast<float>(config_.input_height) / static_cast<float>(src_h)
-    );
-
-    const int resize_w = static_cast<int>(std::round(src_w * scale));
-    const int resize_h = static_cast<int>(std::round(src_h * scale));
-
-    // 剩余部分需要 padding（左右和上下）
-    const int pad_x = (config_.input_width - resize_w) / 2;
-    const int pad_y = (config_.input_height - resize_h) / 2;
-
-    // 调整大小
-    cv::Mat resized;
-    cv::resize(frame, resized, cv::Size(resize_w, resize_h));
-
-    // Letterbox：创建 114 灰色背景
-    cv::Mat canvas(config_.input_height, config_.input_width, CV_8UC3, cv::Scalar(114, 114, 114));
-
-    // 把 resize 后的图写入正确的位置
-    resized.copyTo(canvas(cv::Rect(pad_x, pad_y, resize_w, resize_h)));
-
-    // OpenCV 是 BGR，而 ONNX 里的模型通常是 RGB
-    cv::cvtColor(canvas, canvas, cv::COLOR_BGR2RGB);
-
-    // 归一化：uint8 → float32 (0~1)
-    canvas.convertTo(canvas, CV_32F, 1.0 / 255.0);
+    // YOLO 输入通常需要 Letterbox：等比例缩放 + 填充灰色；
+    // 矩形推理时输入尺寸贴合源图宽高比（stride 对齐），只剩不足一个 stride 的填充
+    int dst_w = config_.input_width;
+    int dst_h = config_.input_height;
+    if (rect_inference_) {
+        const cv::Size rect = ComputeRectInputSize(frame.size(), dst_w, dst_h, config_.input_stride);
+        dst_w = rect.width;
+        dst_h = rect.height;
+        run_shape_[2] = dst_h;
+        run_shape_[3] = dst_w;
+    }
+    const LetterboxLayout layout = ComputeLetterboxLayout(frame.size(), dst_w, dst_h);
 
-    // 将 HWC → CHW
-    std::vector<cv::Mat> chw(3);
-    cv::split(canvas, chw);
+    // 融合内核一次完成 缩放 + 填充 + BGR->RGB + 归一化 + HWC->CHW，
+    // 直接写入已绑定的持久输入缓冲，不再生成 resized/canvas/float/split 等整图临时数据
+    float *input = binding_->prepareInput(run_shape_);
+    letterbox_.run(frame, layout, input);
 
-    // 塞进连续内存 (float 数组)
     PreprocessResult result;
-    result.tensor.resize(static_cast<size_t>(3 * config_.input_width * config_.input_height));
-    result.scale = scale;
-    result.pad_x = static_cast<float>(pad_x);
-    result.pad_y = static_cast<float>(pad_y);
-
-    const size_t channel_size = static_cast<size_t>(config_.input_width * config_.input_height);
-    for (int c = 0; c < 3; ++c) {
-        std::memcpy(
-            result.tensor.data() + c * channel_size,
-            chw[c].ptr<float>(),
-            channel_size * sizeof(float)
-        );
-    }
-
+    result.scale = layout.scale;
+    result.pad_x = static_cast<float>(layout.pad_x);
+    result.pad_y = static_cast<float>(layout.pad_y);
     return result;
 }
 
 // --------------------------
 //         推理（前向）
 // --------------------------
-std::vector<BBox>
-YoloDetector::runInference(const PreprocessResult &prep,
-                           const cv::Size &original_size) const {
+void YoloDetector::runInference(const PreprocessResult &prep, const cv::Size &original_size,
+                                std::vector<BBox> &out) {
     if (!session_) {
         throw std::runtime_error("YoloDetector: 推理会话尚未初始化");
     }
 
-    // ONNX 输入 shape：一般是 [1,3,H,W]
-    std::vector<int64_t> actual_shape = input_shape_;
-    if (actual_shape.empty()) {
-        actual_shape = {1, 3, config_.input_height, config_.input_width};
-    }
-    if (actual_shape.size() == 4) {
-        actual_shape[0] = 1;
-        actual_shape[1] = 3;
-        actual_shape[2] = config_.input_height;
-        actual_shape[3] = config_.input_width;
-    }
-
-    // 创建 ONNX Runtime 输入张量
-    Ort::MemoryInfo memory_info =
-        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
-
-    auto input_tensor = Ort::Value::CreateTensor<float>(
-        memory_info,
-        const_cast<float *>(prep.tensor.data()),
-        prep.tensor.size(),
-        actual_shape.data(),
-        actual_shape.size()
-    );
-
-    // 准备输入/输出名字
-    const char *input_names[] = {input_name_.c_str()};
-    std::vector<const char *> output_name_ptrs;
-    output_name_ptrs.reserve(output_names_.size());
-    for (const auto &name : output_names_) {
-        output_name_ptrs.push_back(name.c_str());
-    }
-
-    // 执行前向推理
-    auto output_tensors = session_->Run(
-        Ort::RunOptions{nullptr},
-        input_names, &input_tensor, 1,
-        output_name_ptrs.data(), output_name_ptrs.size()
-    );
+    // 执行前向推理（输入/输出都已通过 IoBinding 预先绑定）
+    binding_->run();
+    decodeOutput(0, prep, original_size, config_.filter_edge_boxes, out);
+}
 
-    if (output_tensors.empty()) {
+void YoloDetector::decodeOutput(size_t batch_index, const PreprocessResult &prep, const cv::Size &original_size,
+                                bool filter_edges, std::vector<BBox> &out) {
+    if (binding_->outputCount() == 0) {
         throw std::runtime_error("YoloDetector: 推理输出为空");
     }
 
     // YOLO 常用输出形状：
-    // [1, N, 85] 或 [1, 85, N] 或直接 [N,85]
-    const auto &output_tensor = output_tensors.front();
-    const auto type_info = output_tensor.GetTensorTypeAndShapeInfo();
-    std::vector<int64_t> shape = type_info.GetShape();
-    const float *data = output_tensor.GetTensorData<float>();
-
-    if (shape.size() < 2) {
-        throw std::runtime_error("YoloDetector: 不支持的输出维度");
-    }
-
-    size_t num_boxes = 0;
-    size_t attr_count = 0;
-    bool channels_first = false;
-
-    // YOLO 输出有可能是 [1, 85, 25200]（channels first）
-    // 或 [1, 25200, 85]（channels last）
+    // [B, N, 85] 或 [B, 85, N] 或直接 [N,85]
+    const std::vector<int64_t> &shape = binding_->outputShape(0);
+    const YoloOutputLayout layout = ResolveYoloOutputLayout(shape);
+    const float *data = binding_->outputData(0);
     if (shape.size() == 3) {
-        const int64_t dim1 = shape[1];
-        const int64_t dim2 = shape[2];
-
-        if (dim1 <= dim2) {
-            channels_first = true;
-            attr_count = static_cast<size_t>(dim1);
-            num_boxes = static_cast<size_t>(dim2);
-        } else {
-            channels_first = false;
-            attr_count = static_cast<size_t>(dim2);
-            num_boxes = static_cast<size_t>(dim1);
-        }
-    } else {
-        // 若是 [N,85]
-        channels_first = false;
-        num_boxes = static_cast<size_t>(shape[0]);
-        attr_count = static_cast<size_t>(shape[1]);
-    }
-
-    if (attr_count < 6) {
-        throw std::runtime_error("YoloDetector: 输出维度不足以解析检测框");
+        data += batch_index * layout.num_boxes * layout.attr_count;
     }
 
-    // 根据布局读取数据
-    auto value_at = [&](size_t box_idx, size_t attr_idx) -> float {
-        if (channels_first) {
-            return data[attr_idx * num_boxes + box_idx];
-        }
-        return data[box_idx * attr_count + attr_idx];
-    };
-
-    // ------------------------
-    //   解码 YOLO 输出
-    // ------------------------
-    std::vector<BBox> candidates;
-    candidates.reserve(num_boxes);
-
-    for (size_t i = 0; i < num_boxes; ++i) {
-        // 部分导出的 YOLO（如 yolo11/12）输出形状为 [batch, 84, 8400]，仅包含 4+80 项（无 obj）。
-        // 如果 attr_count==4+num_classes，则认为没有 objectness，直接将其视为 1；否则按常规位置读取。
-        const bool no_objectness = (attr_count == 84);  // 典型 coco 80 类：4+80
-        const size_t class_start = no_objectness ? 4 : 5;
-        const float objectness = no_objectness ? 1.0F : value_at(i, 4);
-
-        // 找最高类别分数
-        float best_class_score = 0.0F;
-        int best_class = -1;
-        for (size_t c = class_start; c < attr_count; ++c) {
-            const float cls_score = value_at(i, c);
-            if (cls_score > best_class_score) {
-                best_class_score = cls_score;
-                best_class = static_cast<int>(c - class_start);
-            }
-        }
-
-        // 最终置信度 = objectness * class_score
-        const float final_score = objectness * best_class_score;
-
-        if (final_score < config_.score_threshold) {
-            continue;  // 太小的框不要
-        }
-
-        // 按关注类别过滤（若 focus_class_id_set_ 为空，则表示不过滤）
-        if (!focus_class_id_set_.empty() &&
-            focus_class_id_set_.find(best_class) == focus_class_id_set_.end()) {
-            continue;
-        }
+    // 按布局特化解码（channels first 走 SIMD 类别行扫描，关注类别提前淘汰，大量 anchor 时多线程）
+    YoloDecodeParams params;
+    params.score_threshold = config_.score_threshold;
+    params.scale = prep.scale;
+    params.pad_x = prep.pad_x;
+    params.pad_y = prep.pad_y;
+    params.original_size = original_size;
+    params.filter_edge_boxes = filter_edges;
 
-        // cx, cy, w, h 是 YOLO 格式
-        const float cx = value_at(i, 0);
-        const float cy = value_at(i, 1);
-        const float w = value_at(i, 2);
-        const float h = value_at(i, 3);
-
-        // 反 letterbox 映射到原图
-        float x0 = (cx - w / 2.0F - prep.pad_x) / prep.scale;
-        float y0 = (cy - h / 2.0F - prep.pad_y) / prep.scale;
-        float x1 = (cx + w / 2.0F - prep.pad_x) / prep.scale;
-        float y1 = (cy + h / 2.0F - prep.pad_y) / prep.scale;
-
-        // 超出边界需要裁剪
-        x0 = std::clamp(x0, 0.0F, static_cast<float>(original_size.width));
-        y0 = std::clamp(y0, 0.0F, static_cast<float>(original_size.height));
-        x1 = std::clamp(x1, 0.0F, static_cast<float>(original_size.width));
-        y1 = std::clamp(y1, 0.0F, static_cast<float>(original_size.height));
-
-        // 可选过滤触边框（某边位于或超过画面边界）
-        if (config_.filter_edge_boxes) {
-            if (x0 <= 0.0F || y0 <= 0.0F ||
-                x1 >= static_cast<float>(original_size.width) ||
-                y1 >= static_cast<float>(original_size.height)) {
-                continue;
-            }
-        }
-
-        if (x1 <= x0 || y1 <= y0) {
-            continue;  // 非法框
-        }
-        // emplace_back: 将新元素直接构造到容器的末尾，避免拷贝或移动操作
-        // 这里是将一个 BBox 对象直接构造到 candidates 容器末尾
-        candidates.emplace_back(
-            cv::Rect2f(cv::Point2f(x0, y0), cv::Point2f(x1, y1)),
-            best_class,
-            final_score
-        );
-    }
+    candidates_.clear();
+    decoder_.decode(data, layout, params, candidates_);
 
-    // NMS 非极大值抑制
-    return applyNms(candidates, config_.nms_threshold);
+    // NMS 非极大值抑制（直接写入调用方的缓冲）
+    nms_.run(candidates_, nms_params_, out);
 }
 
 // --------------------------
-//           NMS
+//      对外 detect 接口
 // --------------------------
-std::vector<BBox>
-YoloDetector::applyNms(const std::vector<BBox> &boxes,
-                       float iou_threshold) {
-
-    // 排序：按 score 从大到小
-    std::vector<int> indices(boxes.size());
-    // 初始化索引数组为 [0, 1, 2, ..., n-1]
-    // 用于后续根据置信度对检测框进行排序时，保持原始索引关系
-    std::iota(indices.begin(), indices.end(), 0);
-
-    std::sort(indices.begin(), indices.end(), [&](int lhs, int rhs) {
-        return boxes[lhs].score > boxes[rhs].score;
-    });
+std::vector<BBox> YoloDetector::detect(const cv::Mat &frame, int frame_index) {
+    std::vector<BBox> boxes;
+    detect(frame, frame_index, boxes);
+    return boxes;
+}
 
-    std::vector<BBox> picked;
-    std::vector<bool> suppressed(boxes.size(), false);
+void YoloDetector::detect(const cv::Mat &frame, int frame_index, std::vector<BBox> &out) {
+    if (config_.tiling.enabled && tile_shape_.size() == 4) {
+        detectTiled(frame, out);
+        return;
+    }
+    auto prep = preprocess(frame);
+    runInference(prep, frame.size(), out);
+}
 
-    for (size_t i = 0; i < indices.size(); ++i) {
-        const int idx = indices[i];
-        if (suppressed[idx]) continue; // 已被抑制则跳过
+std::vector<std::vector<BBox>> YoloDetector::detectRegions(const cv::Mat &frame,
+                                                           const std::vector<cv::Rect> &regions,
+                                                           int frame_index) {
+    if (region_shape_.size() != 4) return IDetector::detectRegions(frame, regions, frame_index);
+    std::vector<std::vector<BBox>> results;
+    inferRegions(frame, regions, region_shape_, config_.filter_edge_boxes, results);
+    return results;
+}
 
-        picked.emplace_back(boxes[idx]);
+void YoloDetector::inferRegions(const cv::Mat &frame, const std::vector<cv::Rect> &regions,
+                                std::vector<int64_t> &shape, bool filter_edges,
+                                std::vector<std::vector<BBox>> &results) {
+    results.resize(regions.size());
+    if (regions.empty()) return;
+    if (frame.empty()) {
+        throw std::invalid_argument("YoloDetector: 输入图像为空");
+    }
 
-        // 对剩余框进行 IoU 判断
-        for (size_t j = i + 1; j < indices.size(); ++j) {
-            const int next_idx = indices[j];
-            if (suppressed[next_idx]) continue;
+    const int region_h = static_cast<int>(shape[2]);
+    const int region_w = static_cast<int>(shape[3]);
+    const size_t plane = static_cast<size_t>(3) * static_cast<size_t>(region_w) * static_cast<size_t>(region_h);
+    // 按 region_max_batch_ 分块：每块内的区域直接从原帧 letterbox 写入已绑定的输入缓冲，一次 Run 得到整块结果
+    for (size_t begin = 0; begin < regions.size(); begin += region_max_batch_) {
+        const size_t count = std::min(region_max_batch_, regions.size() - begin);
+        // 固定 batch 的模型必须按模型 batch 推理，多余的样本位保持上一次的数据即可（结果被丢弃）
+        shape[0] = model_batch_ > 0 ? model_batch_ : static_cast<int64_t>(count);
+        float *input = binding_->prepareInput(shape);
+
+        region_preps_.clear();
+        for (size_t k = 0; k < count; ++k) {
+            const cv::Mat patch = frame(regions[begin + k]);
+            const LetterboxLayout layout = ComputeLetterboxLayout(patch.size(), region_w, region_h);
+            letterbox_.run(patch, layout, input + k * plane);
+            region_preps_.push_back({layout.scale, static_cast<float>(layout.pad_x), static_cast<float>(layout.pad_y)});
+        }
 
-            // NMS 只抑制同类别框
-            if (boxes[idx].class_id != boxes[next_idx].class_id) continue;
+        binding_->run();
+        for (size_t k = 0; k < count; ++k) {
+            decodeOutput(k, region_preps_[k], regions[begin + k].size(), filter_edges, results[begin + k]);
+        }
+    }
+}
 
-            if ((boxes[idx] & boxes[next_idx]) > iou_threshold) {
-                suppressed[next_idx] = true;
+void YoloDetector::detectTiled(const cv::Mat &frame, std::vector<BBox> &out) {
+    if (frame.empty()) {
+        throw std::invalid_argument("YoloDetector: 输入图像为空");
+    }
+    // 切片只取决于帧尺寸，尺寸不变时复用
+    if (frame.size() != tile_frame_size_) {
+        tiles_ = ComputeTileGrid(frame.size(), config_.tiling);
+        if (config_.tiling.include_full_frame && tiles_.size() > 1) {
+            tiles_.emplace_back(0, 0, frame.cols, frame.rows);
+        }
+        tile_frame_size_ = frame.size();
+    }
+
+    // 切片内部的边不是画面边界：解码时保留贴边框（由合并 NMS 拼接），映射回原帧后再按画面边界过滤
+    inferRegions(frame, tiles_, tile_shape_, false, tile_boxes_);
+    const float width = static_cast<float>(frame.cols);
+    const float height = static_cast<float>(frame.rows);
+    tile_candidates_.clear();
+    for (size_t k = 0; k < tiles_.size(); ++k) {
+        for (BBox b : tile_boxes_[k]) {
+            b.box.x += static_cast<float>(tiles_[k].x);
+            b.box.y += static_cast<float>(tiles_[k].y);
+            if (config_.filter_edge_boxes &&
+                (b.box.x <= 0.0F || b.box.y <= 0.0F || b.box.br().x >= width || b.box.br().y >= height)) {
+                continue;
             }
+            tile_candidates_.push_back(b);
         }
     }
 
-    return picked;
+    nms_.run(tile_candidates_, merge_params_, out);
 }
 
-// --------------------------
-//      对外 detect 接口
-// --------------------------
-std::vector<BBox> YoloDetector::detect(const cv::Mat &frame, int frame_index) {
-    auto prep = preprocess(frame);
-    return runInference(prep, frame.size());
+size_t YoloDetector::bindingAllocationCount() const {
+    return binding_ ? binding_->allocationCount() : 0;
 }
@@ -3,10 +3,13 @@
 #include <onnxruntime_cxx_api.h>
 #include <opencv2/opencv.hpp>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 #include "IDetector.h"
+#include "LetterboxKernel.h"
+#include "YoloDecoder.h"
+#include "NmsEngine.h"
+#include "../OrtIoBinding.h"
 
 // YOLOv12n ONNX 推理封装，负责加载模型与输出检测结果
 class YoloDetector : public IDetector {
@@ -15,24 +18,55 @@ public:
     ~YoloDetector() override = default;
 
     std::vector<BBox> detect(const cv::Mat &frame, int frame_index) override;
+    // 解码与 NMS 都写入复用缓冲，结果直接写入 out：预热后整个调用不做堆分配（ORT Run 内部除外）
+    void detect(const cv::Mat &frame, int frame_index, std::vector<BBox> &out) override;
+    // 各区域直接从原帧 letterbox 写入同一个输入 batch，一次 Run 得到所有区域的检测结果
+    std::vector<std::vector<BBox>> detectRegions(const cv::Mat &frame, const std::vector<cv::Rect> &regions,
+                                                 int frame_index) override;
+
+    // ORT 绑定层的累计缓冲分配/张量创建/绑定次数（预热后应保持不变；不含返回值版本 detect 的结果容器）
+    size_t bindingAllocationCount() const;
+    // 是否启用矩形推理（配置开启且模型输入 H/W 为动态维度）
+    bool rectInference() const { return rect_inference_; }
 
 private:
     struct PreprocessResult {
-        std::vector<float> tensor;   // 按 NCHW 排列的输入张量
         float scale = 1.0F;          // letterbox 缩放比例
         float pad_x = 0.0F;          // x 方向填充像素
         float pad_y = 0.0F;          // y 方向填充像素
     };
 
-    PreprocessResult preprocess(const cv::Mat &frame) const;
-    std::vector<BBox> runInference(const PreprocessResult &prep, const cv::Size &original_size) const;
-    static std::vector<BBox> applyNms(const std::vector<BBox> &boxes, float iou_threshold);
+    // 预处理结果直接写入已绑定的输入缓冲（按 NCHW 排列），返回值只携带反映射参数
+    PreprocessResult preprocess(const cv::Mat &frame);
+    void runInference(const PreprocessResult &prep, const cv::Size &original_size, std::vector<BBox> &out);
+    // 对最近一次推理输出中第 batch_index 张图做解码 + NMS，结果写入 out（filter_edges 为 false 时保留贴边框）
+    void decodeOutput(size_t batch_index, const PreprocessResult &prep, const cv::Size &original_size,
+                      bool filter_edges, std::vector<BBox> &out);
+    // 把各区域 letterbox 进 shape（[B,3,H,W]，batch 维按实际数量填写）的输入 batch 并推理，结果为各区域局部坐标
+    void inferRegions(const cv::Mat &frame, const std::vector<cv::Rect> &regions, std::vector<int64_t> &shape,
+                      bool filter_edges, std::vector<std::vector<BBox>> &results);
+    // 切片检测：原生尺度的重叠切片（可附带整帧）合批推理，再用合并 NMS 拼接跨切缝的框
+    void detectTiled(const cv::Mat &frame, std::vector<BBox> &out);
 
     DetectorConfig config_;
-    // 关注类别过滤集合（从 config_.focus_class_ids 预处理而来；空集合表示不过滤）
-    std::unordered_set<int> focus_class_id_set_;
     std::unique_ptr<Ort::Session> session_;  // 推理会话实例
-    std::string input_name_;
-    std::vector<std::string> output_names_;
-    std::vector<int64_t> input_shape_;
+    std::unique_ptr<OrtIoBindingCache> binding_;  // 持久化输入/输出绑定（输入缓冲由融合 letterbox 内核原地写入）
+    std::vector<int64_t> input_shape_;       // 模型声明的输入 shape
+    std::vector<int64_t> run_shape_;         // 实际推理使用的输入 shape（矩形推理时 H/W 逐帧确定）
+    bool rect_inference_ = false;
+    std::vector<int64_t> region_shape_;      // detectRegions 的输入 shape（batch 维在推理时填写）
+    int64_t model_batch_ = 0;                // 模型固定的 batch（0 表示动态）
+    size_t region_max_batch_ = 1;
+    std::vector<PreprocessResult> region_preps_;
+    std::vector<int64_t> tile_shape_;        // 切片检测的输入 shape（与整帧输入同尺寸）
+    std::vector<cv::Rect> tiles_;
+    cv::Size tile_frame_size_;               // tiles_ 对应的帧尺寸
+    std::vector<std::vector<BBox>> tile_boxes_;
+    std::vector<BBox> tile_candidates_;      // 映射回原帧坐标、待跨切片合并的框
+    NmsParams merge_params_;
+    LetterboxKernel letterbox_;
+    YoloDecoder decoder_;                    // 输出解码（含关注类别过滤）
+    NmsEngine nms_;                          // 网格加速的同类别 NMS
+    NmsParams nms_params_;
+    std::vector<BBox> candidates_;           // 复用的解码结果缓冲
 };
@@ -1,64 +1,295 @@
 #include "Feature.h"
 
+#include <algorithm>
 #include <cmath>
-#include <numeric>
 #include <stdexcept>
 
+namespace {
+// 判定单位向量的范数容差（float 归一化后的误差远小于该值）
+constexpr float kUnitTolerance = 1e-5f;
+// int8 对称量化的最大码值
+constexpr float kInt8Max = 127.0f;
+}  // namespace
+
 Feature::Feature() = default;
 
-Feature::Feature(std::vector<float> values) : data_(std::move(values)) {}
+Feature::Feature(std::vector<float> values) : dim_(values.size()), data_(values.begin(), values.end()) {
+    refreshNorm();
+}
+
+Feature::Feature(const float *values, size_t dim) : dim_(dim), data_(values, values + dim) { refreshNorm(); }
+
+size_t Feature::size() const { return dim_; }
+
+size_t Feature::byteSize() const {
+    switch (storage_) {
+    case FeatureStorage::Float16: return dim_ * sizeof(uint16_t);
+    case FeatureStorage::Int8: return dim_ * sizeof(int8_t);
+    case FeatureStorage::Float32: break;
+    }
+    return dim_ * sizeof(float);
+}
+
+const float *Feature::data() const {
+    ensure_float32();
+    return data_.data();
+}
+
+void Feature::copyTo(float *out) const {
+    switch (storage_) {
+    case FeatureStorage::Float32:
+        std::copy(data_.begin(), data_.end(), out);
+        break;
+    case FeatureStorage::Float16:
+        for (size_t i = 0; i < dim_; ++i) out[i] = simd::HalfToFloat(halfCodes()[i]);
+        break;
+    case FeatureStorage::Int8:
+        for (size_t i = 0; i < dim_; ++i) out[i] = static_cast<float>(int8Codes()[i]) * scale_;
+        break;
+    }
+}
+
+float Feature::valueAt(size_t i) const {
+    switch (storage_) {
+    case FeatureStorage::Float16: return simd::HalfToFloat(halfCodes()[i]);
+    case FeatureStorage::Int8: return static_cast<float>(int8Codes()[i]) * scale_;
+    case FeatureStorage::Float32: break;
+    }
+    return data_[i];
+}
+
+template <typename ValueAt>
+void Feature::encode(ValueAt &&at, float factor) {
+    // 调用方允许 at(i) 读取当前存储：每个位置都先读后写，scale_ 在写完后才更新
+    switch (storage_) {
+    case FeatureStorage::Float32:
+        data_.resize(dim_);
+        for (size_t i = 0; i < dim_; ++i) data_[i] = at(i) * factor;
+        break;
+    case FeatureStorage::Float16: {
+        codes_.resize(dim_ * sizeof(uint16_t));
+        auto *codes = reinterpret_cast<uint16_t *>(codes_.data());
+        for (size_t i = 0; i < dim_; ++i) codes[i] = simd::FloatToHalf(at(i) * factor);
+        break;
+    }
+    case FeatureStorage::Int8: {
+        float max_abs = 0.0f;
+        for (size_t i = 0; i < dim_; ++i) max_abs = std::max(max_abs, std::fabs(at(i)));
+        codes_.resize(dim_);
+        auto *codes = reinterpret_cast<int8_t *>(codes_.data());
+        if (max_abs <= 0.0f) {
+            std::fill(codes, codes + dim_, int8_t{0});
+            scale_ = 1.0f;
+            break;
+        }
+        // 码值与整体缩放无关，factor 只体现在 scale 上
+        const float inv = kInt8Max / max_abs;
+        for (size_t i = 0; i < dim_; ++i) codes[i] = static_cast<int8_t>(std::lround(at(i) * inv));
+        scale_ = max_abs / kInt8Max * factor;
+        break;
+    }
+    }
+}
+
+void Feature::convertTo(FeatureStorage storage) {
+    if (storage == storage_) return;
+    // 经由新对象转换，原先那份存储随之释放
+    Feature converted;
+    converted.assignConverted(*this, storage);
+    *this = std::move(converted);
+}
 
-size_t Feature::size() const { return data_.size(); }
+void Feature::assignConverted(const Feature &src, FeatureStorage storage) {
+    dim_ = src.dim_;
+    storage_ = storage;
+    if (storage_ == FeatureStorage::Float32) {
+        codes_.clear();
+    } else {
+        data_.clear();
+    }
+    encode([&src](size_t i) { return src.valueAt(i); }, 1.0f);
+    refreshNorm();
+}
 
-float Feature::l2norm() const {
-    float sum = std::inner_product(data_.begin(), data_.end(), data_.begin(), 0.0f);
-    return std::sqrt(sum);
+void Feature::assignConverted(std::span<const float> src, FeatureStorage storage) {
+    dim_ = src.size();
+    storage_ = storage;
+    if (storage_ == FeatureStorage::Float32) {
+        codes_.clear();
+    } else {
+        data_.clear();
+    }
+    encode([src](size_t i) { return src[i]; }, 1.0f);
+    refreshNorm();
 }
 
+float Feature::l2norm() const { return norm_; }
+
+bool Feature::isUnit() const { return std::fabs(norm_ - 1.0f) < kUnitTolerance; }
+
 Feature Feature::normalized() const {
-    float n = l2norm();
-    if (n < 1e-12f) {
+    Feature out(*this);
+    out.normalize();
+    return out;
+}
+
+void Feature::normalize() {
+    if (norm_ < 1e-12f) {
         throw std::runtime_error("零向量无法归一化");
     }
-    std::vector<float> out(data_);
-    for (auto &v : out) v /= n;
-    return Feature(std::move(out));
+    if (isUnit()) return;
+    switch (storage_) {
+    case FeatureStorage::Float32:
+        simd::Scale(data_.data(), 1.0f / norm_, dim_);
+        break;
+    case FeatureStorage::Int8:
+        // 只需调整 scale，码值不变
+        scale_ /= norm_;
+        break;
+    case FeatureStorage::Float16:
+        encode([this](size_t i) { return simd::HalfToFloat(halfCodes()[i]); }, 1.0f / norm_);
+        break;
+    }
+    refreshNorm();
 }
 
 float Feature::dot(const Feature &other) const {
     ensure_same_dim(other);
+    if (storage_ == other.storage_) {
+        switch (storage_) {
+        case FeatureStorage::Float32:
+            if (dim_ == kOsnetFeatureDim) {
+                return simd::DotN<kOsnetFeatureDim>(data_.data(), other.data_.data());
+            }
+            return simd::Dot(data_.data(), other.data_.data(), dim_);
+        case FeatureStorage::Float16:
+            return simd::DotHalf(halfCodes(), other.halfCodes(), dim_);
+        case FeatureStorage::Int8:
+            return static_cast<float>(simd::DotInt8(int8Codes(), other.int8Codes(), dim_)) * scale_ * other.scale_;
+        }
+    }
+    // 精度不同：逐元素解码
     float s = 0.0f;
-    for (size_t i = 0; i < data_.size(); ++i) s += data_[i] * other.data_[i];
+    for (size_t i = 0; i < dim_; ++i) s += valueAt(i) * other.valueAt(i);
     return s;
 }
 
 float Feature::cosine_similarity(const Feature &other) const {
-    float denom = l2norm() * other.l2norm();
+    float denom = norm_ * other.norm_;
     if (denom < 1e-12f) {
         throw std::runtime_error("余弦相似度计算时范数为零");
     }
-    return dot(other) / denom;
+    const float d = dot(other);
+    return isUnit() && other.isUnit() ? d : d / denom;
+}
+
+template <typename ValueAt>
+void Feature::blendEncoded(ValueAt &&obs_at, float alpha) {
+    // 量化存储：第一遍求融合结果的范数，第二遍融合并按当前精度重新编码（不需要临时向量）
+    const float beta = 1.0f - alpha;
+    auto blended = [&](size_t i) { return alpha * obs_at(i) + beta * valueAt(i); };
+    float sq = 0.0f;
+    for (size_t i = 0; i < dim_; ++i) {
+        const float v = blended(i);
+        sq += v * v;
+    }
+    const float n = std::sqrt(sq);
+    if (n < 1e-12f) {
+        throw std::runtime_error("零向量无法归一化");
+    }
+    encode(blended, 1.0f / n);
+    refreshNorm();
+}
+
+void Feature::emaUpdate(const Feature &observation, float alpha) {
+    ensure_same_dim(observation);
+    if (storage_ == FeatureStorage::Float32 && observation.storage_ == FeatureStorage::Float32) {
+        const float sq = simd::BlendSquaredNorm(data_.data(), observation.data_.data(), alpha, dim_);
+        const float n = std::sqrt(sq);
+        if (n < 1e-12f) {
+            throw std::runtime_error("零向量无法归一化");
+        }
+        simd::Scale(data_.data(), 1.0f / n, dim_);
+        refreshNorm();
+        return;
+    }
+
+    blendEncoded([&observation](size_t i) { return observation.valueAt(i); }, alpha);
+}
+
+void Feature::emaUpdate(std::span<const float> observation, float alpha) {
+    if (observation.size() != dim_) {
+        throw std::runtime_error("特征维度不一致");
+    }
+    if (storage_ == FeatureStorage::Float32) {
+        const float sq = simd::BlendSquaredNorm(data_.data(), observation.data(), alpha, dim_);
+        const float n = std::sqrt(sq);
+        if (n < 1e-12f) {
+            throw std::runtime_error("零向量无法归一化");
+        }
+        simd::Scale(data_.data(), 1.0f / n, dim_);
+        refreshNorm();
+        return;
+    }
+    blendEncoded([observation](size_t i) { return observation[i]; }, alpha);
 }
 
 Feature Feature::operator+(const Feature &other) const {
     ensure_same_dim(other);
-    std::vector<float> out(data_.size());
-    for (size_t i = 0; i < data_.size(); ++i) out[i] = data_[i] + other.data_[i];
-    return Feature(std::move(out));
+    Feature out;
+    out.dim_ = dim_;
+    out.data_.resize(dim_);
+    for (size_t i = 0; i < dim_; ++i) out.data_[i] = valueAt(i) + other.valueAt(i);
+    out.refreshNorm();
+    return out;
 }
 
 Feature Feature::operator*(float scalar) const {
-    std::vector<float> out(data_.size());
-    for (size_t i = 0; i < data_.size(); ++i) out[i] = data_[i] * scalar;
-    return Feature(std::move(out));
+    Feature out(*this);
+    switch (out.storage_) {
+    case FeatureStorage::Float32:
+        simd::Scale(out.data_.data(), scalar, dim_);
+        break;
+    case FeatureStorage::Int8:
+        out.scale_ *= scalar;
+        break;
+    case FeatureStorage::Float16:
+        out.encode([&out](size_t i) { return simd::HalfToFloat(out.halfCodes()[i]); }, scalar);
+        break;
+    }
+    out.refreshNorm();
+    return out;
 }
 
 Feature operator*(float scalar, const Feature &feat) { return feat * scalar; }
 
-const std::vector<float> &Feature::values() const { return data_; }
+std::span<const float> Feature::values() const {
+    ensure_float32();
+    return {data_.data(), data_.size()};
+}
 
 void Feature::ensure_same_dim(const Feature &other) const {
-    if (data_.size() != other.data_.size()) {
+    if (dim_ != other.dim_) {
         throw std::runtime_error("特征维度不一致");
     }
 }
+
+void Feature::ensure_float32() const {
+    if (storage_ != FeatureStorage::Float32) {
+        throw std::runtime_error("特征不是 float32 存储");
+    }
+}
+
+void Feature::refreshNorm() {
+    switch (storage_) {
+    case FeatureStorage::Float32:
+        norm_ = std::sqrt(simd::Dot(data_.data(), data_.data(), dim_));
+        break;
+    case FeatureStorage::Float16:
+        norm_ = std::sqrt(simd::DotHalf(halfCodes(), halfCodes(), dim_));
+        break;
+    case FeatureStorage::Int8:
+        norm_ = std::sqrt(static_cast<float>(simd::DotInt8(int8Codes(), int8Codes(), dim_))) * std::fabs(scale_);
+        break;
+    }
+}
@@ -1,20 +1,70 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
-// 特征向量封装，提供归一化、相似度与基础算子
+#include "core/memory/AlignedAllocator.h"
+#include "core/simd/VectorKernels.h"
+
+// OSNet 等常用 ReID 模型的嵌入维度，Float32 存储时点积对该维度走编译期展开的内核（simd::DotN）
+constexpr size_t kOsnetFeatureDim = 512;
+
+// 特征的存储精度：
+// - Float32：原始精度
+// - Float16：IEEE 半精度，内存减半，相似度误差约 1e-3 量级
+// - Int8：对称量化，每个向量一个 scale（value = code * scale），内存为 1/4，相似度走整数 SIMD 点积
+enum class FeatureStorage { Float32 = 0, Float16 = 1, Int8 = 2 };
+
+// 特征向量封装（运行期维度），提供归一化、相似度与基础算子
+// - 数据 64 字节对齐，点积走 SIMD 内核
+// - L2 范数在构造/修改时计算并缓存；两侧都为单位向量时余弦直接等于点积
+// - 可就地转换为 Float16/Int8 存储，相似度与 EMA 直接在量化表示上计算（范数取量化后的值）；
+//   两侧精度不同时退化为逐元素标量路径
 class Feature {
 public:
+    using Storage = std::vector<float, AlignedAllocator<float, 64>>;
+    using CodeStorage = std::vector<std::byte, AlignedAllocator<std::byte, 64>>;
+
     Feature();
     explicit Feature(std::vector<float> values);
+    Feature(const float *values, size_t dim);
 
     size_t size() const;
+    FeatureStorage storage() const { return storage_; }
+    // 元素数据占用的字节数
+    size_t byteSize() const;
+    // Float32 存储时的原始数据；量化存储时抛异常（请使用 copyTo）
+    const float *data() const;
+    // 解码为单精度写入 out（长度为 size()）
+    void copyTo(float *out) const;
+    // 就地转换存储精度（量化是有损的，转回 Float32 不会恢复精度）
+    void convertTo(FeatureStorage storage);
+    // 以指定精度写入 src 的内容，复用自身已有的缓冲容量（src 不能是自身）
+    void assignConverted(const Feature &src, FeatureStorage storage);
+    // 同上，源为单精度数组（长度即维度）
+    void assignConverted(std::span<const float> src, FeatureStorage storage);
+
+    // 缓存的 L2 范数
     float l2norm() const;
+    // 范数与 1 的偏差在容差内（视为单位向量）
+    bool isUnit() const;
     Feature normalized() const;
+    // 就地归一化
+    void normalize();
     float dot(const Feature &other) const;
     float cosine_similarity(const Feature &other) const;
 
+    // 就地滑动平均并重新归一化：this = normalize(alpha * observation + (1 - alpha) * this)，结果保持当前存储精度
+    void emaUpdate(const Feature &observation, float alpha);
+    // 同上，观测为单精度数组（长度须与 size() 一致）
+    void emaUpdate(std::span<const float> observation, float alpha);
+
     // 逐元素相加
     Feature operator+(const Feature &other) const;
     // 特征与标量相乘
@@ -22,9 +72,91 @@ public:
     // 允许标量在左侧
     friend Feature operator*(float scalar, const Feature &feat);
 
-    const std::vector<float> &values() const;
+    // Float32 存储时的原始数据；量化存储时抛异常
+    std::span<const float> values() const;
 
 private:
     void ensure_same_dim(const Feature &other) const;
-    std::vector<float> data_;
+    void ensure_float32() const;
+    void refreshNorm();
+    // 第 i 个元素解码后的值（标量路径）
+    float valueAt(size_t i) const;
+    // 把按 at(i) 给出的 size() 个值（再乘以 factor）写入当前存储精度
+    template <typename ValueAt>
+    void encode(ValueAt &&at, float factor);
+    // 量化存储的 EMA：按 obs_at(i) 给出的观测值融合后按当前精度重新编码
+    template <typename ValueAt>
+    void blendEncoded(ValueAt &&obs_at, float alpha);
+
+    const int8_t *int8Codes() const { return reinterpret_cast<const int8_t *>(codes_.data()); }
+    const uint16_t *halfCodes() const { return reinterpret_cast<const uint16_t *>(codes_.data()); }
+
+    FeatureStorage storage_ = FeatureStorage::Float32;
+    size_t dim_ = 0;
+    float scale_ = 1.0f;  // Int8 的反量化系数
+    float norm_ = 0.0f;
+    Storage data_;        // Float32 存储
+    CodeStorage codes_;   // Float16 / Int8 存储
+};
+
+// 编译期维度的特征向量：64 字节对齐的定长数组，不变式为“单位范数”（默认构造为零向量），
+// 因此余弦相似度就是一次定长 SIMD 点积。
+template <size_t Dim>
+class alignas(64) FixedFeature {
+public:
+    static_assert(Dim > 0, "特征维度必须为正");
+    static constexpr size_t kDim = Dim;
+
+    FixedFeature() = default;
+    // 从运行期特征转换并归一化；维度不一致或为零向量时抛异常
+    explicit FixedFeature(const Feature &feat) {
+        if (feat.size() != Dim) {
+            throw std::runtime_error("特征维度不一致");
+        }
+        const float n = feat.l2norm();
+        if (n < 1e-12f) {
+            throw std::runtime_error("零向量无法归一化");
+        }
+        feat.copyTo(data_.data());
+        scale(1.0f / n);
+    }
+    // 从单精度数组拷贝并归一化；长度不一致或为零向量时抛异常
+    explicit FixedFeature(std::span<const float> values) {
+        if (values.size() != Dim) {
+            throw std::runtime_error("特征维度不一致");
+        }
+        std::copy(values.begin(), values.end(), data_.begin());
+        const float n = std::sqrt(simd::DotN<Dim>(data_.data(), data_.data()));
+        if (n < 1e-12f) {
+            throw std::runtime_error("零向量无法归一化");
+        }
+        scale(1.0f / n);
+    }
+
+    constexpr size_t size() const { return Dim; }
+    const float *data() const { return data_.data(); }
+
+    float dot(const FixedFeature &other) const { return simd::DotN<Dim>(data_.data(), other.data_.data()); }
+    float cosine_similarity(const FixedFeature &other) const { return dot(other); }
+
+    // 就地滑动平均并重新归一化，保持单位范数不变式
+    void emaUpdate(const FixedFeature &observation, float alpha) {
+        const float sq = simd::BlendSquaredNorm(data_.data(), observation.data_.data(), alpha, Dim);
+        if (sq < 1e-24f) {
+            throw std::runtime_error("零向量无法归一化");
+        }
+        scale(1.0f / std::sqrt(sq));
+    }
+
+    Feature toFeature() const { return Feature(data_.data(), Dim); }
+
+private:
+    // 定长循环由编译器自动向量化；simd::Scale 在 Dim 为编译期常量时会被 GCC 误报尾循环越界
+    void scale(float s) {
+        for (float &v : data_) v *= s;
+    }
+
+    std::array<float, Dim> data_{};
 };
+
+using OsnetFeature = FixedFeature<kOsnetFeatureDim>;
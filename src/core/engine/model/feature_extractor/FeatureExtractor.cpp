@@ -1,7 +1,11 @@
 #include "FeatureExtractor.h"
-#include "Feature.h"
+#include "core/simd/VectorKernels.h"
+#include "../OrtIoBinding.h"
 #include <onnxruntime_cxx_api.h>
 #include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 
 // OSNet-ONNX 特征提取器实现，输出 L2 归一化向量
@@ -21,71 +25,141 @@ FeatureExtractor::FeatureExtractor(const FeatureExtractorConfig &cfg)
   // 2. 初始化ort环境
   session_ = CreateSession(cfg.ort_env_config);
 
-  Ort::AllocatorWithDefaultOptions allocator;
-  input_name_ = session_->GetInputNameAllocated(0, allocator).get();
-  output_name_ = session_->GetOutputNameAllocated(0, allocator).get();
-
-  input_shape_ =
-      session_->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+  // 3. 建立持久化的输入/输出绑定
+  binding_ = std::make_unique<OrtIoBindingCache>(*session_);
+  input_shape_ = binding_->modelInputShape();
   if (input_shape_.size() != 4) {
     throw std::runtime_error("FeatureExtractor: 输入形状不是 NCHW");
   }
-  // 用模型配置覆盖 H/W，保持 batch=1、channel=3
+  // batch 维为动态（-1）时才能一次塞多个 patch；固定 batch 时按模型值分块
+  model_batch_ = input_shape_[0];
+  max_batch_ = model_batch_ > 0
+                   ? static_cast<size_t>(model_batch_)
+                   : static_cast<size_t>(std::max(1, config_.max_batch_size));
+
+  // 用模型配置覆盖 H/W，保持 channel=3；batch 维在推理时按实际数量填写
   input_shape_[0] = 1;
   input_shape_[2] = config_.input_height;
   input_shape_[3] = config_.input_width;
+
+  // 4. 预热：先按最大分块绑定（缓冲一次分配到位），再为每种可能的 batch 建好绑定，
+  //    之后任意数量的 extract/extractBatch 都不再分配推理缓冲
+  const size_t warm_begin = model_batch_ > 0 ? max_batch_ : 1;
+  for (size_t b = max_batch_; b >= warm_begin; --b) {
+    input_shape_[0] = static_cast<int64_t>(b);
+    binding_->prepareInput(input_shape_);
+  }
+  input_shape_[0] = 1;
 }
 
 
-std::vector<float> FeatureExtractor::extract(const cv::Mat &patch) {
+void FeatureExtractor::fillInput(const cv::Mat &patch, float *dst) {
     if (patch.empty()) {
         throw std::invalid_argument("FeatureExtractor: 输入图像为空");
     }
-    
-    cv::Mat resized;
-    cv::resize(patch, resized,
-                cv::Size(config_.input_width, config_.input_height));
-    cv::cvtColor(resized, resized, cv::COLOR_BGR2RGB);
-    resized.convertTo(resized, CV_32F, 1.0 / 255.0);
-    
-    // ImageNet 均值方差归一化
-    const cv::Scalar mean(0.485f, 0.456f, 0.406f);
-    const cv::Scalar std(0.229f, 0.224f, 0.225f);
-    cv::Mat normalized;
-    cv::subtract(resized, mean, normalized);
-    cv::divide(normalized, std, normalized);
-    
-    std::vector<cv::Mat> chw(3);
-    cv::split(normalized, chw);
-    std::vector<float> input_tensor(3 * config_.input_height * config_.input_width);
+    if (patch.type() != CV_8UC3) {
+        throw std::invalid_argument("FeatureExtractor: 仅支持 8UC3 (BGR) 输入");
+    }
+
+    cv::resize(patch, resized_,
+               cv::Size(config_.input_width, config_.input_height));
+
+    // 一次遍历完成 BGR->RGB、/255、ImageNet 均值方差归一化以及 HWC->CHW，
+    // 避免 cvtColor/convertTo/subtract/divide/split 各自生成一份整图临时数据
+    const float kMean[3] = {0.485f, 0.456f, 0.406f};  // RGB 顺序
+    const float kStd[3] = {0.229f, 0.224f, 0.225f};
     const size_t channel_size =
         static_cast<size_t>(config_.input_height * config_.input_width);
-    for (int c = 0; c < 3; ++c) {
-        std::memcpy(input_tensor.data() + c * channel_size, chw[c].ptr<float>(),
-                    channel_size * sizeof(float));
+    float *plane_r = dst;
+    float *plane_g = dst + channel_size;
+    float *plane_b = dst + 2 * channel_size;
+    size_t idx = 0;
+    for (int y = 0; y < resized_.rows; ++y) {
+        const uchar *row = resized_.ptr<uchar>(y);
+        for (int x = 0; x < resized_.cols; ++x, ++idx) {
+            const uchar *px = row + 3 * x;  // BGR
+            plane_r[idx] = (static_cast<float>(px[2]) * (1.0f / 255.0f) - kMean[0]) / kStd[0];
+            plane_g[idx] = (static_cast<float>(px[1]) * (1.0f / 255.0f) - kMean[1]) / kStd[1];
+            plane_b[idx] = (static_cast<float>(px[0]) * (1.0f / 255.0f) - kMean[2]) / kStd[2];
+        }
     }
-    
-    Ort::MemoryInfo memory_info =
-        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
-    Ort::Value input = Ort::Value::CreateTensor<float>(
-        memory_info, input_tensor.data(), input_tensor.size(),
-        input_shape_.data(), input_shape_.size());
-    
-    const char *input_names[] = {input_name_.c_str()};
-    const char *output_names[] = {output_name_.c_str()};
-    auto outputs = session_->Run(Ort::RunOptions{nullptr}, input_names, &input, 1,
-                                output_names, 1);
-    if (outputs.empty()) {
+}
+
+float *FeatureExtractor::prepareBatch(size_t batch) {
+    // 固定 batch 的模型必须按模型 batch 推理，多余的样本位保持上一次的数据即可（结果被丢弃）
+    input_shape_[0] = static_cast<int64_t>(model_batch_ > 0 ? static_cast<size_t>(model_batch_) : batch);
+    return binding_->prepareInput(input_shape_);
+}
+
+size_t FeatureExtractor::runBatch(size_t batch, std::vector<float> &out) {
+    binding_->run();
+    if (binding_->outputCount() == 0) {
         throw std::runtime_error("FeatureExtractor: 推理输出为空");
     }
-    
-    const auto &out_tensor = outputs.front();
-    const float *out_data = out_tensor.GetTensorData<float>();
-    const auto out_shape = out_tensor.GetTensorTypeAndShapeInfo().GetShape();
+
+    const float *out_data = binding_->outputData(0);
+    const auto &out_shape = binding_->outputShape(0);
     if (out_shape.size() < 2) {
         throw std::runtime_error("FeatureExtractor: 输出形状不正确");
     }
     const size_t feat_dim = static_cast<size_t>(out_shape.back());
-    Feature feat(std::vector<float>(out_data, out_data + feat_dim));
-    return feat.normalized().values();
+    const size_t offset = out.size();
+    out.resize(offset + batch * feat_dim);
+    for (size_t b = 0; b < batch; ++b) {
+        // 拷贝进输出行后就地归一化，不再经过临时 Feature
+        float *feat = out.data() + offset + b * feat_dim;
+        std::copy(out_data + b * feat_dim, out_data + (b + 1) * feat_dim, feat);
+        const float norm = std::sqrt(simd::Dot(feat, feat, feat_dim));
+        if (norm < 1e-12f) {
+            throw std::runtime_error("FeatureExtractor: 零向量无法归一化");
+        }
+        simd::Scale(feat, 1.0f / norm, feat_dim);
+    }
+    return feat_dim;
+}
+
+std::vector<float> FeatureExtractor::extract(const cv::Mat &patch) {
+    fillInput(patch, prepareBatch(1));
+
+    std::vector<float> feat;
+    runBatch(1, feat);
+    return feat;
+}
+
+std::vector<std::vector<float>> FeatureExtractor::extractBatch(const cv::Mat &frame,
+                                                               const std::vector<cv::Rect> &rois) {
+    std::vector<float> flat;
+    const size_t dim = extractBatch(frame, rois, flat);
+    std::vector<std::vector<float>> feats;
+    feats.reserve(rois.size());
+    for (size_t k = 0; k < rois.size(); ++k) {
+        feats.emplace_back(flat.begin() + static_cast<std::ptrdiff_t>(k * dim),
+                           flat.begin() + static_cast<std::ptrdiff_t>((k + 1) * dim));
+    }
+    return feats;
+}
+
+size_t FeatureExtractor::extractBatch(const cv::Mat &frame, const std::vector<cv::Rect> &rois,
+                                      std::vector<float> &out) {
+    out.clear();
+    if (rois.empty()) return 0;
+
+    const size_t sample_size =
+        static_cast<size_t>(3 * config_.input_height * config_.input_width);
+
+    // 按 max_batch_ 分块：每块内的 patch 直接从原帧 ROI 缩放写入已绑定的输入缓冲，一次 Run 得到整块特征
+    size_t dim = 0;
+    for (size_t begin = 0; begin < rois.size(); begin += max_batch_) {
+        const size_t count = std::min(max_batch_, rois.size() - begin);
+        float *input = prepareBatch(count);
+        for (size_t i = 0; i < count; ++i) {
+            fillInput(frame(rois[begin + i]), input + i * sample_size);
+        }
+        dim = runBatch(count, out);
+    }
+    return dim;
+}
+
+size_t FeatureExtractor::bindingAllocationCount() const {
+    return binding_ ? binding_->allocationCount() : 0;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IFeatureExtractor.h"
+#include "../OrtIoBinding.h"
 
 #include <onnxruntime_cxx_api.h>
 #include <opencv2/imgproc.hpp>
@@ -12,12 +13,29 @@
 class FeatureExtractor : public IFeatureExtractor {
 public:
     FeatureExtractor(const FeatureExtractorConfig &cfg);
-    std::vector<float> extract(const cv::Mat &patch);
+    std::vector<float> extract(const cv::Mat &patch) override;
+    // 一次推理处理多个裁剪框（动态 batch），超过 max_batch_size 时自动分块
+    std::vector<std::vector<float>> extractBatch(const cv::Mat &frame, const std::vector<cv::Rect> &rois) override;
+    // 特征直接归一化写入 out：out 容量足够后（预热之后）整个调用不做堆分配（ORT Run 内部除外）
+    size_t extractBatch(const cv::Mat &frame, const std::vector<cv::Rect> &rois, std::vector<float> &out) override;
+
+    // ORT 绑定层的累计缓冲分配/张量创建/绑定次数（构造期预热后应保持不变；
+    // 返回值版本的 extract/extractBatch 仍为每个特征分配一次，原地输出版本不分配）
+    size_t bindingAllocationCount() const;
 
 private:
+    // 将单个 patch 缩放、归一化后按 CHW 写入 dst（dst 需容纳 3*H*W 个 float）
+    void fillInput(const cv::Mat &patch, float *dst);
+    // 切换到 batch 个样本对应的绑定，返回可直接写入的输入缓冲
+    float *prepareBatch(size_t batch);
+    // 对输入缓冲中前 batch 个样本做推理，把 L2 归一化后的特征按行追加到 out（直接在 out 上归一化），返回特征维度
+    size_t runBatch(size_t batch, std::vector<float> &out);
+
     FeatureExtractorConfig config_;
     std::unique_ptr<Ort::Session> session_;
-    std::string input_name_;
-    std::string output_name_;
+    std::unique_ptr<OrtIoBindingCache> binding_;  // 持久化输入/输出绑定（按 batch 数预热）
     std::vector<int64_t> input_shape_;
-};
\ No newline at end of file
+    int64_t model_batch_ = 1;          // 模型声明的 batch 维（<=0 表示动态）
+    size_t max_batch_ = 1;             // 实际使用的分块大小
+    cv::Mat resized_;                  // 复用的缩放缓冲
+};
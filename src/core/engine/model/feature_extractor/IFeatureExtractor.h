@@ -8,6 +8,9 @@
 struct FeatureExtractorConfig {
     int input_height = 256;     // 模型期望的输入高度
     int input_width = 128;      // 模型期望的输入宽度
+    // extractBatch 单次推理的最大 batch；超出部分自动分块。
+    // 若模型 batch 维是固定值，则以模型为准。
+    int max_batch_size = 16;
     
     OrtEnvConfig ort_env_config;
 };
@@ -20,4 +23,24 @@ public:
 
     // 从输入图像提取归一化后的特征向量
     virtual std::vector<float> extract(const cv::Mat &patch) = 0;
+
+    // 从同一帧中按 rois 批量提取特征，返回值与 rois 一一对应。
+    // 默认实现逐个调用 extract；支持批推理的实现应覆盖它。
+    virtual std::vector<std::vector<float>> extractBatch(const cv::Mat &frame, const std::vector<cv::Rect> &rois) {
+        std::vector<std::vector<float>> feats;
+        feats.reserve(rois.size());
+        for (const auto &roi : rois) {
+            feats.push_back(extract(frame(roi)));
+        }
+        return feats;
+    }
+
+    // 同上，特征按行写入调用方持有、帧间复用的 out（第 k 行为 rois[k] 的特征，先清空，保留容量），
+    // 返回特征维度（rois 为空时为 0）。默认实现转调返回值版本；支持原地输出的实现应覆盖它
+    virtual size_t extractBatch(const cv::Mat &frame, const std::vector<cv::Rect> &rois, std::vector<float> &out) {
+        out.clear();
+        const auto feats = extractBatch(frame, rois);
+        for (const auto &feat : feats) out.insert(out.end(), feat.begin(), feat.end());
+        return feats.empty() ? 0 : feats.front().size();
+    }
 };
@@ -0,0 +1,106 @@
+#include "TrackFeature.h"
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+
+namespace {
+std::span<const float> Values(const OsnetFeature &feat) { return {feat.data(), feat.size()}; }
+}  // namespace
+
+TrackFeature::TrackFeature(Feature feat) {
+    if (feat.storage() == FeatureStorage::Float32 && feat.size() == kOsnetFeatureDim) {
+        osnet_ = std::make_unique<OsnetFeature>(feat);
+    } else {
+        runtime_ = std::move(feat);
+    }
+}
+
+TrackFeature::TrackFeature(const float *values, size_t dim) {
+    if (dim == kOsnetFeatureDim) {
+        osnet_ = std::make_unique<OsnetFeature>(std::span<const float>(values, dim));
+    } else {
+        runtime_ = Feature(values, dim);
+    }
+}
+
+TrackFeature::TrackFeature(const TrackFeature &other)
+    : osnet_(other.osnet_ ? std::make_unique<OsnetFeature>(*other.osnet_) : nullptr), runtime_(other.runtime_) {}
+
+TrackFeature &TrackFeature::operator=(const TrackFeature &other) {
+    if (this == &other) return *this;
+    if (other.osnet_) {
+        useOsnet() = *other.osnet_;
+    } else {
+        useRuntime();
+        runtime_ = other.runtime_;
+    }
+    return *this;
+}
+
+OsnetFeature &TrackFeature::useOsnet() {
+    if (runtime_.size() > 0) runtime_ = Feature();
+    if (!osnet_) osnet_ = std::make_unique<OsnetFeature>();
+    return *osnet_;
+}
+
+void TrackFeature::useRuntime() {
+    osnet_.reset();
+}
+
+size_t TrackFeature::size() const {
+    return osnet_ ? osnet_->size() : runtime_.size();
+}
+
+FeatureStorage TrackFeature::storage() const {
+    return osnet_ ? FeatureStorage::Float32 : runtime_.storage();
+}
+
+void TrackFeature::copyTo(float *out) const {
+    if (osnet_) {
+        std::copy(osnet_->data(), osnet_->data() + osnet_->size(), out);
+    } else {
+        runtime_.copyTo(out);
+    }
+}
+
+float TrackFeature::cosine_similarity(const TrackFeature &other) const {
+    if (osnet_ && other.osnet_) return osnet_->cosine_similarity(*other.osnet_);
+    if (!osnet_ && !other.osnet_) return runtime_.cosine_similarity(other.runtime_);
+    // 表示不同（单精度 OSNet 特征对量化特征）：把定长一侧转为运行期表示
+    return osnet_ ? osnet_->toFeature().cosine_similarity(other.runtime_)
+                  : runtime_.cosine_similarity(other.osnet_->toFeature());
+}
+
+void TrackFeature::emaUpdate(const TrackFeature &observation, float alpha) {
+    if (osnet_) {
+        if (observation.osnet_) {
+            osnet_->emaUpdate(*observation.osnet_, alpha);
+        } else {
+            osnet_->emaUpdate(OsnetFeature(observation.runtime_), alpha);
+        }
+        return;
+    }
+    if (observation.osnet_) {
+        runtime_.emaUpdate(Values(*observation.osnet_), alpha);
+    } else {
+        runtime_.emaUpdate(observation.runtime_, alpha);
+    }
+}
+
+void TrackFeature::assignConverted(const TrackFeature &src, FeatureStorage storage) {
+    if (storage == FeatureStorage::Float32 && src.size() == kOsnetFeatureDim) {
+        if (src.osnet_) {
+            useOsnet() = *src.osnet_;
+        } else {
+            useOsnet() = OsnetFeature(src.runtime_);
+        }
+        return;
+    }
+    useRuntime();
+    if (src.osnet_) {
+        runtime_.assignConverted(Values(*src.osnet_), storage);
+    } else {
+        runtime_.assignConverted(src.runtime_, storage);
+    }
+}
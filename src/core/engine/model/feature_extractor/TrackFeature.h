@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "Feature.h"
+
+// 轨迹/检测框的外观特征，按精度与维度选择表示：
+// - Float32 且维度为 kOsnetFeatureDim：OsnetFeature（单位范数的定长数组，点积与 EMA 走编译期维度内核）
+// - Float16/Int8 量化存储或其它维度：运行期 Feature
+// OsnetFeature 单独分配（2KB），不内联进 TrackerInner：量化模式与只用框的 TrackerInner 不必为它占位。
+class TrackFeature {
+public:
+    TrackFeature() = default;
+    // Float32 的 OSNet 维度特征转为 OsnetFeature（会被归一化），其余保持运行期表示
+    TrackFeature(Feature feat);
+    // 单精度数组（由维度选择表示）
+    TrackFeature(const float *values, size_t dim);
+    TrackFeature(const TrackFeature &other);
+    TrackFeature &operator=(const TrackFeature &other);
+    TrackFeature(TrackFeature &&) noexcept = default;
+    TrackFeature &operator=(TrackFeature &&) noexcept = default;
+
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    FeatureStorage storage() const;
+    // 定长表示；运行期表示时为 nullptr
+    const OsnetFeature *osnet() const { return osnet_.get(); }
+    // 运行期表示（osnet() 非空时为空特征）
+    const Feature &runtime() const { return runtime_; }
+    // 解码为单精度写入 out（长度为 size()）
+    void copyTo(float *out) const;
+
+    float cosine_similarity(const TrackFeature &other) const;
+    // 就地滑动平均并重新归一化，结果保持自身的表示与精度
+    void emaUpdate(const TrackFeature &observation, float alpha);
+    // 以指定精度写入 src 的内容，复用自身已有的缓冲（src 不能是自身）
+    void assignConverted(const TrackFeature &src, FeatureStorage storage);
+
+private:
+    // 切换为定长表示（复用已有的 OsnetFeature）并返回它
+    OsnetFeature &useOsnet();
+    // 切换为运行期表示
+    void useRuntime();
+
+    std::unique_ptr<OsnetFeature> osnet_;
+    Feature runtime_;
+};
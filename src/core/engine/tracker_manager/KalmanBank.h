@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// 一组匀速模型卡尔曼滤波器的批量实现（编译期维度：状态 2*Axes，观测 Axes）：
+// - 状态为 [p_0..p_{Axes-1}, v_0..v_{Axes-1}]，转移 p += dt*v，v *= decay；观测只看位置 p
+// - 过程噪声、观测噪声均为对角阵，初始协方差为单位阵
+// 在这种结构下协方差始终只在 (p_i, v_i) 之间耦合：predict/correct 都不会产生跨轴项，
+// 因此每个轴只需保存一个 2x2 对称块 [P00 P01; P01 P11]，结果与完整的 2Axes x 2Axes 滤波器一致。
+// 所有滤波器的状态按结构数组（SoA）存放：predictAll 对每个量做一遍连续数组扫描（可被编译器向量化），
+// 整个过程不做任何堆分配（槽位扩容除外）。
+template <int Axes>
+class ConstantVelocityKalmanBank {
+public:
+    static constexpr int kStateDim = 2 * Axes;
+    static constexpr int kMeasureDim = Axes;
+    using Measurement = std::array<float, Axes>;
+    using State = std::array<float, kStateDim>;
+
+    // 与滤波器实例无关的模型参数
+    struct Model {
+        std::array<float, Axes> vel_decay{};  // 速度衰减（转移矩阵右下角对角元）
+        std::array<float, Axes> pos_noise{};  // 位置过程噪声
+        std::array<float, Axes> vel_noise{};  // 速度过程噪声
+    };
+
+    explicit ConstantVelocityKalmanBank(const Model &model) : model_(model) {}
+
+    // 以观测 z 初始化一个滤波器（速度为 0、协方差为单位阵），返回槽位
+    int allocate(const Measurement &z, const Measurement &measure_noise) {
+        int slot = 0;
+        if (!free_.empty()) {
+            slot = free_.back();
+            free_.pop_back();
+        } else {
+            slot = static_cast<int>(active_.size());
+            active_.push_back(0);
+            for (int a = 0; a < Axes; ++a) {
+                pos_[a].push_back(0.0F);
+                vel_[a].push_back(0.0F);
+                p00_[a].push_back(0.0F);
+                p01_[a].push_back(0.0F);
+                p11_[a].push_back(0.0F);
+                r_[a].push_back(0.0F);
+            }
+        }
+        const size_t s = static_cast<size_t>(slot);
+        active_[s] = 1;
+        for (int a = 0; a < Axes; ++a) {
+            pos_[a][s] = z[a];
+            vel_[a][s] = 0.0F;
+            p00_[a][s] = 1.0F;
+            p01_[a][s] = 0.0F;
+            p11_[a][s] = 1.0F;
+            r_[a][s] = measure_noise[a];
+        }
+        ++active_count_;
+        return slot;
+    }
+
+    // 归还槽位（状态清零，保证批量预测扫描到空槽时不会产生 NaN/Inf）
+    void release(int slot) {
+        const size_t s = checkSlot(slot);
+        active_[s] = 0;
+        for (int a = 0; a < Axes; ++a) {
+            pos_[a][s] = vel_[a][s] = p00_[a][s] = p01_[a][s] = p11_[a][s] = 0.0F;
+        }
+        free_.push_back(slot);
+        --active_count_;
+    }
+
+    // 对所有槽位做一次预测：x = F x，P = F P F^T + Q
+    void predictAll(float dt) {
+        const size_t n = active_.size();
+        for (int a = 0; a < Axes; ++a) {
+            predictRange(a, 0, n, dt);
+        }
+    }
+
+    // 只预测单个槽位（与 predictAll 结果一致）
+    void predict(int slot, float dt) {
+        const size_t s = checkSlot(slot);
+        for (int a = 0; a < Axes; ++a) {
+            predictRange(a, s, s + 1, dt);
+        }
+    }
+
+    // 观测更新：K = P H^T (H P H^T + R)^-1，x += K (z - H x)，P = P - K H P
+    void correct(int slot, const Measurement &z) {
+        const size_t s = checkSlot(slot);
+        for (int a = 0; a < Axes; ++a) {
+            const float p00 = p00_[a][s], p01 = p01_[a][s], p11 = p11_[a][s];
+            const float inv_s = 1.0F / (p00 + r_[a][s]);
+            const float k0 = p00 * inv_s;
+            const float k1 = p01 * inv_s;
+            const float y = z[a] - pos_[a][s];
+            pos_[a][s] += k0 * y;
+            vel_[a][s] += k1 * y;
+            p00_[a][s] = p00 - k0 * p00;
+            p01_[a][s] = p01 - k0 * p01;
+            p11_[a][s] = p11 - k1 * p01;
+        }
+    }
+
+    float position(int slot, int axis) const { return pos_[axis][static_cast<size_t>(slot)]; }
+    float velocity(int slot, int axis) const { return vel_[axis][static_cast<size_t>(slot)]; }
+
+    State state(int slot) const {
+        State x{};
+        for (int a = 0; a < Axes; ++a) {
+            x[a] = position(slot, a);
+            x[a + Axes] = velocity(slot, a);
+        }
+        return x;
+    }
+
+    // 展开为完整的 2Axes x 2Axes 协方差（行主序），用于调试与测试
+    std::array<float, kStateDim * kStateDim> covariance(int slot) const {
+        const size_t s = static_cast<size_t>(slot);
+        std::array<float, kStateDim * kStateDim> cov{};
+        for (int a = 0; a < Axes; ++a) {
+            const int p = a, v = a + Axes;
+            cov[p * kStateDim + p] = p00_[a][s];
+            cov[p * kStateDim + v] = cov[v * kStateDim + p] = p01_[a][s];
+            cov[v * kStateDim + v] = p11_[a][s];
+        }
+        return cov;
+    }
+
+    size_t capacity() const { return active_.size(); }
+    size_t activeCount() const { return active_count_; }
+
+private:
+    size_t checkSlot(int slot) const {
+        if (slot < 0 || static_cast<size_t>(slot) >= active_.size() || !active_[static_cast<size_t>(slot)]) {
+            throw std::out_of_range("KalmanBank: 无效的槽位");
+        }
+        return static_cast<size_t>(slot);
+    }
+
+    void predictRange(int a, size_t begin, size_t end, float dt) {
+        const float d = model_.vel_decay[a];
+        const float qp = model_.pos_noise[a];
+        const float qv = model_.vel_noise[a];
+        float *pos = pos_[a].data();
+        float *vel = vel_[a].data();
+        float *p00 = p00_[a].data();
+        float *p01 = p01_[a].data();
+        float *p11 = p11_[a].data();
+        // F = [1 dt; 0 d]：
+        //   P00' = P00 + 2 dt P01 + dt^2 P11 + qp，P01' = d (P01 + dt P11)，P11' = d^2 P11 + qv
+        for (size_t s = begin; s < end; ++s) {
+            const float v = vel[s];
+            const float c01 = p01[s] + dt * p11[s];
+            pos[s] += dt * v;
+            vel[s] = d * v;
+            p00[s] = p00[s] + dt * p01[s] + dt * c01 + qp;
+            p01[s] = d * c01;
+            p11[s] = d * d * p11[s] + qv;
+        }
+    }
+
+    Model model_;
+    std::array<std::vector<float>, Axes> pos_, vel_;
+    std::array<std::vector<float>, Axes> p00_, p01_, p11_;
+    std::array<std::vector<float>, Axes> r_;  // 观测噪声
+    std::vector<char> active_;
+    std::vector<int> free_;
+    size_t active_count_ = 0;
+};
+
+// 跟踪框使用的 8x4 滤波器：轴依次为 [px, py, w, h]
+using BoxKalmanBank = ConstantVelocityKalmanBank<4>;
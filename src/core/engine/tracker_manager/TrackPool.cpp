@@ -0,0 +1,66 @@
+#include "TrackPool.h"
+
+#include <stdexcept>
+#include <utility>
+
+TrackHandle TrackPool::add(Tracker &&tracker, const TrackerInner &inner) {
+    uint32_t index = 0;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    Slot &slot = slots_[index];
+    slot.dense = static_cast<uint32_t>(trackers_.size());
+    const TrackHandle handle{index, slot.generation};
+
+    trackers_.push_back(std::move(tracker));
+    inners_.push_back(inner);
+    handles_.push_back(handle);
+    return handle;
+}
+
+void TrackPool::removeIf(std::span<const char> remove) {
+    if (remove.size() != trackers_.size()) {
+        throw std::invalid_argument("TrackPool: 删除标记与轨迹数量不一致");
+    }
+
+    size_t write = 0;
+    for (size_t read = 0; read < trackers_.size(); ++read) {
+        const TrackHandle handle = handles_[read];
+        Slot &slot = slots_[handle.index];
+        if (remove[read]) {
+            // 回收槽位并递增代数，使旧句柄失效
+            slot.dense = TrackHandle::kInvalidIndex;
+            ++slot.generation;
+            free_slots_.push_back(handle.index);
+            continue;
+        }
+        if (write != read) {
+            trackers_[write] = std::move(trackers_[read]);
+            inners_[write] = std::move(inners_[read]);
+            handles_[write] = handle;
+        }
+        slot.dense = static_cast<uint32_t>(write);
+        ++write;
+    }
+
+    // 尾部都是被移走的对象（或待删除的轨迹，此时其 Tracker 析构时归还滤波器槽位）
+    trackers_.erase(trackers_.begin() + static_cast<std::ptrdiff_t>(write), trackers_.end());
+    inners_.erase(inners_.begin() + static_cast<std::ptrdiff_t>(write), inners_.end());
+    handles_.resize(write);
+}
+
+bool TrackPool::contains(TrackHandle handle) const {
+    return indexOf(handle) >= 0;
+}
+
+int TrackPool::indexOf(TrackHandle handle) const {
+    if (handle.index >= slots_.size()) return -1;
+    const Slot &slot = slots_[handle.index];
+    if (slot.generation != handle.generation || slot.dense == TrackHandle::kInvalidIndex) return -1;
+    return static_cast<int>(slot.dense);
+}
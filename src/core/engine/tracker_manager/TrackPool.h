@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Tracker.h"
+
+// 带代数标记的轨迹句柄：index 为槽位，generation 在槽位被回收时递增，
+// 因此轨迹删除后旧句柄不会误指向复用该槽位的新轨迹
+struct TrackHandle {
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool operator==(const TrackHandle &other) const = default;
+};
+
+// 轨迹的槽位池：
+// - 存活轨迹在 trackers_/inners_ 中连续、按创建顺序存放，匹配器直接拿 span 读取，不做拷贝
+// - 槽位表把句柄映射到连续下标；删除轨迹时回收槽位进空闲链表、递增代数
+// - 批量删除是一次就地压紧，只移动元素，不做堆分配
+class TrackPool {
+public:
+    // 新增一条轨迹，返回其句柄
+    TrackHandle add(Tracker &&tracker, const TrackerInner &inner);
+    // 删除 remove[i] 非 0 的轨迹（remove 与 size() 等长），其余轨迹保持相对顺序
+    void removeIf(std::span<const char> remove);
+
+    size_t size() const { return trackers_.size(); }
+    bool empty() const { return trackers_.empty(); }
+
+    // 按连续下标访问
+    std::span<Tracker> trackers() { return trackers_; }
+    std::span<const Tracker> trackers() const { return trackers_; }
+    std::span<TrackerInner> inners() { return inners_; }
+    std::span<const TrackerInner> inners() const { return inners_; }
+    TrackHandle handleAt(size_t i) const { return handles_[i]; }
+
+    // 句柄是否仍指向存活轨迹
+    bool contains(TrackHandle handle) const;
+    // 句柄对应的连续下标；句柄已失效时返回 -1
+    int indexOf(TrackHandle handle) const;
+
+private:
+    struct Slot {
+        uint32_t dense = TrackHandle::kInvalidIndex;  // 在连续数组中的下标
+        uint32_t generation = 0;
+    };
+
+    std::vector<Tracker> trackers_;
+    std::vector<TrackerInner> inners_;
+    std::vector<TrackHandle> handles_;  // 连续下标 -> 句柄
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+};
@@ -3,133 +3,113 @@
 #include <algorithm>
 #include <cmath>
 
-Tracker::Tracker(size_t id, const TrackerInner &inner, const TrackerConfig &cfg)
-    : id_(id), inner_(inner), cfg_(cfg), life_(cfg.max_life) {
-    initKalman(inner.box);
-}
-
-void Tracker::initKalman(const BBox &box) {
-    // 状态: [px, py, w, h, vx, vy, vw, vh]
-    // px, py 使用框底边中心点，使位置与尺寸变化相对解耦
-    kf_.init(8, 4, 0, CV_32F);
-
-    // 状态转移矩阵（匀速模型，尺寸也有速度项；vw/vh 增加衰减抑制抖动）
-    const float kSizeVelDamping = 0.8f; // 尺寸速度衰减系数，<1 可降低尺寸抖动
-    kf_.transitionMatrix = (cv::Mat_<float>(8, 8) <<
-        1, 0, 0, 0, 1, 0, 0, 0,
-        0, 1, 0, 0, 0, 1, 0, 0,
-        0, 0, 1, 0, 0, 0, 1, 0, // w 受 vw 影响
-        0, 0, 0, 1, 0, 0, 0, 1, // h 受 vh 影响
-        0, 0, 0, 0, 1, 0, 0, 0,
-        0, 0, 0, 0, 0, 1, 0, 0,
-        0, 0, 0, 0, 0, 0, kSizeVelDamping, 0,
-        0, 0, 0, 0, 0, 0, 0, kSizeVelDamping);
-
-    // 观测矩阵：观测 px,py,w,h（不直接观测速度）
-    kf_.measurementMatrix = cv::Mat::zeros(4, 8, CV_32F);
-    kf_.measurementMatrix.at<float>(0, 0) = 1.0f;
-    kf_.measurementMatrix.at<float>(1, 1) = 1.0f;
-    kf_.measurementMatrix.at<float>(2, 2) = 1.0f;
-    kf_.measurementMatrix.at<float>(3, 3) = 1.0f;
-
-    // 噪声设定：位置平滑，尺寸变化允许更大波动
-    kf_.processNoiseCov = cv::Mat::eye(8, 8, CV_32F);
-    kf_.processNoiseCov.at<float>(0, 0) = 1e-3f; // px
-    kf_.processNoiseCov.at<float>(1, 1) = 1e-3f; // py
-    kf_.processNoiseCov.at<float>(2, 2) = 2e-3f; // w 更小过程噪声，平滑尺寸
-    kf_.processNoiseCov.at<float>(3, 3) = 2e-3f; // h
-    kf_.processNoiseCov.at<float>(4, 4) = 1e-3f; // vx
-    kf_.processNoiseCov.at<float>(5, 5) = 1e-3f; // vy
-    kf_.processNoiseCov.at<float>(6, 6) = 1e-2f; // vw 保留一定灵敏度
-    kf_.processNoiseCov.at<float>(7, 7) = 1e-2f; // vh
-
-    kf_.measurementNoiseCov = cv::Mat::eye(4, 4, CV_32F);
+Tracker::Tracker(size_t id, const TrackerInner &inner, const TrackerConfig &cfg, BoxKalmanBank &kf)
+    : id_(id), cfg_(cfg), life_(cfg.max_life), kf_(&kf) {
     // 观测噪声越小越“相信观测”，数值越大越平滑
     const float pos_noise = std::max(1e-6f, cfg_.kf_pos_noise);
     const float size_noise = std::max(1e-6f, cfg_.kf_size_noise);
-    kf_.measurementNoiseCov.at<float>(0, 0) = pos_noise;
-    kf_.measurementNoiseCov.at<float>(1, 1) = pos_noise;
-    kf_.measurementNoiseCov.at<float>(2, 2) = size_noise;
-    kf_.measurementNoiseCov.at<float>(3, 3) = size_noise;
+    kf_slot_ = kf_->allocate(measurementFromBox(inner.box), {pos_noise, pos_noise, size_noise, size_noise});
+}
 
-    setIdentity(kf_.errorCovPost, cv::Scalar::all(1));
+Tracker::~Tracker() {
+    releaseKalman();
+}
+
+Tracker::Tracker(Tracker &&other) noexcept
+    : id_(other.id_), cfg_(other.cfg_), life_(other.life_), consecutive_hits_(other.consecutive_hits_),
+      feature_age_(other.feature_age_), kf_(other.kf_), kf_slot_(other.kf_slot_) {
+    other.kf_slot_ = -1;
+}
 
-    kf_.statePost = stateFromBox(box);
+Tracker &Tracker::operator=(Tracker &&other) noexcept {
+    if (this != &other) {
+        releaseKalman();
+        id_ = other.id_;
+        cfg_ = other.cfg_;
+        life_ = other.life_;
+        consecutive_hits_ = other.consecutive_hits_;
+        feature_age_ = other.feature_age_;
+        kf_ = other.kf_;
+        kf_slot_ = other.kf_slot_;
+        other.kf_slot_ = -1;
+    }
+    return *this;
 }
 
-cv::Mat Tracker::stateFromBox(const BBox &box) const {
-    cv::Mat state(8, 1, CV_32F);
-    // px/py 取底边中心，使尺寸突变不影响位置
-    const float px = box.box.x + box.box.width * 0.5f;
-    const float py = box.box.y + box.box.height;
-    state.at<float>(0) = px;
-    state.at<float>(1) = py;
-    state.at<float>(2) = box.box.width;
-    state.at<float>(3) = box.box.height;
-    state.at<float>(4) = 0.0f; // vx
-    state.at<float>(5) = 0.0f; // vy
-    state.at<float>(6) = 0.0f; // vw
-    state.at<float>(7) = 0.0f; // vh
-    return state;
+void Tracker::releaseKalman() {
+    // 被移走的对象不再持有槽位
+    if (kf_slot_ >= 0) kf_->release(kf_slot_);
+    kf_slot_ = -1;
 }
 
-BBox Tracker::boxFromState(const cv::Mat &state) const {
-    const float px = state.at<float>(0);
-    const float py = state.at<float>(1);
-    const float w = std::max(1.0f, state.at<float>(2));
-    const float h = std::max(1.0f, state.at<float>(3));
-    // 由底边中心点恢复左上角坐标
-    const float x = px - w * 0.5f;
-    const float y = py - h;
-    return BBox(cv::Rect2f(x, y, w, h), inner_.box.class_id, inner_.box.score);
+BoxKalmanBank::Model Tracker::kalmanModel() {
+    // 状态: [px, py, w, h, vx, vy, vw, vh]
+    // 转移为匀速模型，尺寸也有速度项；vw/vh 增加衰减抑制抖动
+    const float kSizeVelDamping = 0.8f; // 尺寸速度衰减系数，<1 可降低尺寸抖动
+    BoxKalmanBank::Model model;
+    model.vel_decay = {1.0f, 1.0f, kSizeVelDamping, kSizeVelDamping};
+    // 噪声设定：位置平滑，尺寸变化允许更大波动
+    model.pos_noise = {1e-3f, 1e-3f, 2e-3f, 2e-3f}; // px, py；w/h 更小过程噪声，平滑尺寸
+    model.vel_noise = {1e-3f, 1e-3f, 1e-2f, 1e-2f}; // vx, vy；vw/vh 保留一定灵敏度
+    return model;
 }
 
-void Tracker::predict(float dt) {
+BoxKalmanBank::Measurement Tracker::measurementFromBox(const BBox &box) {
+    // 观测 px,py,w,h（不直接观测速度）；px/py 取底边中心，使尺寸突变不影响位置
+    return {box.box.x + box.box.width * 0.5f, box.box.y + box.box.height, box.box.width, box.box.height};
+}
+
+void Tracker::predict(TrackerInner &inner, float dt) {
     const float step = (dt > 0.0f) ? dt : 1.0f;
-    // 根据真实时间间隔更新转移矩阵（dt）
-    kf_.transitionMatrix.at<float>(0, 4) = step;
-    kf_.transitionMatrix.at<float>(1, 5) = step;
-    kf_.transitionMatrix.at<float>(2, 6) = step;
-    kf_.transitionMatrix.at<float>(3, 7) = step;
-
-    cv::Mat pred = kf_.predict();
-    inner_.box = boxFromState(pred);
+    kf_->predict(kf_slot_, step);
+    syncPrediction(inner);
+}
+
+void Tracker::syncPrediction(TrackerInner &inner) const {
+    const float px = kf_->position(kf_slot_, 0);
+    const float py = kf_->position(kf_slot_, 1);
+    const float w = std::max(1.0f, kf_->position(kf_slot_, 2));
+    const float h = std::max(1.0f, kf_->position(kf_slot_, 3));
+    // 由底边中心点恢复左上角坐标（类别与分数保持不变）
+    inner.box.box = cv::Rect2f(px - w * 0.5f, py - h, w, h);
 }
 
-bool Tracker::updateAsHitting(const TrackerInner &detection) {
+bool Tracker::updateAsHitting(TrackerInner &inner, const TrackerInner &detection) {
     // Kalman 更新
-    cv::Mat meas = (cv::Mat_<float>(4, 1) <<
-                    detection.box.box.x + detection.box.box.width * 0.5f,
-                    detection.box.box.y + detection.box.box.height, // 底边中心 y
-                    detection.box.box.width,
-                    detection.box.box.height);
-    kf_.correct(meas);
-    inner_.box = detection.box;
-
-    // 特征滑动平均
-    std::vector<float> fused;
-    fused.resize(inner_.feature.size());
-    const auto &old_f = inner_.feature.values();
-    const auto &new_f = detection.feature.values();
-    const float alpha = cfg_.feature_momentum;
-    for (size_t i = 0; i < fused.size(); ++i) {
-        fused[i] = alpha * new_f[i] + (1.0f - alpha) * old_f[i];
-    }
-    inner_.feature = Feature(std::move(fused)).normalized();
+    kf_->correct(kf_slot_, measurementFromBox(detection.box));
+    inner.box = detection.box;
+
+    // 特征滑动平均：就地融合并重新归一化，不产生临时向量
+    inner.feature.emaUpdate(detection.feature, cfg_.feature_momentum);
+    feature_age_ = 0;
+
+    recordHit();
+    return true;
+}
 
+bool Tracker::updateMotionOnly(TrackerInner &inner, const BBox &box) {
+    kf_->correct(kf_slot_, measurementFromBox(box));
+    inner.box = box;
+    ++feature_age_;
+
+    recordHit();
+    return true;
+}
+
+void Tracker::recordHit() {
     consecutive_hits_ = std::min(3, consecutive_hits_ + 1);
     life_ = std::min(cfg_.max_life, life_ + (1 << consecutive_hits_));
-    return true;
 }
 
 bool Tracker::updateAsMissing() {
     consecutive_hits_ = 0;
+    ++feature_age_;
     life_ = std::max(0, life_ - 1);
     return life_ == 0;
 }
 
 
-bool Tracker::isHealthy() {
+bool Tracker::isHealthy() const {
     const int min_life = std::max(1, static_cast<int>(std::ceil(cfg_.max_life * cfg_.healthy_percent)));
     return life_ >= min_life;
 }
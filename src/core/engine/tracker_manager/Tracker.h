@@ -1,12 +1,12 @@
 #pragma once
 
-#include <opencv2/video/tracking.hpp>
+#include "KalmanBank.h"
 #include "../model/detector/BBox.h"
-#include "../model/feature_extractor/Feature.h"
+#include "../model/feature_extractor/TrackFeature.h"
 
 struct TrackerInner {
     BBox box;
-    Feature feature;
+    TrackFeature feature;
     int age = 0;
 };
 
@@ -18,34 +18,51 @@ struct TrackerConfig {
     float kf_size_noise = 1e-1f;   // 尺寸观测噪声（越小越灵敏）
 };
 
+// 单条轨迹的生命周期与滤波状态。轨迹的 TrackerInner（框与特征）由 TrackPool 连续存放，
+// 需要读写它的接口都显式传入该轨迹对应的 inner。
 class Tracker {
 public:
-    Tracker(size_t id, const TrackerInner &inner, const TrackerConfig &cfg);
+    // 滤波器状态存放在 kf 中（通常由 TrackerManager 持有，批量预测），析构时归还槽位
+    Tracker(size_t id, const TrackerInner &inner, const TrackerConfig &cfg, BoxKalmanBank &kf);
+    ~Tracker();
+    Tracker(Tracker &&other) noexcept;
+    Tracker &operator=(Tracker &&other) noexcept;
+    Tracker(const Tracker &) = delete;
+    Tracker &operator=(const Tracker &) = delete;
 
-    // 卡尔曼预测，更新内部 bbox 但不改变 life
-    void predict(float dt = 1.0f);
+    // 跟踪框滤波器的模型参数（匀速模型，尺寸速度带衰减）
+    static BoxKalmanBank::Model kalmanModel();
+
+    // 卡尔曼预测，更新 inner 的 bbox 但不改变 life
+    void predict(TrackerInner &inner, float dt = 1.0f);
+    // 滤波器已被外部批量预测（BoxKalmanBank::predictAll）后，用预测状态刷新 inner 的 bbox
+    void syncPrediction(TrackerInner &inner) const;
     // 命中更新，返回是否仍存活（恒为 true，便于链式调用）
-    bool updateAsHitting(const TrackerInner &detection);
+    bool updateAsHitting(TrackerInner &inner, const TrackerInner &detection);
+    // 仅用检测框命中更新（本帧未抽取 ReID 特征，外观特征保持不变）
+    bool updateMotionOnly(TrackerInner &inner, const BBox &box);
     // 未命中更新，life 减少；若归零返回 true 表示应清除
     bool updateAsMissing();
     
     // 是否健康（健康即可以输出这个Tracker的预测结果，否则就暂时隐藏这个Tracker的预测结果）
-    bool isHealthy();
+    bool isHealthy() const;
 
     size_t id() const { return id_; }
-    const TrackerInner &getInner() const { return inner_; }
+    // 外观特征距上次用检测特征更新过去的帧数
+    int featureAge() const { return feature_age_; }
 
 private:
-    void initKalman(const BBox &box);
-    cv::Mat stateFromBox(const BBox &box) const;
-    BBox boxFromState(const cv::Mat &state) const;
+    static BoxKalmanBank::Measurement measurementFromBox(const BBox &box);
+    void recordHit();
+    void releaseKalman();
 
     size_t id_ = 0;
-    TrackerInner inner_;
     TrackerConfig cfg_{};
 
     int life_ = 0;
     int consecutive_hits_ = 0;
+    int feature_age_ = 0;
 
-    cv::KalmanFilter kf_;
+    BoxKalmanBank *kf_ = nullptr;
+    int kf_slot_ = -1;
 };
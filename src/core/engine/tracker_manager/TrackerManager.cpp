@@ -1,86 +1,249 @@
 #include "TrackerManager.h"
-#include "matcher/Matcher.h"
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+namespace {
+// pending 检测被轨迹“消费”后的 age 标记，下一轮会在 addNewDetections 里被过滤掉
+constexpr int kConsumedAge = 1000000000;
+}  // namespace
+
 TrackerManager::TrackerManager(const TrackerManagerConfig &cfg) :
     cfg_(cfg), 
-    matcher_(std::make_unique<Matcher>(cfg.matcher_cfg)) {}
+    matcher_(CreateMatcher(cfg.matcher_cfg)),
+    kalman_(Tracker::kalmanModel()) {}
 
 void TrackerManager::predictAll(float dt) {
-    for (auto &t : trackers_) {
-        t->predict(dt);
+    // 一次扫描预测所有滤波器，再逐条刷新 bbox
+    kalman_.predictAll(dt > 0.0f ? dt : 1.0f);
+    auto trackers = tracks_.trackers();
+    auto inners = tracks_.inners();
+    for (size_t i = 0; i < trackers.size(); ++i) {
+        trackers[i].syncPrediction(inners[i]);
     }
 }
 
+bool TrackerManager::exportsFeaturesAt(int frame_index) const {
+    if (!cfg_.export_features) return false;
+    if (cfg_.export_feature_windows.empty()) return true;
+    return std::any_of(cfg_.export_feature_windows.begin(), cfg_.export_feature_windows.end(),
+                       [frame_index](const auto &w) { return frame_index >= w.first && frame_index < w.second; });
+}
+
 void TrackerManager::fillLabeledFrame(int frame_index, LabeledFrame &label) const {
     // 将当前健康的 trackers_ 导出为统一的标注结构，供 UI/下游模块使用
     label.frame_index = frame_index;
     label.objs.clear();
-    label.objs.reserve(trackers_.size());
+    label.objs.reserve(tracks_.size());
 
-    for (const auto &t : trackers_) {
-        if (!t->isHealthy()) continue;
-        const auto &inner = t->getInner();
+    const bool with_features = exportsFeaturesAt(frame_index);
+    const auto trackers = tracks_.trackers();
+    const auto inners = tracks_.inners();
+    for (size_t i = 0; i < trackers.size(); ++i) {
+        if (!trackers[i].isHealthy()) continue;
+        const auto &inner = inners[i];
 
         LabeledObject obj;
-        obj.id = static_cast<int>(t->id());
+        obj.id = static_cast<int>(trackers[i].id());
         obj.bbox = inner.box.box;  // cv::Rect2f -> cv::Rect（OpenCV 支持转换/截断）
         obj.class_id = inner.box.class_id;
         obj.score = inner.box.score;
-        label.objs.push_back(obj);
+        if (with_features && inner.feature.size() > 0) {
+            obj.feature.resize(inner.feature.size());
+            inner.feature.copyTo(obj.feature.data());
+        }
+        label.objs.push_back(std::move(obj));
     }
 }
 
-const std::vector<std::unique_ptr<Tracker>> &
-TrackerManager::update(const std::vector<TrackerInner> &detections) {
-    // 1) 预测阶段已在外部或通过 predictAll 调用，这里直接拿当前 tracker inner
-    std::vector<TrackerInner> current = currentTrackerInners();
-    
+void TrackerManager::planReid(std::span<const BBox> boxes, ReidPlan &plan) {
+    const ReidGateConfig &gate = cfg_.reid_gate;
+    const size_t n = boxes.size();
+    plan.actions.assign(n, ReidAction::Extract);
+    plan.tracks.assign(n, -1);
+    plan.crops = 0;
+
+    const auto trackers = tracks_.trackers();
+    const auto inners = tracks_.inners();
+    if (n > 0 && !trackers.empty()) {
+        // 空间门控只取出与检测框相交的轨迹
+        plan_dets_.resize(n);
+        for (size_t i = 0; i < n; ++i) plan_dets_[i].box = boxes[i];
+        reid_gate_.build(plan_dets_, inners, 0.0f);
+
+        // 每条轨迹被多少个检测以 ambiguity_iou 以上覆盖（多于 1 个说明检测之间存在竞争）
+        plan_claims_.assign(trackers.size(), 0);
+        for (size_t i = 0; i < n; ++i) {
+            float best_iou = 0.0f, second_iou = 0.0f;
+            int best = -1;
+            for (int k = reid_gate_.rowBegin(static_cast<int>(i)); k < reid_gate_.rowEnd(static_cast<int>(i)); ++k) {
+                const int t = reid_gate_.candidates()[static_cast<size_t>(k)];
+                const float iou = boxes[i] & inners[static_cast<size_t>(t)].box;
+                if (iou >= gate.ambiguity_iou) ++plan_claims_[static_cast<size_t>(t)];
+                if (iou > best_iou) {
+                    second_iou = best_iou;
+                    best_iou = iou;
+                    best = t;
+                } else if (iou > second_iou) {
+                    second_iou = iou;
+                }
+            }
+            // 无歧义：与唯一一条轨迹高度重合，附近没有其它轨迹
+            if (best >= 0 && best_iou >= gate.confident_iou && second_iou < gate.ambiguity_iou) {
+                plan.tracks[i] = best;
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const int t = plan.tracks[i];
+            if (t < 0) continue;
+            if (plan_claims_[static_cast<size_t>(t)] > 1) {
+                // 同一轨迹附近还有别的检测，交给外观特征区分
+                plan.tracks[i] = -1;
+                continue;
+            }
+            const bool stale = trackers[static_cast<size_t>(t)].featureAge() >= gate.refresh_interval;
+            plan.actions[i] = stale ? ReidAction::Refresh : ReidAction::Reuse;
+        }
+    }
+
+    // 每帧裁剪上限：优先保证有歧义/新目标的检测（按置信度），其次是特征最旧的轨迹刷新
+    plan_order_.clear();
+    for (size_t i = 0; i < n; ++i) {
+        if (plan.actions[i] == ReidAction::Extract || plan.actions[i] == ReidAction::Refresh) plan_order_.push_back(i);
+    }
+    const size_t cap = gate.max_crops_per_frame > 0 ? static_cast<size_t>(gate.max_crops_per_frame) : plan_order_.size();
+    if (plan_order_.size() > cap) {
+        std::sort(plan_order_.begin(), plan_order_.end(), [&](size_t a, size_t b) {
+            const bool ea = plan.actions[a] == ReidAction::Extract, eb = plan.actions[b] == ReidAction::Extract;
+            if (ea != eb) return ea;
+            if (ea) return boxes[a].score > boxes[b].score;
+            return trackers[static_cast<size_t>(plan.tracks[a])].featureAge() >
+                   trackers[static_cast<size_t>(plan.tracks[b])].featureAge();
+        });
+        for (size_t r = cap; r < plan_order_.size(); ++r) {
+            const size_t i = plan_order_[r];
+            // 刷新可以推迟到下一帧；有歧义的检测没有特征无法参与匹配，本帧放弃
+            plan.actions[i] = plan.actions[i] == ReidAction::Refresh ? ReidAction::Reuse : ReidAction::Drop;
+        }
+    }
+    plan.crops = std::min(cap, plan_order_.size());
+}
+
+const TrackPool &TrackerManager::update(const std::vector<TrackerInner> &detections) {
+    return associate(detections, nullptr);
+}
+
+const TrackPool &TrackerManager::update(const std::vector<TrackerInner> &detections, const ReidPlan &plan) {
+    if (plan.actions.size() != detections.size() || plan.tracks.size() != detections.size()) {
+        throw std::invalid_argument("ReidPlan 与检测数量不一致");
+    }
+    return associate(detections, &plan);
+}
+
+const TrackPool &TrackerManager::associate(const std::vector<TrackerInner> &detections, const ReidPlan *plan) {
+    // 1) 预测阶段已在外部或通过 predictAll 调用，这里直接以 span 读取轨迹池中的 inner
+    // 上一帧的临时容器均已析构，整体回收
+    arena_.reset();
+    std::pmr::memory_resource *mr = arena_.resource();
+
+    auto trackers = tracks_.trackers();
+    auto inners = tracks_.inners();
+    std::pmr::vector<char> track_hit(trackers.size(), 0, mr);
+
+    // 选择性 ReID：无歧义的检测直接命中规划时选定的轨迹，只有需要外观区分的检测走常规匹配
+    const std::vector<TrackerInner> *dets = &detections;
+    if (plan) {
+        routed_dets_.clear();
+        for (size_t i = 0; i < detections.size(); ++i) {
+            const int t = plan->tracks[i];
+            switch (plan->actions[i]) {
+            case ReidAction::Reuse:
+                trackers[static_cast<size_t>(t)].updateMotionOnly(inners[static_cast<size_t>(t)], detections[i].box);
+                track_hit[static_cast<size_t>(t)] = 1;
+                break;
+            case ReidAction::Refresh:
+                trackers[static_cast<size_t>(t)].updateAsHitting(inners[static_cast<size_t>(t)], detections[i]);
+                track_hit[static_cast<size_t>(t)] = 1;
+                break;
+            case ReidAction::Extract:
+                routed_dets_.push_back(detections[i]);
+                break;
+            case ReidAction::Drop:
+                break;
+            }
+        }
+        dets = &routed_dets_;
+    }
+
+    // 量化存储时先把本帧检测转换为同一精度，之后的匹配与 EMA 都在量化表示上进行
+    if (cfg_.feature_storage != FeatureStorage::Float32) {
+        converted_dets_.resize(dets->size());
+        for (size_t i = 0; i < dets->size(); ++i) {
+            converted_dets_[i].box = (*dets)[i].box;
+            converted_dets_[i].age = (*dets)[i].age;
+            converted_dets_[i].feature.assignConverted((*dets)[i].feature, cfg_.feature_storage);
+        }
+        dets = &converted_dets_;
+    }
+
     // 2) 将新检测到的 dets 加入到pending_dets中
-    addNewDetections(detections);
+    addNewDetections(*dets);
 
-    // 2) 让当前的tracker和pending_dets匹配
-    auto matches = matcher_->match(current, pending_dets_);
+    // 2) 让当前的tracker和pending_dets匹配。
+    // 本帧已被直接关联（Reuse/Refresh）的轨迹不参与：否则 Extract 检测的最优匹配落在这些轨迹上时
+    // 既不命中也不被消费，留在 pending 里两帧后被当成新目标，与存活轨迹重复
+    // 只传下标视图，匹配器直接读轨迹池中的 inner，不拷贝特征
+    TrackerInnerView match_tracks = inners;
+    const bool indexed = plan && std::find(track_hit.begin(), track_hit.end(), 1) != track_hit.end();
+    if (indexed) {
+        free_track_index_.clear();
+        for (size_t i = 0; i < trackers.size(); ++i) {
+            if (!track_hit[i]) free_track_index_.push_back(static_cast<int>(i));
+        }
+        match_tracks = TrackerInnerView(inners, free_track_index_);
+    }
+    auto matches = matcher_->match(match_tracks, pending_dets_, mr);
 
-    std::vector<char> det_used(pending_dets_.size(), 0);
-    for (auto [ti, di] : matches) {
-        if (ti < 0 || ti >= static_cast<int>(trackers_.size())) continue;
+    std::pmr::vector<char> det_used(pending_dets_.size(), 0, mr);
+    for (auto [mi, di] : matches) {
+        if (mi < 0 || mi >= static_cast<int>(match_tracks.size())) continue;
         if (di < 0 || di >= static_cast<int>(pending_dets_.size())) continue;
+        const int ti = indexed ? free_track_index_[static_cast<size_t>(mi)] : mi;
         
         // 如果 pending_det 的 age 小于 2，则更新 tracker（避免age为2的状态不新鲜）
         if (pending_dets_[di].age < 2) {
-            trackers_[ti]->updateAsHitting(pending_dets_[di]);
+            trackers[ti].updateAsHitting(inners[ti], pending_dets_[di]);
         }
+        track_hit[ti] = 1;
         // 然后将其标记为本轮已匹配
         det_used[di] = 1;
         // 同时将其标记为丢弃，避免下一轮再次被匹配到
         // 这里用一个很大的 age 作为“已消费”标记，下一轮会在 addNewDetections 里被过滤掉
-        pending_dets_[di].age = 1000000000;
-    }
-
-    // 3) 对未匹配的 tracker 做 missed 更新，标记清除
-    std::vector<std::unique_ptr<Tracker>> alive;
-    alive.reserve(trackers_.size());
-    for (size_t i = 0; i < trackers_.size(); ++i) {
-        bool removed = false;
-        // 若该 tracker 未被命中
-        bool hit = false;
-        for (auto &m : matches) {
-            if (static_cast<size_t>(m.first) == i) { hit = true; break; }
-        }
-        if (!hit) {
-            removed = trackers_[i]->updateAsMissing();
-        }
-        if (!removed) {
-            alive.push_back(std::move(trackers_[i]));
+        pending_dets_[di].age = kConsumedAge;
+    }
+
+    // 3) 对未匹配的 tracker 做 missed 更新，标记清除后就地压紧
+    stats_ = {};
+    std::pmr::vector<char> track_dead(trackers.size(), 0, mr);
+    for (size_t i = 0; i < trackers.size(); ++i) {
+        if (!track_hit[i]) {
+            ++stats_.misses;
+            track_dead[i] = trackers[i].updateAsMissing() ? 1 : 0;
+            if (track_dead[i]) ++stats_.removed;
+        } else {
+            ++stats_.hits;
         }
     }
-    trackers_.swap(alive);
+    tracks_.removeIf(track_dead);
 
     // 4) 为未匹配的检测创建新 tracker
     for (size_t d = 0; d < pending_dets_.size(); ++d) {
+        if (!det_used[d] && pending_dets_[d].age < 2) ++stats_.pending;
         if (det_used[d] || pending_dets_[d].age < 2) continue; // 被匹配到的或者是未匹配次数大于等于3次的，才创建一个新的Tracker（延迟匹配）
-        trackers_.push_back(std::make_unique<Tracker>(next_id_++, pending_dets_[d], cfg_.tracker_cfg));
+        tracks_.add(Tracker(next_id_++, pending_dets_[d], cfg_.tracker_cfg, kalman_), pending_dets_[d]);
+        ++stats_.created;
     }
     
     // 5) 更新 pending_dets 的age
@@ -88,26 +251,17 @@ TrackerManager::update(const std::vector<TrackerInner> &detections) {
         det.age++;
     }
 
-    return trackers_;
-}
-
-
-std::vector<TrackerInner> TrackerManager::currentTrackerInners() {
-    std::vector<TrackerInner> current;
-    current.reserve(trackers_.size());
-    for (auto &t : trackers_) current.push_back(t->getInner());
-    return current;
+    return tracks_;
 }
 
 
 void TrackerManager::addNewDetections(const std::vector<TrackerInner> &detections) {
     // 1) 先和已经存在的 pending_dets 匹配一下
-    auto matches = matcher_->match(pending_dets_, detections);
-    
-    std::vector<TrackerInner> new_pending_dets;
+    std::pmr::memory_resource *mr = arena_.resource();
+    auto matches = matcher_->match(pending_dets_, detections, mr);
     
     // 2) 记录哪些“新检测”被旧 pending 匹配到了（避免重复加入）
-    std::vector<char> det_matched(detections.size(), 0);
+    std::pmr::vector<char> det_matched(detections.size(), 0, mr);
     for (const auto &m : matches) {
         // 注意：m.first 对应 pending_dets_ 的索引，m.second 对应 detections 的索引
         if (m.first < 0 || m.first >= static_cast<int>(pending_dets_.size())) continue;
@@ -120,22 +274,22 @@ void TrackerManager::addNewDetections(const std::vector<TrackerInner> &detection
         pending_dets_[static_cast<size_t>(m.first)].feature = detections[static_cast<size_t>(m.second)].feature;
     }
 
-    new_pending_dets.reserve(pending_dets_.size() + detections.size());
+    new_pending_dets_.clear();
+    new_pending_dets_.reserve(pending_dets_.size() + detections.size());
 
     // 3) 先保留还没过期的旧 pending（其中已匹配的会在上面被更新过内容）
-    for (const auto &p : pending_dets_) {
+    for (auto &p : pending_dets_) {
         if (p.age <= 2) {
-            new_pending_dets.push_back(p);
+            new_pending_dets_.push_back(std::move(p));
         }
     }
 
     // 4) 再加入未匹配到旧 pending 的新检测，作为新的 pending（age 从 0 开始）
     for (size_t i = 0; i < detections.size(); ++i) {
         if (det_matched[i]) continue;
-        TrackerInner fresh = detections[i];
-        new_pending_dets.push_back(std::move(fresh));
+        new_pending_dets_.push_back(detections[i]);
     }
     
     // 5) 更新 pending_dets_
-    pending_dets_.swap(new_pending_dets);
+    pending_dets_.swap(new_pending_dets_);
 }
@@ -1,25 +1,85 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "TrackPool.h"
+#include "core/memory/FrameArena.h"
 #include "Tracker.h"
+#include "matcher/AssociationGate.h"
 #include "matcher/IMatcher.h"
 #include "structure/LabeledData.h"
 
+// 选择性 ReID：先用运动预测与 IoU 判断每个检测是否无歧义，只为必要的检测抽取外观特征
+struct ReidGateConfig {
+    bool enabled = false;          // 关闭时每个检测框都抽取特征（默认行为）
+    float confident_iou = 0.7f;    // 与唯一候选轨迹的 IoU 达到该值才视为无歧义
+    float ambiguity_iou = 0.3f;    // 存在其它轨迹/检测与之 IoU 达到该值时视为有歧义
+    int refresh_interval = 30;     // 轨迹外观特征超过该帧数未更新时，无歧义检测也抽取特征刷新
+    int max_crops_per_frame = 0;   // 每帧抽取特征的检测框上限（0 表示不限）
+};
+
+// 每个检测在选择性 ReID 下的处理方式
+enum class ReidAction : uint8_t {
+    Reuse,    // 无歧义：直接命中对应轨迹，不抽特征（外观特征保持不变）
+    Refresh,  // 无歧义但轨迹特征过旧：直接命中并抽特征做 EMA
+    Extract,  // 有歧义或可能是新目标：抽特征后走常规匹配
+    Drop,     // 超出每帧裁剪上限的有歧义检测，本帧放弃
+};
+
+struct ReidPlan {
+    std::vector<ReidAction> actions;  // 与检测框一一对应
+    std::vector<int> tracks;          // Reuse/Refresh 时命中的轨迹（轨迹池 dense 下标），否则为 -1
+    size_t crops = 0;                 // 需要抽取特征的检测数
+};
+
+// 最近一次 update 的统计（供关键帧调度等判断场景是否稳定）
+struct TrackerUpdateStats {
+    size_t hits = 0;      // 命中的轨迹数
+    size_t misses = 0;    // 未命中的轨迹数
+    size_t created = 0;   // 新建的轨迹数
+    size_t removed = 0;   // 清除的轨迹数
+    size_t pending = 0;   // 尚未确认为轨迹的检测数
+};
+
 struct TrackerManagerConfig {
     MatcherConfig matcher_cfg;
     TrackerConfig tracker_cfg;
+    // 轨迹与 pending 检测的特征存储精度（Float16/Int8 可显著降低大量轨迹时的内存与缓存压力）
+    FeatureStorage feature_storage = FeatureStorage::Float32;
+    ReidGateConfig reid_gate;
+    // 输出标注时附带轨迹的外观特征（离线分段拼接等需要 ReID 的下游使用；默认关闭以免每帧拷贝特征）
+    bool export_features = false;
+    // export_features 开启时只在这些帧区间 [first, second) 内附带特征（帧号同 fillLabeledFrame 的 frame_index）；
+    // 为空表示每帧都附带。运行期设置，不写入配置文件
+    std::vector<std::pair<int, int>> export_feature_windows;
 };
 
 class TrackerManager {
 public:
     explicit TrackerManager(const TrackerManagerConfig &cfg = {});
+    // Tracker 持有 kalman_ 的引用，不允许拷贝/移动
+    TrackerManager(const TrackerManager &) = delete;
+    TrackerManager &operator=(const TrackerManager &) = delete;
 
     // 预测所有轨迹
     void predictAll(float dt = 1.0f);
-    // 输入检测结果，更新匹配；返回存活的轨迹列表
-    const std::vector<std::unique_ptr<Tracker>> &update(const std::vector<TrackerInner> &detections);
+    // 输入检测结果，更新匹配；返回存活的轨迹池
+    const TrackPool &update(const std::vector<TrackerInner> &detections);
+    // 选择性 ReID：在 predictAll 之后、update 之前，根据本帧检测框规划哪些需要抽取特征
+    void planReid(std::span<const BBox> boxes, ReidPlan &plan);
+    // 按规划更新：detections 与 plan.actions 一一对应，Reuse/Drop 的检测不需要特征。
+    // 调用 planReid 与本函数之间轨迹池不能被修改
+    const TrackPool &update(const std::vector<TrackerInner> &detections, const ReidPlan &plan);
+    const TrackPool &tracks() const { return tracks_; }
+    const TrackerUpdateStats &lastUpdateStats() const { return stats_; }
+    // 尚未确认为轨迹的检测（下一帧需要再次检测到才会建立轨迹）
+    std::span<const TrackerInner> pendingDetections() const { return pending_dets_; }
+    // 帧级内存池：update 内的临时容器（匹配结果、标记数组）都从这里分配，每次 update 开头整体 reset
+    const FrameArena &frameArena() const { return arena_; }
 
     // 获取当前所有 Tracker 的“预测/更新后”结果，并组装成统一的 LabeledFrame
     // 说明：该方法只负责把 trackers_ 的当前状态导出；Tracker 的 predict/update 仍由外部时序控制。
@@ -28,11 +88,31 @@ public:
 private:
     TrackerManagerConfig cfg_;
     std::unique_ptr<IMatcher> matcher_;
-    std::vector<std::unique_ptr<Tracker>> trackers_;
+    // 所有轨迹的卡尔曼状态（SoA）；需在 tracks_ 之前声明，保证轨迹先于它析构
+    BoxKalmanBank kalman_;
+    TrackPool tracks_;
     size_t next_id_ = 0;
+    TrackerUpdateStats stats_;
     
     std::vector<TrackerInner> pending_dets_;
-    
-    std::vector<TrackerInner> currentTrackerInners();
+
+    FrameArena arena_;
+    // 跨帧保留的 pending 交换缓冲
+    std::vector<TrackerInner> new_pending_dets_;
+    // 按 feature_storage 转换后的本帧检测（仅量化存储时使用，帧间复用）
+    std::vector<TrackerInner> converted_dets_;
+
+    // 选择性 ReID 的帧间复用缓冲
+    AssociationGate reid_gate_;
+    std::vector<TrackerInner> plan_dets_;
+    std::vector<int> plan_claims_;
+    std::vector<size_t> plan_order_;
+    std::vector<TrackerInner> routed_dets_;
+    // 本帧未被直接关联的轨迹在轨迹池中的下标，只有它们参与常规匹配（以下标视图传给匹配器）
+    std::vector<int> free_track_index_;
+
+    // frame_index 这一帧的标注是否附带特征
+    bool exportsFeaturesAt(int frame_index) const;
+    const TrackPool &associate(const std::vector<TrackerInner> &detections, const ReidPlan *plan);
     void addNewDetections(const std::vector<TrackerInner> &detections);
 };
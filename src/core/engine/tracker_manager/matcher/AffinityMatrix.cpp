@@ -0,0 +1,241 @@
+#include "AffinityMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "core/simd/Simd.h"
+#include "core/simd/VectorKernels.h"
+
+namespace {
+// 与 BBox::operator& 一致的分母平滑项
+constexpr float kIouEps = 1e-6F;
+
+// 几何加权的一项在对数域的贡献：权重为 0 时恒为 0（对应 pow(x, 0) = 1）
+inline float LogTerm(float value, float weight) {
+    return weight == 0.0F ? 0.0F : weight * std::log(value);
+}
+}  // namespace
+
+void AffinityMatrix::packFeatures(TrackerInnerView items, int dim, cv::Mat &packed) {
+    packed.create(static_cast<int>(items.size()), dim, CV_32F);
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (static_cast<int>(items[i].feature.size()) != dim) {
+            throw std::runtime_error("特征维度不一致");
+        }
+        float *dst = packed.ptr<float>(static_cast<int>(i));
+        // 定长特征恒为单位向量，直接拷贝
+        if (const OsnetFeature *fixed = items[i].feature.osnet()) {
+            std::copy(fixed->data(), fixed->data() + dim, dst);
+            continue;
+        }
+        const Feature &feat = items[i].feature.runtime();
+        // 范数已缓存；单位向量直接拷贝
+        const float norm = feat.l2norm();
+        if (norm < 1e-12F) {
+            throw std::runtime_error("余弦相似度计算时范数为零");
+        }
+        const float *src = feat.data();
+        if (feat.isUnit()) {
+            std::copy(src, src + dim, dst);
+        } else {
+            for (int k = 0; k < dim; ++k) dst[k] = src[k] / norm;
+        }
+    }
+}
+
+void AffinityMatrix::computeIouRow(const BBox &box, const float *x0, const float *y0, const float *x1,
+                                   const float *y1, const float *area, size_t count) {
+    const size_t m = count;
+    iou_row_.resize(m);
+    const float bx0 = box.box.x, by0 = box.box.y;
+    const float bx1 = box.box.x + box.box.width, by1 = box.box.y + box.box.height;
+    const float barea = box.box.area();
+    float *out = iou_row_.data();
+
+    size_t k = 0;
+    if (use_simd_) {
+#if defined(MTT_SIMD_AVX2)
+        const __m256 vx0 = _mm256_set1_ps(bx0), vy0 = _mm256_set1_ps(by0);
+        const __m256 vx1 = _mm256_set1_ps(bx1), vy1 = _mm256_set1_ps(by1);
+        const __m256 varea = _mm256_set1_ps(barea);
+        const __m256 zero = _mm256_setzero_ps(), eps = _mm256_set1_ps(kIouEps);
+        for (; k + 8 <= m; k += 8) {
+            const __m256 iw = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(_mm256_loadu_ps(x1 + k), vx1),
+                                                          _mm256_max_ps(_mm256_loadu_ps(x0 + k), vx0)), zero);
+            const __m256 ih = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(_mm256_loadu_ps(y1 + k), vy1),
+                                                          _mm256_max_ps(_mm256_loadu_ps(y0 + k), vy0)), zero);
+            const __m256 inter = _mm256_mul_ps(iw, ih);
+            const __m256 denom = _mm256_add_ps(_mm256_sub_ps(_mm256_add_ps(varea, _mm256_loadu_ps(area + k)), inter), eps);
+            const __m256 valid = _mm256_cmp_ps(inter, zero, _CMP_GT_OQ);
+            _mm256_storeu_ps(out + k, _mm256_and_ps(valid, _mm256_div_ps(inter, denom)));
+        }
+#endif
+#if defined(MTT_SIMD_SSE2)
+        const __m128 vx04 = _mm_set1_ps(bx0), vy04 = _mm_set1_ps(by0);
+        const __m128 vx14 = _mm_set1_ps(bx1), vy14 = _mm_set1_ps(by1);
+        const __m128 varea4 = _mm_set1_ps(barea);
+        const __m128 zero4 = _mm_setzero_ps(), eps4 = _mm_set1_ps(kIouEps);
+        for (; k + 4 <= m; k += 4) {
+            const __m128 iw4 = _mm_max_ps(_mm_sub_ps(_mm_min_ps(_mm_loadu_ps(x1 + k), vx14),
+                                                     _mm_max_ps(_mm_loadu_ps(x0 + k), vx04)), zero4);
+            const __m128 ih4 = _mm_max_ps(_mm_sub_ps(_mm_min_ps(_mm_loadu_ps(y1 + k), vy14),
+                                                     _mm_max_ps(_mm_loadu_ps(y0 + k), vy04)), zero4);
+            const __m128 inter4 = _mm_mul_ps(iw4, ih4);
+            const __m128 denom4 = _mm_add_ps(_mm_sub_ps(_mm_add_ps(varea4, _mm_loadu_ps(area + k)), inter4), eps4);
+            const __m128 valid4 = _mm_cmpgt_ps(inter4, zero4);
+            _mm_storeu_ps(out + k, _mm_and_ps(valid4, _mm_div_ps(inter4, denom4)));
+        }
+#elif defined(MTT_SIMD_NEON)
+        const float32x4_t vx04 = vdupq_n_f32(bx0), vy04 = vdupq_n_f32(by0);
+        const float32x4_t vx14 = vdupq_n_f32(bx1), vy14 = vdupq_n_f32(by1);
+        const float32x4_t varea4 = vdupq_n_f32(barea);
+        const float32x4_t zero4 = vdupq_n_f32(0.0F), eps4 = vdupq_n_f32(kIouEps);
+        for (; k + 4 <= m; k += 4) {
+            const float32x4_t iw4 = vmaxq_f32(vsubq_f32(vminq_f32(vld1q_f32(x1 + k), vx14),
+                                                        vmaxq_f32(vld1q_f32(x0 + k), vx04)), zero4);
+            const float32x4_t ih4 = vmaxq_f32(vsubq_f32(vminq_f32(vld1q_f32(y1 + k), vy14),
+                                                        vmaxq_f32(vld1q_f32(y0 + k), vy04)), zero4);
+            const float32x4_t inter4 = vmulq_f32(iw4, ih4);
+            const float32x4_t denom4 = vaddq_f32(vsubq_f32(vaddq_f32(varea4, vld1q_f32(area + k)), inter4), eps4);
+            const uint32x4_t valid4 = vcgtq_f32(inter4, zero4);
+            const float32x4_t iou4 = vdivq_f32(inter4, denom4);
+            vst1q_f32(out + k, vreinterpretq_f32_u32(vandq_u32(valid4, vreinterpretq_u32_f32(iou4))));
+        }
+#endif
+    }
+    for (; k < m; ++k) {
+        const float iw = std::max(0.0F, std::min(x1[k], bx1) - std::max(x0[k], bx0));
+        const float ih = std::max(0.0F, std::min(y1[k], by1) - std::max(y0[k], by0));
+        const float inter = iw * ih;
+        out[k] = inter > 0.0F ? inter / (barea + area[k] - inter + kIouEps) : 0.0F;
+    }
+}
+
+float AffinityMatrix::dot(const float *a, const float *b, int dim) const {
+    const size_t n = static_cast<size_t>(dim);
+    return use_simd_ ? simd::Dot(a, b, n) : simd::DotScalar(a, b, n);
+}
+
+void AffinityMatrix::compute(TrackerInnerView left, std::span<const TrackerInner> right, const MatcherConfig &cfg) {
+    rows_ = static_cast<int>(left.size());
+    cols_ = static_cast<int>(right.size());
+    evaluated_pairs_ = 0;
+    entry_start_.assign(static_cast<size_t>(rows_) + 1, 0);
+    entry_col_.clear();
+    entry_score_.clear();
+    if (rows_ == 0 || cols_ == 0) return;
+
+    const float norm = cfg.iou_weight + cfg.feature_weight;
+    const float wi = cfg.iou_weight / norm;
+    const float wf = cfg.feature_weight / norm;
+    const float log_threshold = cfg.threshold > 0.0F ? std::log(cfg.threshold)
+                                                     : -std::numeric_limits<float>::infinity();
+
+    // 1) 门控：只有几何项能让得分归零时才是无损的；否则所有组合都是候选
+    const bool gated = cfg.gating && wi > 0.0F && cfg.threshold > 0.0F;
+    const size_t m = static_cast<size_t>(cols_);
+    size_t candidate_count = static_cast<size_t>(rows_) * m;
+    if (gated) {
+        gate_.build(left, right, cfg.gate_margin);
+        candidate_count = gate_.candidates().size();
+        if (candidate_count == 0) return;
+    }
+
+    // 2) 外观：归一化打包；候选足够稠密时一次 GEMM 比逐对点积更快。
+    //    两侧都是定长 OSNet 特征（单位范数）且候选稀疏时不打包，逐对直接走定长点积；
+    //    量化存储的特征不解码打包，直接逐对在量化表示上计算余弦
+    auto isFloat = [](const TrackerInner &t) { return t.feature.storage() == FeatureStorage::Float32; };
+    auto isFixed = [](const TrackerInner &t) { return t.feature.osnet() != nullptr; };
+    bool all_float = std::all_of(right.begin(), right.end(), isFloat);
+    for (size_t i = 0; all_float && i < left.size(); ++i) all_float = isFloat(left[i]);
+    bool all_fixed = all_float && std::all_of(right.begin(), right.end(), isFixed);
+    for (size_t i = 0; all_fixed && i < left.size(); ++i) all_fixed = isFixed(left[i]);
+    const int dim = static_cast<int>(left.front().feature.size());
+    const bool use_gemm = all_float && (!gated || candidate_count * 4 >= static_cast<size_t>(rows_) * m);
+    const bool fixed_dot = all_fixed && use_simd_ && !use_gemm;
+    const bool packed = all_float && !fixed_dot;
+    if (packed) {
+        packFeatures(left, dim, left_feat_);
+        packFeatures(right, dim, right_feat_);
+    }
+    if (use_gemm) {
+        cv::gemm(left_feat_, right_feat_, 1.0, cv::Mat(), 0.0, cosine_, cv::GEMM_2_T);
+    }
+
+    // 3) 右侧框转为 SoA，供 IoU 内核使用
+    rx0_.resize(m);
+    ry0_.resize(m);
+    rx1_.resize(m);
+    ry1_.resize(m);
+    rarea_.resize(m);
+    for (size_t j = 0; j < m; ++j) {
+        const cv::Rect2f &r = right[j].box.box;
+        rx0_[j] = r.x;
+        ry0_[j] = r.y;
+        rx1_[j] = r.x + r.width;
+        ry1_[j] = r.y + r.height;
+        rarea_[j] = r.area();
+    }
+
+    // 4) 逐行计算 IoU，再在对数域融合：log w = wi*log(iou) + wf*log(cos01)，只有达到阈值的单元才做 exp
+    entry_col_.reserve(gated ? candidate_count : m);
+    entry_score_.reserve(gated ? candidate_count : m);
+    for (int i = 0; i < rows_; ++i) {
+        const int *cand = nullptr;
+        size_t count = m;
+        if (gated) {
+            cand = gate_.candidates().data() + gate_.rowBegin(i);
+            count = static_cast<size_t>(gate_.rowEnd(i) - gate_.rowBegin(i));
+            gx0_.resize(count);
+            gy0_.resize(count);
+            gx1_.resize(count);
+            gy1_.resize(count);
+            garea_.resize(count);
+            for (size_t k = 0; k < count; ++k) {
+                const size_t j = static_cast<size_t>(cand[k]);
+                gx0_[k] = rx0_[j];
+                gy0_[k] = ry0_[j];
+                gx1_[k] = rx1_[j];
+                gy1_[k] = ry1_[j];
+                garea_[k] = rarea_[j];
+            }
+            computeIouRow(left[static_cast<size_t>(i)].box, gx0_.data(), gy0_.data(), gx1_.data(), gy1_.data(),
+                          garea_.data(), count);
+        } else {
+            computeIouRow(left[static_cast<size_t>(i)].box, rx0_.data(), ry0_.data(), rx1_.data(), ry1_.data(),
+                          rarea_.data(), count);
+        }
+        evaluated_pairs_ += count;
+
+        const float *left_row = packed ? left_feat_.ptr<float>(i) : nullptr;
+        for (size_t k = 0; k < count; ++k) {
+            const int j = cand ? cand[k] : static_cast<int>(k);
+            const float iou = iou_row_[k];
+            float log_w = 0.0F;
+            if (iou <= 0.0F && wi > 0.0F) {
+                log_w = -std::numeric_limits<float>::infinity();
+            } else {
+                float cos = 0.0F;
+                if (use_gemm) {
+                    cos = cosine_.ptr<float>(i)[j];
+                } else if (fixed_dot) {
+                    cos = left[static_cast<size_t>(i)].feature.osnet()->dot(*right[static_cast<size_t>(j)].feature.osnet());
+                } else if (packed) {
+                    cos = dot(left_row, right_feat_.ptr<float>(j), dim);
+                } else {
+                    cos = left[static_cast<size_t>(i)].feature.cosine_similarity(right[static_cast<size_t>(j)].feature);
+                }
+                // 余弦相似度 [-1,1] 映射到 [0,1]；钳制以吸收归一化带来的舍入误差
+                const float cos01 = std::clamp(0.5F * (cos + 1.0F), 0.0F, 1.0F);
+                log_w = LogTerm(iou, wi) + LogTerm(cos01, wf);
+            }
+            if (log_w >= log_threshold) {
+                entry_col_.push_back(j);
+                entry_score_.push_back(std::exp(log_w));
+            }
+        }
+        entry_start_[static_cast<size_t>(i) + 1] = static_cast<int>(entry_col_.size());
+    }
+}
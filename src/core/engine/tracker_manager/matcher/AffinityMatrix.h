@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "AssociationGate.h"
+#include "IMatcher.h"
+
+// 两组 TrackerInner 之间的关联得分（IoU 与特征余弦的几何加权，与 WeightedMatchScore 等价），
+// 只保留达到阈值的组合，按行输出为稀疏列表（CSR）：
+// - 门控：几何权重为正且阈值为正时，IoU = 0 的组合得分必为 0，先用 AssociationGate 过滤
+// - 外观：两侧特征各自归一化后按行打包；候选稠密时一次 GEMM，稀疏时逐对 SIMD 点积
+//   （两侧都是定长 OsnetFeature 且候选稀疏时不打包，直接逐对定长点积）
+// - 量化存储（Float16/Int8）的特征不打包，逐对直接在量化表示上计算余弦
+// - 几何：候选框转为 SoA，逐行用 SIMD 计算 IoU
+// - 加权在对数域融合 w = exp(wi*log(iou) + wf*log(cos01))，未达阈值的单元不做 exp
+// 所有缓冲在帧间复用。
+class AffinityMatrix {
+public:
+    void setUseSimd(bool enable) { use_simd_ = enable; }
+
+    // 计算 left x right 中所有达到阈值的组合（行号为 left 视图内的行号）
+    void compute(TrackerInnerView left, std::span<const TrackerInner> right, const MatcherConfig &cfg);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    // 第 i 行的候选为下标 [rowBegin(i), rowEnd(i))，同一行内按列升序
+    int rowBegin(int i) const { return entry_start_[static_cast<size_t>(i)]; }
+    int rowEnd(int i) const { return entry_start_[static_cast<size_t>(i) + 1]; }
+    int col(int k) const { return entry_col_[static_cast<size_t>(k)]; }
+    float score(int k) const { return entry_score_[static_cast<size_t>(k)]; }
+    // 门控后实际计算过得分的组合数（用于统计/基准）
+    size_t evaluatedPairs() const { return evaluated_pairs_; }
+
+private:
+    // 把一组特征归一化后逐行写入 packed（rows x dim，CV_32F）
+    static void packFeatures(TrackerInnerView items, int dim, cv::Mat &packed);
+    // 计算 box 与 count 个 SoA 框的 IoU，写入 iou_row_
+    void computeIouRow(const BBox &box, const float *x0, const float *y0, const float *x1, const float *y1,
+                       const float *area, size_t count);
+    // 两个单位向量的点积
+    float dot(const float *a, const float *b, int dim) const;
+
+    bool use_simd_ = true;
+    int rows_ = 0;
+    int cols_ = 0;
+    size_t evaluated_pairs_ = 0;
+
+    AssociationGate gate_;
+    cv::Mat left_feat_;
+    cv::Mat right_feat_;
+    cv::Mat cosine_;
+
+    // 右侧框的 SoA 表示，以及门控后逐行收集的候选 SoA
+    std::vector<float> rx0_, ry0_, rx1_, ry1_, rarea_;
+    std::vector<float> gx0_, gy0_, gx1_, gy1_, garea_;
+    std::vector<float> iou_row_;
+
+    std::vector<int> entry_start_;
+    std::vector<int> entry_col_;
+    std::vector<float> entry_score_;
+};
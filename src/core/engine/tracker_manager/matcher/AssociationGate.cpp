@@ -0,0 +1,124 @@
+#include "AssociationGate.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 网格单边最多的单元数（框分布极稀疏时避免网格过大）
+constexpr int kMaxGridCells = 64;
+
+int CellIndex(float v, float origin, float cell, int count) {
+    const int c = static_cast<int>(std::floor((v - origin) / cell));
+    return std::clamp(c, 0, count - 1);
+}
+}  // namespace
+
+void AssociationGate::buildGrid(std::span<const TrackerInner> right) {
+    const size_t n = right.size();
+    x0_.resize(n);
+    y0_.resize(n);
+    x1_.resize(n);
+    y1_.resize(n);
+
+    float min_x = 0.0F, min_y = 0.0F, max_x = 0.0F, max_y = 0.0F;
+    double size_sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const cv::Rect2f &r = right[i].box.box;
+        x0_[i] = r.x;
+        y0_[i] = r.y;
+        x1_[i] = r.x + r.width;
+        y1_[i] = r.y + r.height;
+        if (i == 0) {
+            min_x = x0_[i];
+            min_y = y0_[i];
+            max_x = x1_[i];
+            max_y = y1_[i];
+        } else {
+            min_x = std::min(min_x, x0_[i]);
+            min_y = std::min(min_y, y0_[i]);
+            max_x = std::max(max_x, x1_[i]);
+            max_y = std::max(max_y, y1_[i]);
+        }
+        size_sum += std::max(r.width, r.height);
+    }
+
+    // 单元边长取平均框尺寸：一个框通常只覆盖 1~4 个单元
+    const float extent = std::max(max_x - min_x, max_y - min_y);
+    const float mean_size = n > 0 ? static_cast<float>(size_sum / static_cast<double>(n)) : 1.0F;
+    cell_size_ = std::max({mean_size, extent / static_cast<float>(kMaxGridCells), 1.0F});
+    grid_x0_ = min_x;
+    grid_y0_ = min_y;
+    grid_cols_ = std::clamp(static_cast<int>((max_x - min_x) / cell_size_) + 1, 1, kMaxGridCells + 1);
+    grid_rows_ = std::clamp(static_cast<int>((max_y - min_y) / cell_size_) + 1, 1, kMaxGridCells + 1);
+
+    // 两遍计数排序把 (单元, 框) 写成 CSR，避免每个单元一个 vector
+    const size_t cell_count = static_cast<size_t>(grid_cols_ * grid_rows_);
+    cell_start_.assign(cell_count + 1, 0);
+    auto forEachCell = [&](size_t i, auto &&fn) {
+        const int cx0 = CellIndex(x0_[i], grid_x0_, cell_size_, grid_cols_);
+        const int cx1 = CellIndex(x1_[i], grid_x0_, cell_size_, grid_cols_);
+        const int cy0 = CellIndex(y0_[i], grid_y0_, cell_size_, grid_rows_);
+        const int cy1 = CellIndex(y1_[i], grid_y0_, cell_size_, grid_rows_);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) fn(static_cast<size_t>(cy * grid_cols_ + cx));
+        }
+    };
+    for (size_t i = 0; i < n; ++i) {
+        forEachCell(i, [&](size_t c) { ++cell_start_[c + 1]; });
+    }
+    for (size_t c = 0; c < cell_count; ++c) cell_start_[c + 1] += cell_start_[c];
+    cell_items_.resize(static_cast<size_t>(cell_start_[cell_count]));
+    cell_fill_.assign(cell_count, 0);
+    for (size_t i = 0; i < n; ++i) {
+        forEachCell(i, [&](size_t c) {
+            cell_items_[static_cast<size_t>(cell_start_[c] + cell_fill_[c]++)] = static_cast<int>(i);
+        });
+    }
+
+    visit_stamp_.assign(n, 0);
+    stamp_ = 0;
+}
+
+void AssociationGate::build(TrackerInnerView left, std::span<const TrackerInner> right, float margin) {
+    row_start_.assign(left.size() + 1, 0);
+    candidates_.clear();
+    if (left.empty() || right.empty()) return;
+
+    buildGrid(right);
+
+    for (size_t i = 0; i < left.size(); ++i) {
+        const cv::Rect2f &r = left[i].box.box;
+        const float mx = margin * r.width, my = margin * r.height;
+        const float qx0 = r.x - mx, qy0 = r.y - my;
+        const float qx1 = r.x + r.width + mx, qy1 = r.y + r.height + my;
+
+        if (++stamp_ == 0) {
+            std::fill(visit_stamp_.begin(), visit_stamp_.end(), 0);
+            stamp_ = 1;
+        }
+        const size_t row_begin = candidates_.size();
+
+        // 两个框有正面积交集时，交集内任一点所在的单元同时被两者覆盖
+        const int cx0 = CellIndex(qx0, grid_x0_, cell_size_, grid_cols_);
+        const int cx1 = CellIndex(qx1, grid_x0_, cell_size_, grid_cols_);
+        const int cy0 = CellIndex(qy0, grid_y0_, cell_size_, grid_rows_);
+        const int cy1 = CellIndex(qy1, grid_y0_, cell_size_, grid_rows_);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                const size_t c = static_cast<size_t>(cy * grid_cols_ + cx);
+                for (int e = cell_start_[c]; e < cell_start_[c + 1]; ++e) {
+                    const int j = cell_items_[static_cast<size_t>(e)];
+                    const size_t sj = static_cast<size_t>(j);
+                    if (visit_stamp_[sj] == stamp_) continue;
+                    visit_stamp_[sj] = stamp_;
+                    // 与 IoU 内核相同的相交判定，margin = 0 时候选与 IoU > 0 完全一致
+                    const float iw = std::min(x1_[sj], qx1) - std::max(x0_[sj], qx0);
+                    const float ih = std::min(y1_[sj], qy1) - std::max(y0_[sj], qy0);
+                    if (iw > 0.0F && ih > 0.0F) candidates_.push_back(j);
+                }
+            }
+        }
+        std::sort(candidates_.begin() + static_cast<std::ptrdiff_t>(row_begin), candidates_.end());
+        row_start_[i + 1] = static_cast<int>(candidates_.size());
+    }
+}
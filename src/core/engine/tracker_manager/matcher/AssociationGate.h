@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../Tracker.h"
+#include "TrackerInnerView.h"
+
+// 关联前的空间门控：把右侧框按均匀网格做空间哈希，左侧每个框（按 margin 外扩）
+// 只收集与其真正相交的右侧框，输出按行组织的稀疏候选列表（CSR）。
+// margin = 0 时候选恰为 IoU > 0 的全部组合；查询代价随局部密度而非 left x right 增长。
+class AssociationGate {
+public:
+    // margin 为外扩比例：左侧框四周各外扩 margin * (w, h)
+    void build(TrackerInnerView left, std::span<const TrackerInner> right, float margin);
+
+    int rows() const { return static_cast<int>(row_start_.size()) - 1; }
+    // 第 i 行的候选为 candidates()[rowBegin(i), rowEnd(i))，同一行内按列升序
+    int rowBegin(int i) const { return row_start_[static_cast<size_t>(i)]; }
+    int rowEnd(int i) const { return row_start_[static_cast<size_t>(i) + 1]; }
+    const std::vector<int> &candidates() const { return candidates_; }
+
+private:
+    void buildGrid(std::span<const TrackerInner> right);
+
+    // 右侧框的 SoA 坐标（x1/y1 为右下角）
+    std::vector<float> x0_, y0_, x1_, y1_;
+
+    // 网格（CSR）：单元 c 内的框为 cell_items_[cell_start_[c], cell_start_[c + 1])
+    float grid_x0_ = 0.0F;
+    float grid_y0_ = 0.0F;
+    float cell_size_ = 1.0F;
+    int grid_cols_ = 1;
+    int grid_rows_ = 1;
+    std::vector<int> cell_start_;
+    std::vector<int> cell_fill_;
+    std::vector<int> cell_items_;
+
+    std::vector<uint32_t> visit_stamp_;
+    uint32_t stamp_ = 0;
+
+    std::vector<int> row_start_;
+    std::vector<int> candidates_;
+};
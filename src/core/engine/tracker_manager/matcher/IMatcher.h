@@ -1,23 +1,49 @@
 #pragma once
 
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "../Tracker.h"
+#include "TrackerInnerView.h"
+
+// 匹配器类型
+enum class MatcherType {
+    Greedy = 0,  // 按得分降序贪心一对一分配
+    Lap = 1,     // 线性分配（LAPJV），总得分最大
+};
 
 struct MatcherConfig {
+    MatcherType type = MatcherType::Greedy;
     float iou_weight = 0.5f;
     float feature_weight = 0.5f;
     float threshold = 0.5f;  // 加权得分达到阈值视为匹配
+    bool gating = true;      // 关联前用空间门控跳过不相交的组合（几何权重与阈值为正时结果不变）
+    float gate_margin = 0.0f;  // 门控时左侧框四周外扩的比例（相对自身宽高）
 };
 
+// 匹配结果：(left 序号, right 序号) 列表，由调用方指定的内存资源（通常为帧级 arena）分配
+using MatchList = std::pmr::vector<std::pair<int, int>>;
+
 class IMatcher {
 public:
     virtual ~IMatcher() = default;
     
-    // 对输入的两组 TrackerInner 进行匹配，输出匹配成功的序号对列表
-    virtual std::vector<std::pair<int, int>> match(
-        const std::vector<TrackerInner>& left,
-        const std::vector<TrackerInner>& right
+    // 对输入的两组 TrackerInner 进行匹配，输出匹配成功的序号对列表（左侧序号为视图内的行号）；
+    // 结果与匹配过程中的临时容器都从 mr 分配
+    virtual MatchList match(
+        TrackerInnerView left,
+        std::span<const TrackerInner> right,
+        std::pmr::memory_resource *mr
     ) = 0;
+
+    // 使用默认（堆）内存资源
+    MatchList match(TrackerInnerView left, std::span<const TrackerInner> right) {
+        return match(left, right, std::pmr::get_default_resource());
+    }
 };
+
+// 按配置创建匹配器
+std::unique_ptr<IMatcher> CreateMatcher(const MatcherConfig &cfg);
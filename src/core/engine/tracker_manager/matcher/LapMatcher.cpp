@@ -0,0 +1,32 @@
+#include "LapMatcher.h"
+
+#include "Matcher.h"
+
+namespace {
+// 不匹配的代价：可行对的代价 1 - 得分 总是不超过它，因此最小化总代价等价于最大化匹配得分之和
+constexpr float kUnmatchedCost = 1.0F;
+}  // namespace
+
+LapMatcher::LapMatcher(const MatcherConfig &cfg) : cfg_(cfg) {
+    ValidateMatcherConfig(cfg_);
+}
+
+MatchList LapMatcher::match(TrackerInnerView left, std::span<const TrackerInner> right,
+                            std::pmr::memory_resource *mr) {
+    MatchList matches(mr);
+    const int rows = static_cast<int>(left.size());
+    const int cols = static_cast<int>(right.size());
+    if (rows == 0 || cols == 0) return matches;
+
+    // 只有达到阈值的组合作为可行边导入求解器
+    affinity_.compute(left, right, cfg_);
+    solver_.reset(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int k = affinity_.rowBegin(i); k < affinity_.rowEnd(i); ++k) {
+            solver_.addEdge(i, affinity_.col(k), 1.0F - affinity_.score(k));
+        }
+    }
+    solver_.solve(kUnmatchedCost, solved_);
+    matches.assign(solved_.begin(), solved_.end());
+    return matches;
+}
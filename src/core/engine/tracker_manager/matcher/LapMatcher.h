@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include "AffinityMatrix.h"
+#include "IMatcher.h"
+#include "LapSolver.h"
+
+// 全局最优匹配器：与 Matcher 使用相同的 IoU+特征几何加权得分，
+// 但在所有达到阈值的候选对上求"总得分最大"的一对一分配（LAPJV），
+// 避免贪心在拥挤场景里先占用次优对导致的错配。
+class LapMatcher : public IMatcher {
+public:
+    explicit LapMatcher(const MatcherConfig &cfg);
+    using IMatcher::match;
+    MatchList match(TrackerInnerView left, std::span<const TrackerInner> right,
+                    std::pmr::memory_resource *mr) override;
+
+private:
+    MatcherConfig cfg_;
+    AffinityMatrix affinity_;
+    LapSolver solver_;
+    std::vector<std::pair<int, int>> solved_;  // 复用的求解结果缓冲
+};
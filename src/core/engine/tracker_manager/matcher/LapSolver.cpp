@@ -0,0 +1,248 @@
+#include "LapSolver.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+void LapSolver::reset(int rows, int cols) {
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("LapSolver: 行列数不能为负");
+    }
+    rows_ = rows;
+    cols_ = cols;
+    edge_row_.clear();
+    edge_col_.clear();
+    edge_cost_.clear();
+}
+
+void LapSolver::addEdge(int row, int col, float cost) {
+    if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+        throw std::out_of_range("LapSolver: 边的行列索引越界");
+    }
+    edge_row_.push_back(row);
+    edge_col_.push_back(col);
+    edge_cost_.push_back(cost);
+}
+
+void LapSolver::addDense(const float *cost, int rows, int cols, size_t stride, float max_cost) {
+    for (int r = 0; r < rows; ++r) {
+        const float *row = cost + static_cast<size_t>(r) * stride;
+        for (int c = 0; c < cols; ++c) {
+            if (row[c] <= max_cost) addEdge(r, c, row[c]);
+        }
+    }
+}
+
+void LapSolver::buildRows() {
+    // 计数排序把 COO 整理成按行分组的 CSR（同一行内保持加入顺序）
+    row_start_.assign(static_cast<size_t>(rows_) + 1, 0);
+    for (int r : edge_row_) ++row_start_[static_cast<size_t>(r) + 1];
+    for (int r = 0; r < rows_; ++r) row_start_[r + 1] += row_start_[r];
+
+    const size_t edge_count = edge_row_.size();
+    csr_col_.resize(edge_count);
+    csr_cost_.resize(edge_count);
+    row_fill_.assign(static_cast<size_t>(rows_), 0);
+    for (size_t e = 0; e < edge_count; ++e) {
+        const int r = edge_row_[e];
+        const size_t pos = static_cast<size_t>(row_start_[r] + row_fill_[r]++);
+        csr_col_[pos] = edge_col_[e];
+        csr_cost_[pos] = edge_cost_[e];
+    }
+}
+
+void LapSolver::augment(int free_row, double unmatched_cost) {
+    touched_.clear();
+    scanned_.clear();
+    heap_.clear();
+
+    // 小顶堆（惰性删除）
+    auto heap_greater = [](const std::pair<double, int> &a, const std::pair<double, int> &b) {
+        return a.first > b.first;
+    };
+    auto relax = [&](int col, double d, int row, double cost) {
+        const size_t c = static_cast<size_t>(col);
+        if (state_[c] == 2) return;
+        if (state_[c] == 0) {
+            state_[c] = 1;
+            touched_.push_back(col);
+        } else if (d >= dist_[c]) {
+            return;
+        }
+        dist_[c] = d;
+        pred_[c] = row;
+        pred_cost_[c] = cost;
+        heap_.emplace_back(d, col);
+        std::push_heap(heap_.begin(), heap_.end(), heap_greater);
+    };
+    // 从某行出发松弛它的所有可行边以及它专属的"不匹配"列；h 为该行当前分配边的约化代价
+    auto relaxRow = [&](int row, double base, double h) {
+        for (int e = row_start_[row]; e < row_start_[row + 1]; ++e) {
+            const int col = csr_col_[static_cast<size_t>(e)];
+            const double cost = csr_cost_[static_cast<size_t>(e)];
+            relax(col, base + cost - v_[static_cast<size_t>(col)] - h, row, cost);
+        }
+        const int dummy = cols_ + row;
+        relax(dummy, base + unmatched_cost - v_[static_cast<size_t>(dummy)] - h, row, unmatched_cost);
+    };
+
+    relaxRow(free_row, 0.0, 0.0);
+
+    int end = -1;
+    double min_dist = 0.0;
+    while (!heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), heap_greater);
+        const auto [d, col] = heap_.back();
+        heap_.pop_back();
+        const size_t c = static_cast<size_t>(col);
+        if (state_[c] == 2 || d > dist_[c]) continue;  // 过期条目
+        state_[c] = 2;
+
+        const int row = row_of_col_[c];
+        if (row < 0) {
+            end = col;
+            min_dist = d;
+            break;
+        }
+        scanned_.push_back(col);
+        relaxRow(row, d, row_cost_[static_cast<size_t>(row)] - v_[c]);
+    }
+    if (end < 0) {
+        // 起始行专属的"不匹配"列总是可达，理论上不会发生
+        throw std::logic_error("LapSolver: 未找到增广路");
+    }
+
+    // 更新已确定列的势能，保持所有约化代价非负
+    for (int col : scanned_) {
+        v_[static_cast<size_t>(col)] += dist_[static_cast<size_t>(col)] - min_dist;
+    }
+
+    // 沿前驱回溯完成增广
+    int col = end;
+    while (true) {
+        const size_t c = static_cast<size_t>(col);
+        const int row = pred_[c];
+        const size_t r = static_cast<size_t>(row);
+        const int prev_col = col_of_row_[r];
+        row_of_col_[c] = row;
+        col_of_row_[r] = col;
+        row_cost_[r] = pred_cost_[c];
+        if (row == free_row) break;
+        col = prev_col;
+    }
+
+    for (int t : touched_) state_[static_cast<size_t>(t)] = 0;
+}
+
+void LapSolver::reduceRows(double unmatched_cost) {
+    // JV 的 augmenting row reduction：空闲行取约化代价最小的列 j1，
+    // 把 j1 的势能降到与次小列持平后抢占它，原占有者变为空闲；最多两轮
+    const size_t max_steps = 4 * static_cast<size_t>(rows_) + 16;
+    size_t steps = 0;
+    for (int pass = 0; pass < 2 && !free_rows_.empty(); ++pass) {
+        next_free_.clear();
+        size_t k = 0;
+        const size_t limit = free_rows_.size();
+        while (k < limit) {
+            const int row = free_rows_[k++];
+            const size_t r = static_cast<size_t>(row);
+
+            double umin = std::numeric_limits<double>::infinity();
+            double usub = umin;
+            int j1 = -1, j2 = -1;
+            double c1 = 0.0, c2 = 0.0;
+            auto consider = [&](int col, double cost) {
+                const double h = cost - v_[static_cast<size_t>(col)];
+                if (h >= usub) return;
+                if (h >= umin) {
+                    usub = h;
+                    j2 = col;
+                    c2 = cost;
+                } else {
+                    usub = umin;
+                    j2 = j1;
+                    c2 = c1;
+                    umin = h;
+                    j1 = col;
+                    c1 = cost;
+                }
+            };
+            for (int e = row_start_[row]; e < row_start_[row + 1]; ++e) {
+                consider(csr_col_[static_cast<size_t>(e)], csr_cost_[static_cast<size_t>(e)]);
+            }
+            consider(cols_ + row, unmatched_cost);
+
+            int owner = row_of_col_[static_cast<size_t>(j1)];
+            const bool lowers = j2 >= 0 && umin < usub;
+            if (lowers) {
+                v_[static_cast<size_t>(j1)] -= usub - umin;
+            } else if (owner >= 0 && j2 >= 0) {
+                j1 = j2;
+                c1 = c2;
+                owner = row_of_col_[static_cast<size_t>(j2)];
+            }
+
+            if (owner >= 0) col_of_row_[static_cast<size_t>(owner)] = -1;
+            row_of_col_[static_cast<size_t>(j1)] = row;
+            col_of_row_[r] = j1;
+            row_cost_[r] = c1;
+
+            if (owner >= 0) {
+                if (lowers && ++steps < max_steps) {
+                    free_rows_[--k] = owner;  // 立即重新处理被挤出的行
+                } else {
+                    next_free_.push_back(owner);
+                }
+            }
+        }
+        free_rows_.swap(next_free_);
+    }
+}
+
+void LapSolver::solve(float unmatched_cost, std::vector<std::pair<int, int>> &matches) {
+    matches.clear();
+    if (rows_ == 0) return;
+
+    buildRows();
+    const size_t total_cols = static_cast<size_t>(cols_ + rows_);
+    v_.assign(total_cols, 0.0);
+    row_of_col_.assign(total_cols, -1);
+    col_of_row_.assign(static_cast<size_t>(rows_), -1);
+    row_cost_.assign(static_cast<size_t>(rows_), 0.0);
+    dist_.resize(total_cols);
+    pred_.resize(total_cols);
+    pred_cost_.resize(total_cols);
+    state_.assign(total_cols, 0);
+
+    const double unmatched = static_cast<double>(unmatched_cost);
+
+    // 初始化：势能全为 0 时，每行最便宜的列若仍空闲就直接分配（不破坏最优性条件）
+    for (int r = 0; r < rows_; ++r) {
+        int best_col = cols_ + r;
+        double best_cost = unmatched;
+        for (int e = row_start_[r]; e < row_start_[r + 1]; ++e) {
+            if (csr_cost_[static_cast<size_t>(e)] < best_cost) {
+                best_cost = csr_cost_[static_cast<size_t>(e)];
+                best_col = csr_col_[static_cast<size_t>(e)];
+            }
+        }
+        if (row_of_col_[static_cast<size_t>(best_col)] < 0) {
+            row_of_col_[static_cast<size_t>(best_col)] = r;
+            col_of_row_[static_cast<size_t>(r)] = best_col;
+            row_cost_[static_cast<size_t>(r)] = best_cost;
+        }
+    }
+
+    // 增广行约简：廉价地处理大部分冲突，剩余空闲行再做最短增广
+    free_rows_.clear();
+    for (int r = 0; r < rows_; ++r) {
+        if (col_of_row_[static_cast<size_t>(r)] < 0) free_rows_.push_back(r);
+    }
+    reduceRows(unmatched);
+    for (int r : free_rows_) augment(r, unmatched);
+
+    for (int r = 0; r < rows_; ++r) {
+        const int c = col_of_row_[static_cast<size_t>(r)];
+        if (c >= 0 && c < cols_) matches.emplace_back(r, c);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// 稀疏线性分配求解器（Jonker-Volgenant 最短增广路，Dijkstra + 列势能）：
+// - 只有显式加入的 (row, col, cost) 边可被分配，其余组合视为不可行
+// - 每一行都可以选择不匹配，代价为 unmatched_cost；因此结果是"总代价最小"的部分匹配
+// - 每次增广只访问从当前行可达的局部子图，代价随局部密度而非 rows x cols 增长
+// 所有内部缓冲在多次求解之间复用。
+class LapSolver {
+public:
+    // 开始一个 rows x cols 的新问题（清空已有的边，保留容量）
+    void reset(int rows, int cols);
+    // 加入一条可行边；同一 (row, col) 重复加入时以较小代价为准
+    void addEdge(int row, int col, float cost);
+    // 从稠密代价矩阵（行主序，stride 为每行元素数）导入代价不超过 max_cost 的边
+    void addDense(const float *cost, int rows, int cols, size_t stride, float max_cost);
+
+    // 求解并输出 (row, col) 匹配对（按 row 升序）；要求所有边代价 <= unmatched_cost
+    void solve(float unmatched_cost, std::vector<std::pair<int, int>> &matches);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+private:
+    void buildRows();
+    // 增广行约简（JV 初始化阶段），处理后 free_rows_ 为仍空闲的行
+    void reduceRows(double unmatched_cost);
+    // 从空闲行 free_row 出发找一条最短增广路并完成增广
+    void augment(int free_row, double unmatched_cost);
+
+    int rows_ = 0;
+    int cols_ = 0;
+
+    // 以 COO 形式收集边，求解前按行整理为 CSR
+    std::vector<int> edge_row_;
+    std::vector<int> edge_col_;
+    std::vector<float> edge_cost_;
+    std::vector<int> row_start_;
+    std::vector<int> csr_col_;
+    std::vector<double> csr_cost_;
+    std::vector<int> row_fill_;
+
+    // 列 [0, cols_) 为真实列，列 cols_ + r 为第 r 行专属的"不匹配"列
+    std::vector<double> v_;            // 列势能
+    std::vector<int> row_of_col_;      // 列当前分配到的行（-1 表示空闲）
+    std::vector<int> col_of_row_;      // 行当前分配到的列
+    std::vector<double> row_cost_;     // 行当前分配边的原始代价
+    std::vector<int> free_rows_;
+    std::vector<int> next_free_;
+
+    // 增广过程中的临时状态（只重置被访问过的列）
+    std::vector<double> dist_;
+    std::vector<int> pred_;
+    std::vector<double> pred_cost_;    // 前驱边的原始代价
+    std::vector<char> state_;          // 0 未访问，1 已入堆，2 已确定
+    std::vector<int> touched_;
+    std::vector<int> scanned_;
+    std::vector<std::pair<double, int>> heap_;
+};
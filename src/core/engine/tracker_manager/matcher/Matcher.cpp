@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 #include <cmath>
 
@@ -9,39 +10,50 @@ namespace {
 // 计算 IoU，直接复用 BBox 的 & 运算符
 float IoU(const BBox &a, const BBox &b) { return a & b; }
 
-// 余弦相似度，已在 Feature 内实现
-float Cosine(const Feature &a, const Feature &b) { return a.cosine_similarity(b); }
+// 余弦相似度，已在 TrackFeature 内实现
+float Cosine(const TrackFeature &a, const TrackFeature &b) { return a.cosine_similarity(b); }
 }
 
-Matcher::Matcher(const MatcherConfig &cfg) : cfg_(cfg) {
-    const float sum = cfg_.iou_weight + cfg_.feature_weight;
+void ValidateMatcherConfig(const MatcherConfig &cfg) {
+    const float sum = cfg.iou_weight + cfg.feature_weight;
     if (sum <= 1e-6f) {
         throw std::invalid_argument("Matcher: 权重之和不能为 0");
     }
-    norm_ = sum;
 }
 
-std::vector<std::pair<int, int>> Matcher::match(const std::vector<TrackerInner> &left,
-                                               const std::vector<TrackerInner> &right) {
-    std::vector<std::tuple<float, int, int>> scores;  // (score, i, j)
-    scores.reserve(left.size() * right.size());
-
-    for (int i = 0; i < static_cast<int>(left.size()); ++i) {
-        for (int j = 0; j < static_cast<int>(right.size()); ++j) {
-            const float iou = IoU(left[i].box, right[j].box);
-            float cos = Cosine(left[i].feature, right[j].feature);
-            // 余弦相似度 [-1,1] 映射到 [0,1]，避免负值导致匹配异常
-            cos = 0.5f * (cos + 1.0f);
-
-            // 改为几何加权平均
-            const float wi = cfg_.iou_weight / norm_;
-            const float wf = cfg_.feature_weight / norm_;
-            // 几何加权平均：当iou或cos接近0时会导致整体分数接近0
-            const float w = std::pow(iou, wi) * std::pow(cos, wf);
-            if (w >= cfg_.threshold) {
-                // 将满足阈值条件的匹配分数和索引加入候选列表
-                scores.emplace_back(w, i, j);
-            }
+float WeightedMatchScore(const TrackerInner &a, const TrackerInner &b, const MatcherConfig &cfg) {
+    const float norm = cfg.iou_weight + cfg.feature_weight;
+    const float iou = IoU(a.box, b.box);
+    float cos = Cosine(a.feature, b.feature);
+    // 余弦相似度 [-1,1] 映射到 [0,1]，避免负值导致匹配异常
+    cos = 0.5f * (cos + 1.0f);
+
+    // 改为几何加权平均
+    const float wi = cfg.iou_weight / norm;
+    const float wf = cfg.feature_weight / norm;
+    // 几何加权平均：当iou或cos接近0时会导致整体分数接近0
+    return std::pow(iou, wi) * std::pow(cos, wf);
+}
+
+Matcher::Matcher(const MatcherConfig &cfg) : cfg_(cfg) {
+    ValidateMatcherConfig(cfg_);
+}
+
+MatchList Matcher::match(TrackerInnerView left, std::span<const TrackerInner> right,
+                         std::pmr::memory_resource *mr) {
+    affinity_.compute(left, right, cfg_);
+
+    // 候选数已知，一次性预留，临时容器都从 mr 分配
+    size_t candidate_count = 0;
+    for (int i = 0; i < affinity_.rows(); ++i) {
+        candidate_count += static_cast<size_t>(affinity_.rowEnd(i) - affinity_.rowBegin(i));
+    }
+    std::pmr::vector<std::tuple<float, int, int>> scores(mr);  // (score, i, j)
+    scores.reserve(candidate_count);
+    for (int i = 0; i < affinity_.rows(); ++i) {
+        // 只有满足阈值条件的组合会出现在候选列表中
+        for (int k = affinity_.rowBegin(i); k < affinity_.rowEnd(i); ++k) {
+            scores.emplace_back(affinity_.score(k), i, affinity_.col(k));
         }
     }
 
@@ -50,8 +62,9 @@ std::vector<std::pair<int, int>> Matcher::match(const std::vector<TrackerInner>
         return std::get<0>(a) > std::get<0>(b);
     });
 
-    std::vector<char> used_left(left.size(), 0), used_right(right.size(), 0);
-    std::vector<std::pair<int, int>> matches;
+    std::pmr::vector<char> used_left(left.size(), 0, mr), used_right(right.size(), 0, mr);
+    MatchList matches(mr);
+    matches.reserve(std::min(left.size(), right.size()));
     for (const auto &[score, i, j] : scores) {
         if (used_left[i] || used_right[j]) continue;
         used_left[i] = used_right[j] = 1;
@@ -2,16 +2,23 @@
 
 #include <vector>
 
+#include "AffinityMatrix.h"
 #include "IMatcher.h"
 
+// 检查权重配置是否合法（权重之和不能为 0）
+void ValidateMatcherConfig(const MatcherConfig &cfg);
+// IoU 与特征余弦相似度的几何加权得分，范围 [0,1]（逐对标量版本，批量计算见 AffinityMatrix）
+float WeightedMatchScore(const TrackerInner &a, const TrackerInner &b, const MatcherConfig &cfg);
+
 // IoU+特征余弦加权匹配器
 class Matcher : public IMatcher {
 public:
     explicit Matcher(const MatcherConfig &cfg);
-    std::vector<std::pair<int, int>> match(const std::vector<TrackerInner> &left,
-                                          const std::vector<TrackerInner> &right) override;
+    using IMatcher::match;
+    MatchList match(TrackerInnerView left, std::span<const TrackerInner> right,
+                    std::pmr::memory_resource *mr) override;
 
 private:
     MatcherConfig cfg_;
-    float norm_ = 1.0f;
+    AffinityMatrix affinity_;
 };
@@ -0,0 +1,16 @@
+#include "IMatcher.h"
+
+#include <stdexcept>
+
+#include "LapMatcher.h"
+#include "Matcher.h"
+
+std::unique_ptr<IMatcher> CreateMatcher(const MatcherConfig &cfg) {
+    switch (cfg.type) {
+        case MatcherType::Greedy:
+            return std::make_unique<Matcher>(cfg);
+        case MatcherType::Lap:
+            return std::make_unique<LapMatcher>(cfg);
+    }
+    throw std::invalid_argument("CreateMatcher: 未知的匹配器类型");
+}
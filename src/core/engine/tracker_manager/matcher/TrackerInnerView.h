@@ -0,0 +1,34 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "../Tracker.h"
+
+// 匹配左侧输入的只读视图：要么是整段 TrackerInner，要么是按下标挑出的子集（第 k 行为 items[rows[k]]）。
+// 用于只让部分轨迹参与匹配而不拷贝它们（TrackerInner 含完整特征向量）；
+// 匹配结果中的左侧序号是视图内的行号，由调用方按 rows 映射回原下标。
+class TrackerInnerView {
+public:
+    TrackerInnerView() = default;
+    TrackerInnerView(std::span<const TrackerInner> items) : items_(items) {}
+    template <typename Range>
+        requires std::convertible_to<const Range &, std::span<const TrackerInner>>
+    TrackerInnerView(const Range &items) : items_(items) {}
+    // 下标子集视图：rows 为空表示没有任何行参与
+    TrackerInnerView(std::span<const TrackerInner> items, std::span<const int> rows)
+        : items_(items), rows_(rows), indexed_(true) {}
+
+    size_t size() const { return indexed_ ? rows_.size() : items_.size(); }
+    bool empty() const { return size() == 0; }
+    const TrackerInner &operator[](size_t k) const {
+        return indexed_ ? items_[static_cast<size_t>(rows_[k])] : items_[k];
+    }
+    const TrackerInner &front() const { return (*this)[0]; }
+
+private:
+    std::span<const TrackerInner> items_;
+    std::span<const int> rows_;
+    bool indexed_ = false;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// 按 Align 字节对齐分配的标准分配器（用于 SIMD 对齐加载的数据，如特征向量）
+template <typename T, size_t Align = 64>
+class AlignedAllocator {
+public:
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Align 必须是 2 的幂且不小于 alignof(T)");
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align> &) noexcept {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T *p, size_t) noexcept { ::operator delete(p, std::align_val_t(Align)); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align> &) const noexcept { return true; }
+};
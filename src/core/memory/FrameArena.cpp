@@ -0,0 +1,43 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+
+void *FrameArena::CountingResource::do_allocate(size_t bytes, size_t alignment) {
+    ++allocations;
+    this->bytes += bytes;
+    return next_->allocate(bytes, alignment);
+}
+
+void FrameArena::CountingResource::do_deallocate(void *p, size_t bytes, size_t alignment) {
+    next_->deallocate(p, bytes, alignment);
+}
+
+bool FrameArena::CountingResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+FrameArena::FrameArena(size_t initial_bytes) : capacity_(std::max<size_t>(initial_bytes, 1024)) {
+    rebuild();
+}
+
+void FrameArena::rebuild() {
+    buffer_ = std::make_unique<std::byte[]>(capacity_);
+    monotonic_ = std::make_unique<std::pmr::monotonic_buffer_resource>(buffer_.get(), capacity_, &upstream_);
+    counting_.setNext(monotonic_.get());
+}
+
+void FrameArena::reset() {
+    // 本帧向堆申请过内存，说明预留缓冲不够：按峰值扩大（留一半余量，吸收对齐填充），之后的帧就不再触碰堆
+    if (upstream_.allocations > 0) {
+        const size_t peak = std::max(counting_.bytes, capacity_);
+        monotonic_.reset();
+        capacity_ = peak + peak / 2;
+        rebuild();
+    } else {
+        monotonic_->release();
+    }
+    counting_.allocations = 0;
+    counting_.bytes = 0;
+    upstream_.allocations = 0;
+    upstream_.bytes = 0;
+}
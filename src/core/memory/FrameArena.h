@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// 帧级内存池：每帧的临时容器（std::pmr::vector 等）都从这里分配，帧结束时整体 reset。
+// - 底层为 std::pmr::monotonic_buffer_resource：分配只移动指针，释放是空操作
+// - 预留缓冲不足时才向上游（堆）申请；reset 时若本帧超出预留，缓冲按峰值扩大，
+//   稳定后每帧对堆的调用次数为 0
+// - 统计本帧的分配请求数与上游调用数，便于观测每帧的分配开销
+// 非线程安全：每个 FrameArena 只应由一个线程使用（与组件的线程归属一致）。
+class FrameArena {
+public:
+    explicit FrameArena(size_t initial_bytes = 64 * 1024);
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    // 本帧容器使用的内存资源
+    std::pmr::memory_resource *resource() { return &counting_; }
+
+    // 释放本帧的全部内存（调用前所有从本 arena 分配的容器都必须已析构）
+    void reset();
+
+    // 本帧（上次 reset 之后）向 arena 发起的分配次数
+    size_t frameAllocations() const { return counting_.allocations; }
+    // 本帧 arena 向上游（堆）申请内存的次数；稳定状态下应为 0
+    size_t frameUpstreamAllocations() const { return upstream_.allocations; }
+    // 本帧分配的字节数
+    size_t frameBytes() const { return counting_.bytes; }
+    // 预留缓冲大小（字节）
+    size_t capacity() const { return capacity_; }
+
+private:
+    // 只做计数、把请求转发给 next 的内存资源
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::pmr::memory_resource *next) : next_(next) {}
+        void setNext(std::pmr::memory_resource *next) { next_ = next; }
+
+        size_t allocations = 0;
+        size_t bytes = 0;
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+        std::pmr::memory_resource *next_;
+    };
+
+    void rebuild();
+
+    size_t capacity_ = 0;
+    std::unique_ptr<std::byte[]> buffer_;
+    CountingResource upstream_{std::pmr::new_delete_resource()};  // 统计 monotonic 向堆的申请
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> monotonic_;
+    CountingResource counting_{nullptr};  // 统计外部对 arena 的请求
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+// 编译期 SIMD 能力探测，供各热点内核选择实现路径：
+// - AVX2 需在编译选项中显式开启（CMake: -DENABLE_AVX2=ON）
+// - x86-64 默认具备 SSE2；Apple Silicon / ARM64 默认具备 NEON
+// 任何路径都必须保留等价的标量实现作为兜底。
+#if defined(__AVX2__)
+#define MTT_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+
+// F16C（半精度转换指令）通常随 AVX2 一起提供，但需单独探测
+#if defined(__F16C__)
+#define MTT_SIMD_F16C 1
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MTT_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MTT_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace simd {
+
+// 当前构建启用的最高向量指令集（用于日志/基准输出）
+inline const char *ActiveIsaName() {
+#if defined(MTT_SIMD_AVX2)
+    return "AVX2";
+#elif defined(MTT_SIMD_SSE2)
+    return "SSE2";
+#elif defined(MTT_SIMD_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+}  // namespace simd
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "Simd.h"
+
+// 稠密向量的基础内核（点积 / 缩放 / 滑动平均 / 半精度与 int8 点积），供特征向量与关联矩阵使用。
+// 运行期维度版本使用非对齐加载；DotN<N> 为编译期维度版本，要求两个输入均 32 字节对齐（Feature/FixedFeature 均为 64 字节对齐）。
+namespace simd {
+
+inline float DotScalar(const float *a, const float *b, size_t n) {
+    float sum = 0.0F;
+    for (size_t k = 0; k < n; ++k) sum += a[k] * b[k];
+    return sum;
+}
+
+inline float Dot(const float *a, const float *b, size_t n) {
+    size_t k = 0;
+    float sum = 0.0F;
+#if defined(MTT_SIMD_AVX2)
+    // 两路累加器掩盖加法延迟
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    for (; k + 16 <= n; k += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + k + 8), _mm256_loadu_ps(b + k + 8)));
+    }
+    for (; k + 8 <= n; k += 8) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k)));
+    }
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    const __m128 pair = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    sum += _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+#endif
+#if defined(MTT_SIMD_SSE2)
+    __m128 acc4 = _mm_setzero_ps();
+    for (; k + 4 <= n; k += 4) {
+        acc4 = _mm_add_ps(acc4, _mm_mul_ps(_mm_loadu_ps(a + k), _mm_loadu_ps(b + k)));
+    }
+    const __m128 pair4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+    sum += _mm_cvtss_f32(_mm_add_ss(pair4, _mm_shuffle_ps(pair4, pair4, 1)));
+#elif defined(MTT_SIMD_NEON)
+    float32x4_t acc4 = vdupq_n_f32(0.0F);
+    for (; k + 4 <= n; k += 4) acc4 = vmlaq_f32(acc4, vld1q_f32(a + k), vld1q_f32(b + k));
+    sum += vaddvq_f32(acc4);
+#endif
+    // 尾部按剩余个数计数：n 为编译期常量时 GCC 对 "k < n" 形式的尾循环会误报越界
+    for (size_t rest = n - k; rest > 0; --rest, ++k) sum += a[k] * b[k];
+    return sum;
+}
+
+// 编译期维度的点积：循环次数为常量，编译器可完全展开；N 为 16/32 的倍数时走对齐加载 + 四路累加
+template <size_t N>
+inline float DotN(const float *a, const float *b) {
+#if defined(MTT_SIMD_AVX2)
+    if constexpr (N % 32 == 0) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+        for (size_t k = 0; k < N; k += 32) {
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_load_ps(a + k), _mm256_load_ps(b + k)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_load_ps(a + k + 8), _mm256_load_ps(b + k + 8)));
+            acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(_mm256_load_ps(a + k + 16), _mm256_load_ps(b + k + 16)));
+            acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(_mm256_load_ps(a + k + 24), _mm256_load_ps(b + k + 24)));
+        }
+        const __m256 acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+        const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        const __m128 pair = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+    }
+#endif
+#if defined(MTT_SIMD_SSE2)
+    if constexpr (N % 16 == 0) {
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+        __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+        for (size_t k = 0; k < N; k += 16) {
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load_ps(a + k), _mm_load_ps(b + k)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load_ps(a + k + 4), _mm_load_ps(b + k + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load_ps(a + k + 8), _mm_load_ps(b + k + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load_ps(a + k + 12), _mm_load_ps(b + k + 12)));
+        }
+        const __m128 acc4 = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+        const __m128 pair4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+        return _mm_cvtss_f32(_mm_add_ss(pair4, _mm_shuffle_ps(pair4, pair4, 1)));
+    }
+#elif defined(MTT_SIMD_NEON)
+    if constexpr (N % 16 == 0) {
+        float32x4_t acc0 = vdupq_n_f32(0.0F), acc1 = vdupq_n_f32(0.0F);
+        float32x4_t acc2 = vdupq_n_f32(0.0F), acc3 = vdupq_n_f32(0.0F);
+        for (size_t k = 0; k < N; k += 16) {
+            acc0 = vmlaq_f32(acc0, vld1q_f32(a + k), vld1q_f32(b + k));
+            acc1 = vmlaq_f32(acc1, vld1q_f32(a + k + 4), vld1q_f32(b + k + 4));
+            acc2 = vmlaq_f32(acc2, vld1q_f32(a + k + 8), vld1q_f32(b + k + 8));
+            acc3 = vmlaq_f32(acc3, vld1q_f32(a + k + 12), vld1q_f32(b + k + 12));
+        }
+        return vaddvq_f32(vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3)));
+    }
+#endif
+    return Dot(a, b, N);
+}
+
+// x *= s
+inline void Scale(float *x, float s, size_t n) {
+    size_t k = 0;
+#if defined(MTT_SIMD_AVX2)
+    const __m256 vs = _mm256_set1_ps(s);
+    for (; k + 8 <= n; k += 8) _mm256_storeu_ps(x + k, _mm256_mul_ps(_mm256_loadu_ps(x + k), vs));
+#endif
+#if defined(MTT_SIMD_SSE2)
+    const __m128 vs4 = _mm_set1_ps(s);
+    for (; k + 4 <= n; k += 4) _mm_storeu_ps(x + k, _mm_mul_ps(_mm_loadu_ps(x + k), vs4));
+#elif defined(MTT_SIMD_NEON)
+    const float32x4_t vs4 = vdupq_n_f32(s);
+    for (; k + 4 <= n; k += 4) vst1q_f32(x + k, vmulq_f32(vld1q_f32(x + k), vs4));
+#endif
+    for (size_t rest = n - k; rest > 0; --rest, ++k) x[k] *= s;
+}
+
+// 滑动平均：dst = alpha * src + (1 - alpha) * dst，同时返回结果的平方和（用于随后就地归一化）
+inline float BlendSquaredNorm(float *dst, const float *src, float alpha, size_t n) {
+    const float beta = 1.0F - alpha;
+    size_t k = 0;
+    float sum = 0.0F;
+#if defined(MTT_SIMD_AVX2)
+    const __m256 va = _mm256_set1_ps(alpha), vb = _mm256_set1_ps(beta);
+    __m256 acc = _mm256_setzero_ps();
+    for (; k + 8 <= n; k += 8) {
+        const __m256 v = _mm256_add_ps(_mm256_mul_ps(va, _mm256_loadu_ps(src + k)),
+                                       _mm256_mul_ps(vb, _mm256_loadu_ps(dst + k)));
+        _mm256_storeu_ps(dst + k, v);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+    }
+    const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    const __m128 pair = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    sum += _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+#endif
+#if defined(MTT_SIMD_SSE2)
+    const __m128 va4 = _mm_set1_ps(alpha), vb4 = _mm_set1_ps(beta);
+    __m128 acc4 = _mm_setzero_ps();
+    for (; k + 4 <= n; k += 4) {
+        const __m128 v = _mm_add_ps(_mm_mul_ps(va4, _mm_loadu_ps(src + k)), _mm_mul_ps(vb4, _mm_loadu_ps(dst + k)));
+        _mm_storeu_ps(dst + k, v);
+        acc4 = _mm_add_ps(acc4, _mm_mul_ps(v, v));
+    }
+    const __m128 pair4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+    sum += _mm_cvtss_f32(_mm_add_ss(pair4, _mm_shuffle_ps(pair4, pair4, 1)));
+#elif defined(MTT_SIMD_NEON)
+    const float32x4_t va4 = vdupq_n_f32(alpha), vb4 = vdupq_n_f32(beta);
+    float32x4_t acc4 = vdupq_n_f32(0.0F);
+    for (; k + 4 <= n; k += 4) {
+        const float32x4_t v = vmlaq_f32(vmulq_f32(vb4, vld1q_f32(dst + k)), va4, vld1q_f32(src + k));
+        vst1q_f32(dst + k, v);
+        acc4 = vmlaq_f32(acc4, v, v);
+    }
+    sum += vaddvq_f32(acc4);
+#endif
+    for (; k < n; ++k) {
+        dst[k] = alpha * src[k] + beta * dst[k];
+        sum += dst[k] * dst[k];
+    }
+    return sum;
+}
+
+// IEEE 754 半精度 -> 单精度
+inline float HalfToFloat(uint16_t h) {
+#if defined(MTT_SIMD_F16C)
+    return _cvtsh_ss(h);
+#else
+    const uint32_t sign = static_cast<uint32_t>(h & 0x8000U) << 16;
+    uint32_t exp = (h >> 10) & 0x1FU;
+    uint32_t mant = h & 0x3FFU;
+    uint32_t bits = 0;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else {
+            // 非规格化数：左移直到出现隐含位
+            exp = 127 - 15 + 1;
+            while ((mant & 0x400U) == 0) {
+                mant <<= 1;
+                --exp;
+            }
+            bits = sign | (exp << 23) | ((mant & 0x3FFU) << 13);
+        }
+    } else if (exp == 31) {
+        bits = sign | 0x7F800000U | (mant << 13);
+    } else {
+        bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+    return std::bit_cast<float>(bits);
+#endif
+}
+
+// 单精度 -> IEEE 754 半精度（就近舍入到偶数，溢出为无穷）
+inline uint16_t FloatToHalf(float f) {
+#if defined(MTT_SIMD_F16C)
+    return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+#else
+    const uint32_t x = std::bit_cast<uint32_t>(f);
+    const uint32_t sign = (x >> 16) & 0x8000U;
+    const uint32_t raw_exp = (x >> 23) & 0xFFU;
+    uint32_t mant = x & 0x7FFFFFU;
+    if (raw_exp == 0xFFU) {
+        return static_cast<uint16_t>(sign | 0x7C00U | (mant != 0 ? 0x200U : 0U));
+    }
+    const int exp = static_cast<int>(raw_exp) - 127 + 15;
+    if (exp >= 31) return static_cast<uint16_t>(sign | 0x7C00U);
+    if (exp <= 0) {
+        if (exp < -10) return static_cast<uint16_t>(sign);
+        // 结果为非规格化数：补上隐含位后右移
+        mant |= 0x800000U;
+        const uint32_t shift = static_cast<uint32_t>(14 - exp);
+        uint32_t h = mant >> shift;
+        const uint32_t rem = mant & ((1U << shift) - 1U);
+        const uint32_t halfway = 1U << (shift - 1U);
+        if (rem > halfway || (rem == halfway && (h & 1U) != 0)) ++h;
+        return static_cast<uint16_t>(sign | h);
+    }
+    uint32_t h = sign | (static_cast<uint32_t>(exp) << 10) | (mant >> 13);
+    const uint32_t rem = mant & 0x1FFFU;
+    // 进位可能溢出到指数位，恰好得到正确的下一个可表示值
+    if (rem > 0x1000U || (rem == 0x1000U && (h & 1U) != 0)) ++h;
+    return static_cast<uint16_t>(h);
+#endif
+}
+
+// int8 向量点积（int32 累加；|q| <= 127 时 n 不超过 13 万不会溢出）
+inline int32_t DotInt8(const int8_t *a, const int8_t *b, size_t n) {
+    size_t k = 0;
+    int32_t sum = 0;
+#if defined(MTT_SIMD_AVX2)
+    // 符号扩展为 int16 后用 madd 两两相乘相加，每次处理 32 个元素
+    __m256i acc = _mm256_setzero_si256();
+    for (; k + 32 <= n; k += 32) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + k));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + k));
+        const __m256i a_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(va));
+        const __m256i a_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(va, 1));
+        const __m256i b_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(vb));
+        const __m256i b_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(vb, 1));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a_lo, b_lo));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a_hi, b_hi));
+    }
+    const __m128i half = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    const __m128i pair = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum += _mm_cvtsi128_si32(_mm_add_epi32(pair, _mm_shuffle_epi32(pair, _MM_SHUFFLE(2, 3, 0, 1))));
+#endif
+#if defined(MTT_SIMD_SSE2)
+    __m128i acc4 = _mm_setzero_si128();
+    for (; k + 16 <= n; k += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + k));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + k));
+        // SSE2 没有 cvtepi8：与自身交错后算术右移 8 位完成符号扩展
+        const __m128i a_lo = _mm_srai_epi16(_mm_unpacklo_epi8(va, va), 8);
+        const __m128i a_hi = _mm_srai_epi16(_mm_unpackhi_epi8(va, va), 8);
+        const __m128i b_lo = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+        const __m128i b_hi = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+        acc4 = _mm_add_epi32(acc4, _mm_madd_epi16(a_lo, b_lo));
+        acc4 = _mm_add_epi32(acc4, _mm_madd_epi16(a_hi, b_hi));
+    }
+    const __m128i pair4 = _mm_add_epi32(acc4, _mm_shuffle_epi32(acc4, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum += _mm_cvtsi128_si32(_mm_add_epi32(pair4, _mm_shuffle_epi32(pair4, _MM_SHUFFLE(2, 3, 0, 1))));
+#elif defined(MTT_SIMD_NEON)
+    int32x4_t acc4 = vdupq_n_s32(0);
+    for (; k + 16 <= n; k += 16) {
+        const int8x16_t va = vld1q_s8(a + k);
+        const int8x16_t vb = vld1q_s8(b + k);
+        acc4 = vpadalq_s16(acc4, vmull_s8(vget_low_s8(va), vget_low_s8(vb)));
+        acc4 = vpadalq_s16(acc4, vmull_s8(vget_high_s8(va), vget_high_s8(vb)));
+    }
+    sum += vaddvq_s32(acc4);
+#endif
+    for (size_t rest = n - k; rest > 0; --rest, ++k) sum += static_cast<int32_t>(a[k]) * static_cast<int32_t>(b[k]);
+    return sum;
+}
+
+// 半精度向量点积（转换为单精度后累加）
+inline float DotHalf(const uint16_t *a, const uint16_t *b, size_t n) {
+    size_t k = 0;
+    float sum = 0.0F;
+#if defined(MTT_SIMD_AVX2) && defined(MTT_SIMD_F16C)
+    __m256 acc = _mm256_setzero_ps();
+    for (; k + 8 <= n; k += 8) {
+        const __m256 va = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + k)));
+        const __m256 vb = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + k)));
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(va, vb));
+    }
+    const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    const __m128 pair = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    sum += _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+#elif defined(MTT_SIMD_NEON) && defined(__aarch64__)
+    float32x4_t acc4 = vdupq_n_f32(0.0F);
+    for (; k + 4 <= n; k += 4) {
+        const float32x4_t va = vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(a + k)));
+        const float32x4_t vb = vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(b + k)));
+        acc4 = vmlaq_f32(acc4, va, vb);
+    }
+    sum += vaddvq_f32(acc4);
+#endif
+    for (size_t rest = n - k; rest > 0; --rest, ++k) sum += HalfToFloat(a[k]) * HalfToFloat(b[k]);
+    return sum;
+}
+
+}  // namespace simd
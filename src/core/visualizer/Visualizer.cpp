@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include <opencv2/imgproc.hpp>
 
@@ -126,25 +127,48 @@ cv::Mat Visualizer::render(const cv::Mat &frame, const LabeledFrame &data) const
     const int textThickness = std::max(1, cfg_.text_thickness);
     const int pad = std::max(0, cfg_.text_padding);
 
-    // 绘制 ROI 框（可选），用于直观展示引擎正在分析的子区域
+    // 绘制所有 ROI 区域（可选），用于直观展示引擎正在分析的子区域
     if (cfg_.roi.enabled)
     {
-        const cv::Rect roi = RoiToPixelRect(cfg_.roi, output.size());
-        if (roi.width > 0 && roi.height > 0)
+        const float alpha = std::clamp(cfg_.roi_fill_alpha, 0.0f, 1.0f);
+        const int roiThickness = std::max(1, cfg_.roi_thickness);
+        for (const PixelRoi &zone : RoiToPixelZones(cfg_.roi, output.size()))
         {
-            const float alpha = std::clamp(cfg_.roi_fill_alpha, 0.0f, 1.0f);
+            const cv::Rect &roi = zone.bounds;
             if (alpha > 0.0f)
             {
                 cv::Mat roiMat = output(roi);
                 cv::Mat colorMat(roi.size(), roiMat.type(), cfg_.roi_color);
-                cv::addWeighted(colorMat, alpha, roiMat, 1.0 - alpha, 0.0, roiMat);
+                if (zone.polygon.empty())
+                {
+                    cv::addWeighted(colorMat, alpha, roiMat, 1.0 - alpha, 0.0, roiMat);
+                }
+                else
+                {
+                    // 多边形区域：只在多边形内部混合填充色
+                    cv::Mat blended;
+                    cv::addWeighted(colorMat, alpha, roiMat, 1.0 - alpha, 0.0, blended);
+                    cv::Mat mask = cv::Mat::zeros(roi.size(), CV_8U);
+                    std::vector<cv::Point> local;
+                    local.reserve(zone.polygon.size());
+                    for (const cv::Point &p : zone.polygon)
+                        local.push_back(p - roi.tl());
+                    cv::fillPoly(mask, std::vector<std::vector<cv::Point>>{local}, cv::Scalar(255));
+                    blended.copyTo(roiMat, mask);
+                }
             }
 
-            const int roiThickness = std::max(1, cfg_.roi_thickness);
-            cv::rectangle(output, roi, cfg_.roi_color, roiThickness);
+            if (zone.polygon.empty())
+            {
+                cv::rectangle(output, roi, cfg_.roi_color, roiThickness);
+            }
+            else
+            {
+                cv::polylines(output, std::vector<std::vector<cv::Point>>{zone.polygon}, true, cfg_.roi_color, roiThickness, cv::LINE_AA);
+            }
             cv::putText(
                 output,
-                "ROI",
+                zone.name,
                 cv::Point(roi.x + 5, std::max(15, roi.y + 15)),
                 cfg_.font_face,
                 cfg_.font_scale,
@@ -1,11 +1,93 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
 #include <QFile>
+#include <QStandardPaths>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include "config/AppConfig.h"
+#include "config/ConfigManager.h"
+#include "core/engine/SegmentParallelTracker.h"
 #include "ui/MainWindowView.h"
 #include "ui/MainWindowController.h"
 
+namespace {
+constexpr const char *kAppName = "multi-target-tracking";
+
+bool hasOfflineFlag(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--offline") == 0) return true;
+    }
+    return false;
+}
+
+// 与 MainWindowController 使用同一份配置文件（~/.config/<AppName>/config.yml）
+QString defaultConfigPath() {
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
+    const QString baseDir = dir.isEmpty() ? QDir::homePath() + "/.config/" + kAppName : dir;
+    return QDir(baseDir).filePath("config.yml");
+}
+
+// 离线模式（无界面）：分段并行处理整个视频文件，结果按 StatsRecorder 的 CSV 格式写出。
+// 用法：multi-target-tracking --offline <视频> [--config <yml>] [--sample-fps <fps>] [--output <csv>]
+int runOffline(QCoreApplication &app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("离线分段并行跟踪（配置见 engine.offline）");
+    parser.addHelpOption();
+    parser.addPositionalArgument("video", "输入视频文件");
+    const QCommandLineOption offlineOpt("offline", "离线处理模式（无界面）");
+    const QCommandLineOption configOpt("config", "配置文件路径（默认与界面共用）", "yml", defaultConfigPath());
+    const QCommandLineOption fpsOpt("sample-fps", "采样帧率（<=0 表示逐帧）", "fps", "0");
+    const QCommandLineOption outputOpt("output", "CSV 输出路径（默认 recorder.stats_csv_path）", "csv");
+    parser.addOptions({offlineOpt, configOpt, fpsOpt, outputOpt});
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1) {
+        std::cerr << "需要且只能指定一个输入视频文件\n";
+        return 2;
+    }
+
+    try {
+        AppConfig config = ConfigManager(parser.value(configOpt).toStdString()).load();
+        // 与界面首次启动一致的默认路径
+        if (config.engine.detector.ort_env_config.model_path.empty()) {
+            config.engine.detector.ort_env_config.model_path = "model/yolo12n.onnx";
+        }
+        if (config.engine.extractor.ort_env_config.model_path.empty()) {
+            config.engine.extractor.ort_env_config.model_path = "model/osnet_x1_0.onnx";
+        }
+        if (parser.isSet(outputOpt)) {
+            config.recorder.stats_csv_path = parser.value(outputOpt).toStdString();
+        }
+        if (config.recorder.stats_csv_path.empty()) {
+            config.recorder.stats_csv_path = "docs/output.csv";
+        }
+
+        const SegmentParallelTracker tracker(config.engine, config.capture);
+        const auto frames = tracker.run(args.front().toStdString(), parser.value(fpsOpt).toDouble());
+        SegmentParallelTracker::exportCsv(frames, config.recorder);
+        std::cout << "已处理 " << frames.size() << " 帧，结果写入 " << config.recorder.stats_csv_path << "\n";
+    } catch (const std::exception &e) {
+        std::cerr << "离线处理失败: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+}  // namespace
+
 int main(int argc, char *argv[]) {
+    // 离线模式不创建窗口（也不需要显示环境）
+    if (hasOfflineFlag(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        app.setApplicationName(kAppName);
+        return runOffline(app);
+    }
+
     QApplication app(argc, argv);
-    app.setApplicationName("multi-target-tracking");
+    app.setApplicationName(kAppName);
     // 加载 QSS 样式（样式与逻辑分离）
     QFile styleFile(":/ui/style.qss");
     if (styleFile.open(QIODevice::ReadOnly)) {
@@ -9,6 +9,7 @@ struct LabeledObject {
     cv::Rect bbox;                 // 像素级别的检测框
     int class_id = -1;             // 模型预测类别（仅做人时固定为 0）
     float score = 0.0F;            // 置信度打分
+    std::vector<float> feature;    // 轨迹当前的 ReID 特征（仅 TrackerManagerConfig::export_features 开启且帧在导出窗口内时填充）
 };
 
 // 封装单帧全部检测结果，便于下游消费
@@ -137,14 +137,15 @@ bool MainWindowController::startRun_() {
                 QMessageBox::information(view_, "提示", "请先选择视频文件");
                 return false;
             }
-            VideoFrameSource src(current_video_path_.toStdString(), sampleFps);
+            VideoFrameSource src(current_video_path_.toStdString(), sampleFps, config_.capture);
             baseIter = src.createIterator();
         } else {
-            VideoFrameSource src(view_->cameraIndex(), sampleFps);
+            VideoFrameSource src(view_->cameraIndex(), sampleFps, config_.capture);
             baseIter = src.createIterator();
         }
 
         const FrameSourceInfo info = baseIter->info();
+        source_ = baseIter.get();
         source_is_live_ = info.is_live;
         total_frames_ = info.total_frames;
         timer_.setInterval(calcIntervalMs(info.sample_fps > 0.0 ? info.sample_fps : info.source_fps));
@@ -197,6 +198,7 @@ void MainWindowController::stopRun_(const QString &statusText) {
 }
 
 void MainWindowController::resetIterators_() {
+    source_ = nullptr;
     iterator_.reset();
     frame_iter_.reset();
     engine_.reset();
@@ -298,7 +300,15 @@ void MainWindowController::updateProgressUi_(int frameIndex) {
 
     if (source_is_live_) {
         view_->setProgress(0, -1);
-        view_->setFrameInfo(QStringLiteral("帧：%1").arg(displayIndex));
+        const CaptureStats cs = source_ ? source_->stats() : CaptureStats{};
+        if (cs.dropped > 0) {
+            view_->setFrameInfo(QStringLiteral("帧：%1（丢帧 %2，等待 %3 ms）")
+                                    .arg(displayIndex)
+                                    .arg(static_cast<qulonglong>(cs.dropped))
+                                    .arg(cs.last_wait_ms, 0, 'f', 1));
+        } else {
+            view_->setFrameInfo(QStringLiteral("帧：%1").arg(displayIndex));
+        }
         return;
     }
 
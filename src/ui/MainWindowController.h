@@ -56,6 +56,8 @@ private:
     std::unique_ptr<TrackingEngine> engine_;
     std::unique_ptr<ILabeledDataIterator> iterator_;
     std::unique_ptr<IImageIterator> frame_iter_;
+    // 当前帧源（由 iterator_ 或 frame_iter_ 持有），用于读取实时采集统计
+    const IImageIterator *source_ = nullptr;
     Visualizer viz_;
     std::unique_ptr<StatsRecorder> stats_;
     int frame_index_ = 0;
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "core/capture/FramePrefetcher.h"
+
+namespace {
+// 模拟解码：第 i 帧的首字节写入 i，共 count 帧
+FramePrefetcher::ReadFn CountingReader(int count) {
+    return [count, next = 0](cv::Mat &frame) mutable {
+        if (next >= count) return false;
+        frame.create(4, 4, CV_8UC1);
+        frame.data[0] = static_cast<uchar>(next++);
+        return true;
+    };
+}
+}  // namespace
+
+// 按解码顺序输出全部帧；调用方每次复用同一个 Mat 时，解码缓冲在环内循环使用
+TEST(FramePrefetcherTests, PreservesOrderAndRecyclesBuffers) {
+    FramePrefetcher prefetcher(CountingReader(100), 3);
+    cv::Mat frame;
+    int n = 0;
+    while (prefetcher.next(frame)) {
+        ASSERT_EQ(frame.data[0], static_cast<uchar>(n));
+        ++n;
+    }
+    EXPECT_EQ(n, 100);
+    EXPECT_LE(prefetcher.allocations(), 3U + 2U);
+}
+
+// 下游仍持有的帧不会被解码线程覆盖
+TEST(FramePrefetcherTests, HeldFramesAreNotOverwritten) {
+    FramePrefetcher prefetcher(CountingReader(50), 2);
+    std::vector<cv::Mat> held;
+    cv::Mat frame;
+    while (prefetcher.next(frame)) held.push_back(frame);
+    ASSERT_EQ(held.size(), 50U);
+    for (size_t i = 0; i < held.size(); ++i) EXPECT_EQ(held[i].data[0], static_cast<uchar>(i));
+}
+
+// 解码线程上的异常在取帧时抛给调用方
+TEST(FramePrefetcherTests, DecodeErrorIsRethrown) {
+    FramePrefetcher prefetcher([](cv::Mat &) -> bool { throw std::runtime_error("decode failed"); }, 2);
+    cv::Mat frame;
+    EXPECT_THROW(prefetcher.next(frame), std::runtime_error);
+    EXPECT_FALSE(prefetcher.next(frame));
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "core/capture/KeyframeIndex.h"
+#include "core/capture/VideoFrameSource.h"
+
+// 关键帧查询，以及缓存文件随视频文件变化而失效
+TEST(KeyframeIndexTests, QueriesAndCacheInvalidation) {
+    const KeyframeIndex index({0, 12, 24}, {0.0, 33.3, 66.7});
+    EXPECT_EQ(index.keyframeAtOrBefore(0), 0);
+    EXPECT_EQ(index.keyframeAtOrBefore(11), 0);
+    EXPECT_EQ(index.keyframeAtOrBefore(12), 12);
+    EXPECT_EQ(index.keyframeAtOrBefore(100), 24);
+    EXPECT_DOUBLE_EQ(index.timestampMs(1), 33.3);
+    EXPECT_LT(index.timestampMs(3), 0.0);
+
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string video = (dir / "keyframe_index_test.bin").string();
+    std::ofstream(video, std::ios::binary) << "fake video";
+    const std::string cache = KeyframeIndex::cachePath(video);
+    ASSERT_TRUE(index.save(cache, video));
+
+    KeyframeIndex loaded;
+    ASSERT_TRUE(loaded.load(cache, video));
+    EXPECT_EQ(loaded.keyframes(), index.keyframes());
+    EXPECT_EQ(loaded.frameCount(), 3);
+
+    std::ofstream(video, std::ios::binary | std::ios::app) << " changed";
+    EXPECT_FALSE(KeyframeIndex().load(cache, video));
+    std::filesystem::remove(video);
+    std::filesystem::remove(cache);
+}
+
+// 30fps 视频按 1fps 采样：按关键帧跳转与逐帧 grab 输出相同的帧，但解码量更少（需要 FFmpeg 后端）
+TEST(KeyframeIndexTests, BenchmarkSeekSamplingAgainstGrab) {
+    const std::string video = (std::filesystem::temp_directory_path() / "keyframe_seek_bench.avi").string();
+    {
+        cv::VideoWriter writer(video, cv::VideoWriter::fourcc('X', 'V', 'I', 'D'), 30.0, cv::Size(640, 360));
+        if (!writer.isOpened()) GTEST_SKIP() << "无法写入测试视频（缺少编码器）";
+        cv::Mat frame(360, 640, CV_8UC3);
+        for (int i = 0; i < 900; ++i) {
+            cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+            cv::putText(frame, std::to_string(i), cv::Point(20, 200), cv::FONT_HERSHEY_SIMPLEX, 4.0, cv::Scalar(255, 255, 255), 6);
+            writer.write(frame);
+        }
+    }
+    std::filesystem::remove(KeyframeIndex::cachePath(video));
+    const KeyframeIndex index = KeyframeIndex::build(video);
+    if (index.empty()) {
+        std::filesystem::remove(video);
+        GTEST_SKIP() << "当前 VideoCapture 后端不支持原始包模式，无法建立关键帧索引";
+    }
+    // 采样步长超过跳转开销、且关键帧间隔足够小（每个采样点都会跳转）时，跳转必须比逐帧 grab 快
+    constexpr int kStride = 30;
+    int max_gop = 0;
+    for (size_t i = 1; i < index.keyframes().size(); ++i) {
+        max_gop = std::max(max_gop, index.keyframes()[i] - index.keyframes()[i - 1]);
+    }
+    const bool seek_pays_off = kStride - 1 > CaptureConfig{}.seek_overhead_frames &&
+                               max_gop + CaptureConfig{}.seek_overhead_frames < kStride;
+
+    auto run = [&](bool seek, std::vector<cv::Mat> &frames) {
+        CaptureConfig cfg;
+        cfg.prefetch_depth = 0;
+        cfg.seek_sampling = seek;
+        const auto t0 = std::chrono::steady_clock::now();
+        VideoFileIterator iter(video, 1.0, cfg);
+        cv::Mat frame;
+        while (iter.hasNext() && iter.next(frame)) frames.push_back(frame.clone());
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    std::vector<cv::Mat> grabbed;
+    std::vector<cv::Mat> seeked;
+    std::vector<cv::Mat> cached;
+    const double grab_ms = run(false, grabbed);
+    const double seek_ms = run(true, seeked);  // 首次打开会扫描并写入索引缓存
+    const double cached_ms = run(true, cached);
+
+    ASSERT_EQ(grabbed.size(), 30U);
+    ASSERT_EQ(seeked.size(), grabbed.size());
+    for (size_t i = 0; i < grabbed.size(); ++i) EXPECT_EQ(cv::norm(grabbed[i], seeked[i], cv::NORM_INF), 0.0) << i;
+    EXPECT_EQ(cached.size(), grabbed.size());
+    std::cout << "[Seek] 900 帧 30fps -> 1fps: grab=" << grab_ms << "ms seek(建索引)=" << seek_ms
+              << "ms seek(缓存)=" << cached_ms << "ms 加速比=" << grab_ms / cached_ms << "x\n";
+    if (seek_pays_off) {
+        EXPECT_LT(seek_ms, grab_ms);
+        EXPECT_LT(cached_ms, grab_ms);
+    } else {
+        std::cout << "[Seek] 关键帧间隔 " << max_gop << " 帧，跳转不划算，只校验输出一致\n";
+    }
+
+    std::filesystem::remove(KeyframeIndex::cachePath(video));
+    std::filesystem::remove(video);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "core/capture/LiveFrameGrabber.h"
+
+// 消费慢于采集时只处理最新帧：输出帧号严格递增，旧帧计入丢帧，数据源结束前的最后一帧一定被取到
+TEST(LiveFrameGrabberTests, SlowConsumerGetsLatestFrames) {
+    constexpr int kFrames = 200;
+    LiveFrameGrabber grabber(
+        [next = 0](cv::Mat &frame) mutable {
+            if (next >= kFrames) return false;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            frame.create(2, 2, CV_8UC1);
+            frame.data[0] = static_cast<uchar>(next++);
+            return true;
+        },
+        1);
+
+    std::vector<int> received;
+    cv::Mat frame;
+    while (grabber.next(frame)) {
+        received.push_back(frame.data[0]);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    ASSERT_FALSE(received.empty());
+    for (size_t i = 1; i < received.size(); ++i) EXPECT_GT(received[i], received[i - 1]);
+    EXPECT_EQ(received.back(), kFrames - 1);
+
+    const CaptureStats stats = grabber.stats();
+    EXPECT_EQ(stats.captured, static_cast<uint64_t>(kFrames));
+    EXPECT_GT(stats.dropped, 0U);
+    EXPECT_EQ(stats.captured, stats.dropped + received.size());
+    EXPECT_GT(stats.last_capture_us, 0);
+}
+
+// 调用方传入包装外部数据的 Mat（不归 OpenCV 管理）：不能被当成可回收缓冲，外部内存也不会被写入
+TEST(LiveFrameGrabberTests, ExternalBufferIsNotRecycled) {
+    LiveFrameGrabber grabber(
+        [next = 0](cv::Mat &frame) mutable {
+            if (next >= 3) return false;
+            frame.create(2, 2, CV_8UC1);
+            frame.data[0] = static_cast<uchar>(100 + next++);
+            return true;
+        },
+        1);
+
+    uchar external[4] = {7, 7, 7, 7};
+    cv::Mat frame(2, 2, CV_8UC1, external);
+    int count = 0;
+    while (grabber.next(frame)) {
+        EXPECT_NE(frame.data, external);
+        ++count;
+    }
+    EXPECT_GT(count, 0);
+    for (uchar v : external) EXPECT_EQ(v, 7);
+}
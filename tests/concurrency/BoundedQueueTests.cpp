@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "core/concurrency/BoundedQueue.h"
+
+// 生产者/消费者跨线程传递时应保持先进先出
+TEST(BoundedQueueTests, PreservesOrderAcrossThreads) {
+    BoundedQueue<int> queue(2);
+    std::thread producer([&] {
+        for (int i = 0; i < 100; ++i) queue.push(i);
+        queue.close();
+    });
+
+    std::vector<int> received;
+    int value = 0;
+    while (queue.pop(value)) received.push_back(value);
+    producer.join();
+
+    ASSERT_EQ(received.size(), 100u);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(received[i], i);
+}
+
+// 关闭后 push 失败，但已入队的数据仍可取出
+TEST(BoundedQueueTests, CloseDrainsRemainingItems) {
+    BoundedQueue<int> queue(4);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    queue.close();
+    EXPECT_FALSE(queue.push(3));
+
+    int value = 0;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(queue.pop(value));
+}
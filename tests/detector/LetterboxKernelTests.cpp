@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "core/engine/model/detector/LetterboxKernel.h"
+
+namespace {
+// 参考实现：与融合内核替换前 YoloDetector::preprocess 的逐步 OpenCV 流程一致
+std::vector<float> ReferenceLetterbox(const cv::Mat &frame, const LetterboxLayout &layout) {
+    cv::Mat resized;
+    cv::resize(frame, resized, cv::Size(layout.resize_w, layout.resize_h));
+    cv::Mat canvas(layout.dst_h, layout.dst_w, CV_8UC3, cv::Scalar(114, 114, 114));
+    resized.copyTo(canvas(cv::Rect(layout.pad_x, layout.pad_y, layout.resize_w, layout.resize_h)));
+    cv::cvtColor(canvas, canvas, cv::COLOR_BGR2RGB);
+    canvas.convertTo(canvas, CV_32F, 1.0 / 255.0);
+    std::vector<cv::Mat> chw(3);
+    cv::split(canvas, chw);
+
+    const size_t plane = static_cast<size_t>(layout.dst_w * layout.dst_h);
+    std::vector<float> out(3 * plane);
+    for (int c = 0; c < 3; ++c) {
+        std::memcpy(out.data() + c * plane, chw[c].ptr<float>(), plane * sizeof(float));
+    }
+    return out;
+}
+
+float MaxAbsDiff(const std::vector<float> &a, const std::vector<float> &b) {
+    float diff = 0.0F;
+    for (size_t i = 0; i < a.size(); ++i) diff = std::max(diff, std::fabs(a[i] - b[i]));
+    return diff;
+}
+}  // namespace
+
+// 融合内核与原流程的差异只来自 cv::resize 8 位定点插值的舍入（至多 1 个灰度级）
+TEST(LetterboxKernelTests, MatchesOpenCvPipeline) {
+    const cv::Size sizes[] = {{1920, 1080}, {320, 240}, {641, 333}, {640, 640}, {100, 900}};
+    cv::RNG rng(42);
+    for (const auto &size : sizes) {
+        cv::Mat frame(size, CV_8UC3);
+        rng.fill(frame, cv::RNG::UNIFORM, 0, 256);
+
+        const LetterboxLayout layout = ComputeLetterboxLayout(size, 640, 640);
+        const auto expected = ReferenceLetterbox(frame, layout);
+
+        std::vector<float> actual(expected.size(), -1.0F);
+        LetterboxKernel kernel;
+        kernel.run(frame, layout, actual.data());
+        EXPECT_LE(MaxAbsDiff(expected, actual), 1.5F / 255.0F) << "size=" << size.width << "x" << size.height;
+    }
+}
+
+// SIMD 路径与标量兜底必须逐元素一致；持久缓冲重复使用时 padding 不会被破坏
+TEST(LetterboxKernelTests, SimdMatchesScalarAndReusesBuffer) {
+    cv::Mat frame(720, 1280, CV_8UC3);
+    cv::RNG rng(7);
+    rng.fill(frame, cv::RNG::UNIFORM, 0, 256);
+    const LetterboxLayout layout = ComputeLetterboxLayout(frame.size(), 640, 640);
+
+    std::vector<float> simd_out(3 * 640 * 640, -1.0F);
+    std::vector<float> scalar_out(3 * 640 * 640, -1.0F);
+    LetterboxKernel simd_kernel;
+    LetterboxKernel scalar_kernel;
+    scalar_kernel.setUseSimd(false);
+
+    simd_kernel.run(frame, layout, simd_out.data());
+    simd_kernel.run(frame, layout, simd_out.data());  // 第二次不再填充 padding
+    scalar_kernel.run(frame, layout, scalar_out.data());
+
+    EXPECT_EQ(MaxAbsDiff(simd_out, scalar_out), 0.0F);
+    EXPECT_FLOAT_EQ(simd_out[0], LetterboxKernel::kPadValue);
+}
+
+// 尺寸与布局不变的连续两张图：上一张的行缓存不能混入下一张（源图只有 1~2 行时首尾行会命中缓存）
+TEST(LetterboxKernelTests, RowCacheDoesNotLeakAcrossImages) {
+    const cv::Mat dark(2, 64, CV_8UC3, cv::Scalar(0, 0, 0));
+    const cv::Mat bright(2, 64, CV_8UC3, cv::Scalar(200, 100, 50));
+    const LetterboxLayout layout = ComputeLetterboxLayout(dark.size(), 64, 64);
+
+    std::vector<float> reused(3 * 64 * 64, -1.0F);
+    std::vector<float> fresh(3 * 64 * 64, -1.0F);
+    LetterboxKernel kernel;
+    kernel.run(dark, layout, reused.data());
+    kernel.run(bright, layout, reused.data());
+    LetterboxKernel().run(bright, layout, fresh.data());
+
+    EXPECT_EQ(MaxAbsDiff(reused, fresh), 0.0F);
+}
+
+// 矩形推理：输入尺寸贴合宽高比并按 stride 对齐，填充不足一个 stride，且不超过上限
+TEST(LetterboxKernelTests, RectInputSizeFitsAspectRatio) {
+    EXPECT_EQ(ComputeRectInputSize(cv::Size(1920, 1080), 640, 640, 32), cv::Size(640, 384));
+    EXPECT_EQ(ComputeRectInputSize(cv::Size(1080, 1920), 640, 640, 32), cv::Size(384, 640));
+    EXPECT_EQ(ComputeRectInputSize(cv::Size(300, 100), 640, 640, 32), cv::Size(640, 224));
+    EXPECT_EQ(ComputeRectInputSize(cv::Size(640, 640), 640, 640, 32), cv::Size(640, 640));
+    EXPECT_EQ(ComputeRectInputSize(cv::Size(3840, 2160), 1280, 1280, 32), cv::Size(1280, 736));
+
+    const cv::Size rect = ComputeRectInputSize(cv::Size(1920, 1080), 640, 640, 32);
+    const LetterboxLayout layout = ComputeLetterboxLayout(cv::Size(1920, 1080), rect.width, rect.height);
+    EXPECT_FLOAT_EQ(layout.scale, 640.0F / 1920.0F);
+    EXPECT_EQ(layout.pad_y, 12);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "core/engine/model/detector/NmsEngine.h"
+#include "core/simd/Simd.h"
+
+namespace {
+// 参考实现：替换前 YoloDetector::applyNms 的 O(n^2) 贪心 NMS（排序改为稳定排序以固定同分顺序）
+std::vector<BBox> ReferenceNms(const std::vector<BBox> &boxes, float iou_threshold, bool use_iom) {
+    std::vector<int> indices(boxes.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(indices.begin(), indices.end(), [&](int lhs, int rhs) {
+        return boxes[lhs].score > boxes[rhs].score;
+    });
+
+    std::vector<BBox> picked;
+    std::vector<bool> suppressed(boxes.size(), false);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const int idx = indices[i];
+        if (suppressed[idx]) continue;
+        picked.emplace_back(boxes[idx]);
+        for (size_t j = i + 1; j < indices.size(); ++j) {
+            const int next_idx = indices[j];
+            if (suppressed[next_idx]) continue;
+            if (boxes[idx].class_id != boxes[next_idx].class_id) continue;
+            const float overlap = use_iom ? (boxes[idx] && boxes[next_idx]) : (boxes[idx] & boxes[next_idx]);
+            if (overlap > iou_threshold) {
+                suppressed[next_idx] = true;
+            }
+        }
+    }
+    return picked;
+}
+
+// 拥挤场景：若干人群中心附近聚集大量抖动框，另有少量零散框
+std::vector<BBox> MakeCrowd(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> center(0.0F, 1800.0F);
+    std::normal_distribution<float> jitter(0.0F, 12.0F);
+    std::uniform_real_distribution<float> size(20.0F, 120.0F);
+    std::uniform_real_distribution<float> score(0.05F, 1.0F);
+    std::uniform_int_distribution<int> cls(0, 2);
+
+    std::vector<BBox> boxes;
+    boxes.reserve(count);
+    while (boxes.size() < count) {
+        const float cx = center(rng), cy = center(rng) * 0.6F;
+        const float w = size(rng), h = size(rng) * 2.0F;
+        const int cluster = 1 + static_cast<int>(rng() % 12);
+        for (int k = 0; k < cluster && boxes.size() < count; ++k) {
+            const float x = cx + jitter(rng), y = cy + jitter(rng);
+            boxes.emplace_back(cv::Rect2f(x, y, w + jitter(rng) * 0.5F + 15.0F, h + jitter(rng) * 0.5F + 15.0F),
+                               cls(rng), score(rng));
+        }
+    }
+    return boxes;
+}
+
+void ExpectSameBoxes(const std::vector<BBox> &actual, const std::vector<BBox> &expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].class_id, expected[i].class_id);
+        EXPECT_EQ(actual[i].score, expected[i].score);
+        EXPECT_EQ(actual[i].box, expected[i].box);
+    }
+}
+}  // namespace
+
+TEST(NmsTests, GreedyMatchesQuadraticReference) {
+    NmsEngine engine;
+    for (unsigned seed : {1U, 2U, 3U}) {
+        const auto boxes = MakeCrowd(1500, seed);
+        for (bool use_iom : {false, true}) {
+            for (float thr : {0.3F, 0.5F, 0.8F}) {
+                NmsParams params;
+                params.overlap_threshold = thr;
+                params.use_iom = use_iom;
+                const auto expected = ReferenceNms(boxes, thr, use_iom);
+                for (bool use_simd : {true, false}) {
+                    engine.setUseSimd(use_simd);
+                    std::vector<BBox> actual;
+                    engine.run(boxes, params, actual);
+                    ExpectSameBoxes(actual, expected);
+                }
+            }
+        }
+    }
+}
+
+TEST(NmsTests, SoftAndMatrixDecayOnlyOverlappingBoxes) {
+    // 两个高度重叠的同类框 + 一个远处的框 + 一个与第一个重叠但类别不同的框
+    const std::vector<BBox> boxes = {
+        BBox(cv::Rect2f(0, 0, 100, 100), 0, 0.9F),
+        BBox(cv::Rect2f(5, 5, 100, 100), 0, 0.8F),
+        BBox(cv::Rect2f(500, 500, 50, 50), 0, 0.7F),
+        BBox(cv::Rect2f(0, 0, 100, 100), 1, 0.6F),
+    };
+
+    for (NmsMethod method : {NmsMethod::Soft, NmsMethod::Matrix}) {
+        NmsEngine engine;
+        NmsParams params;
+        params.method = method;
+        params.min_score = 0.01F;
+        std::vector<BBox> out;
+        engine.run(boxes, params, out);
+
+        ASSERT_EQ(out.size(), 4U);
+        // 最高分框、远处框、其他类别的框分数不变
+        auto find = [&](float x, int cls) {
+            return *std::find_if(out.begin(), out.end(), [&](const BBox &b) {
+                return b.box.x == x && b.class_id == cls;
+            });
+        };
+        EXPECT_FLOAT_EQ(find(0, 0).score, 0.9F);
+        EXPECT_FLOAT_EQ(find(500, 0).score, 0.7F);
+        EXPECT_FLOAT_EQ(find(0, 1).score, 0.6F);
+        // 重叠框被衰减：exp(-iou^2 / sigma)
+        const float iou = boxes[0] & boxes[1];
+        EXPECT_NEAR(find(5, 0).score, 0.8F * std::exp(-iou * iou / params.sigma), 1e-6F);
+        // 输出按分数降序
+        EXPECT_TRUE(std::is_sorted(out.begin(), out.end(), [](const BBox &a, const BBox &b) {
+            return a.score > b.score;
+        }));
+
+        // 提高最低分后，被衰减的框被丢弃
+        params.min_score = 0.65F;
+        engine.run(boxes, params, out);
+        EXPECT_EQ(out.size(), 2U);
+    }
+}
+
+// 微基准：拥挤场景下网格 NMS 与原 O(n^2) 贪心实现的耗时对比
+TEST(NmsTests, BenchmarkAgainstQuadraticReference) {
+    for (size_t count : {size_t{300}, size_t{3000}}) {
+        const auto boxes = MakeCrowd(count, 11U);
+        NmsParams params;
+        params.overlap_threshold = 0.5F;
+
+        NmsEngine engine;
+        std::vector<BBox> out;
+        constexpr int kIters = 20;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIters; ++i) engine.run(boxes, params, out);
+        const auto t1 = std::chrono::steady_clock::now();
+        size_t ref_count = 0;
+        for (int i = 0; i < kIters; ++i) ref_count = ReferenceNms(boxes, 0.5F, false).size();
+        const auto t2 = std::chrono::steady_clock::now();
+
+        params.method = NmsMethod::Matrix;
+        std::vector<BBox> matrix_out;
+        for (int i = 0; i < kIters; ++i) engine.run(boxes, params, matrix_out);
+        const auto t3 = std::chrono::steady_clock::now();
+        params.method = NmsMethod::Soft;
+        std::vector<BBox> soft_out;
+        for (int i = 0; i < kIters; ++i) engine.run(boxes, params, soft_out);
+        const auto t4 = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(out.size(), ref_count);
+        auto us = [&](auto a, auto b) { return std::chrono::duration<double, std::micro>(b - a).count() / kIters; };
+        std::cout << "[NMS] isa=" << simd::ActiveIsaName() << " boxes=" << count
+                  << " grid=" << us(t0, t1) << "us reference=" << us(t1, t2)
+                  << "us matrix=" << us(t2, t3) << "us soft=" << us(t3, t4) << "us\n";
+    }
+}
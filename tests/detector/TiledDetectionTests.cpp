@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "core/engine/model/detector/NmsEngine.h"
+#include "core/engine/model/detector/TileLayout.h"
+#include "core/engine/model/detector/YoloDetector.h"
+
+// 4K 画面按 640 切片：切片贴齐边界、覆盖全画面，相邻切片的重叠不小于配置值
+TEST(TiledDetectionTests, TileGridCoversFrameWithOverlap) {
+    TilingConfig cfg;
+    cfg.overlap = 0.2F;
+    const cv::Size frame(3840, 2160);
+    const auto tiles = ComputeTileGrid(frame, cfg);
+    ASSERT_EQ(tiles.size(), 8U * 4U);
+
+    for (const auto &t : tiles) {
+        EXPECT_EQ(t.width, 640);
+        EXPECT_EQ(t.height, 640);
+        EXPECT_EQ((t & cv::Rect(0, 0, frame.width, frame.height)).area(), t.area());
+    }
+    // 首尾切片贴齐画面边界，加上相邻切片互相重叠，即覆盖整个画面
+    EXPECT_EQ(tiles.front().x, 0);
+    EXPECT_EQ(tiles.front().y, 0);
+    EXPECT_EQ(tiles.back().br().x, frame.width);
+    EXPECT_EQ(tiles.back().br().y, frame.height);
+    for (size_t c = 1; c < 8; ++c) EXPECT_GE(tiles[c - 1].br().x - tiles[c].x, 128);
+    for (size_t r = 1; r < 4; ++r) EXPECT_GE(tiles[(r - 1) * 8].br().y - tiles[r * 8].y, 128);
+
+    // 画面小于切片时只有一个切片
+    const auto single = ComputeTileGrid(cv::Size(500, 300), cfg);
+    ASSERT_EQ(single.size(), 1U);
+    EXPECT_EQ(single[0], cv::Rect(0, 0, 500, 300));
+}
+
+// 合并 NMS：切缝两侧的半截框与包含在完整框内的截断框都并回一个框，不同类别不合并
+TEST(TiledDetectionTests, MergeNmsJoinsBoxesCutAtSeams) {
+    const std::vector<BBox> boxes = {
+        BBox(cv::Rect2f(100, 100, 30, 80), 0, 0.8F),   // 切缝左侧的半截
+        BBox(cv::Rect2f(115, 100, 25, 80), 0, 0.7F),   // 切缝右侧的半截
+        BBox(cv::Rect2f(400, 100, 40, 80), 0, 0.9F),   // 完整框
+        BBox(cv::Rect2f(400, 100, 20, 80), 0, 0.5F),   // 同一目标在相邻切片中被截断
+        BBox(cv::Rect2f(400, 100, 20, 80), 1, 0.6F),   // 其它类别
+    };
+    NmsParams params;
+    params.method = NmsMethod::Merge;
+    params.use_iom = true;
+    params.overlap_threshold = 0.5F;
+    NmsEngine engine;
+    std::vector<BBox> out;
+    engine.run(boxes, params, out);
+
+    ASSERT_EQ(out.size(), 3U);
+    EXPECT_EQ(out[0].box, cv::Rect2f(400, 100, 40, 80));
+    EXPECT_FLOAT_EQ(out[0].score, 0.9F);
+    EXPECT_EQ(out[1].box, cv::Rect2f(100, 100, 40, 80));
+    EXPECT_FLOAT_EQ(out[1].score, 0.8F);
+    EXPECT_EQ(out[2].class_id, 1);
+}
+
+// 吞吐对比：4K 画面切片检测 vs 把整帧放大输入（需要模型；放大输入还要求模型 H/W 为动态维度）
+TEST(TiledDetectionTests, BenchmarkTiledAgainstUpscaledInput) {
+    const std::filesystem::path model_path = std::filesystem::path(PROJECT_ROOT_DIR) / "model" / "yolo12n.onnx";
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "未找到模型: " << model_path;
+    }
+
+    cv::Mat frame(2160, 3840, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    constexpr int kIters = 5;
+    auto fps = [&](YoloDetector &detector) {
+        detector.detect(frame, 0);  // 预热：建好绑定与插值表
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIters; ++i) detector.detect(frame, i);
+        const auto t1 = std::chrono::steady_clock::now();
+        return kIters / std::chrono::duration<double>(t1 - t0).count();
+    };
+
+    DetectorConfig base;
+    base.ort_env_config.model_path = model_path.string();
+
+    DetectorConfig tiled_cfg = base;
+    tiled_cfg.tiling.enabled = true;
+    YoloDetector tiled(tiled_cfg);
+    const double tiled_fps = fps(tiled);
+    const size_t tile_count = ComputeTileGrid(frame.size(), tiled_cfg.tiling).size();
+
+    YoloDetector full(base);
+    const double full_fps = fps(full);
+
+    double upscaled_fps = 0.0;
+    try {
+        DetectorConfig upscaled_cfg = base;
+        upscaled_cfg.input_width = 1920;
+        upscaled_cfg.input_height = 1088;
+        YoloDetector upscaled(upscaled_cfg);
+        upscaled_fps = fps(upscaled);
+    } catch (const std::exception &e) {
+        std::cout << "[Tiling] 放大输入不可用（模型输入尺寸固定）: " << e.what() << "\n";
+    }
+
+    std::cout << "[Tiling] frame=3840x2160 tiles=" << tile_count << " tiled=" << tiled_fps
+              << "fps upscaled(1920x1088)=" << upscaled_fps << "fps full(640)=" << full_fps << "fps\n";
+    EXPECT_GT(tiled_fps, 0.0);
+}
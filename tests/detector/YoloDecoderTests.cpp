@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "core/engine/model/detector/YoloDecoder.h"
+#include "core/simd/Simd.h"
+
+namespace {
+// 参考实现：与解码器替换前 YoloDetector::runInference 的逐 anchor 标量解码一致
+std::vector<BBox> ReferenceDecode(const float *data, const std::vector<int64_t> &shape,
+                                  const YoloDecodeParams &params, const std::vector<int> &focus) {
+    const YoloOutputLayout layout = ResolveYoloOutputLayout(shape);
+    const size_t num_boxes = layout.num_boxes;
+    const size_t attr_count = layout.attr_count;
+    auto value_at = [&](size_t box_idx, size_t attr_idx) -> float {
+        if (layout.channels_first) {
+            return data[attr_idx * num_boxes + box_idx];
+        }
+        return data[box_idx * attr_count + attr_idx];
+    };
+
+    std::vector<BBox> out;
+    const float width = static_cast<float>(params.original_size.width);
+    const float height = static_cast<float>(params.original_size.height);
+    for (size_t i = 0; i < num_boxes; ++i) {
+        const bool no_objectness = (attr_count == 84);
+        const size_t class_start = no_objectness ? 4 : 5;
+        const float objectness = no_objectness ? 1.0F : value_at(i, 4);
+
+        float best_class_score = 0.0F;
+        int best_class = -1;
+        for (size_t c = class_start; c < attr_count; ++c) {
+            const float cls_score = value_at(i, c);
+            if (cls_score > best_class_score) {
+                best_class_score = cls_score;
+                best_class = static_cast<int>(c - class_start);
+            }
+        }
+        const float final_score = objectness * best_class_score;
+        if (final_score < params.score_threshold) continue;
+        if (!focus.empty() && std::find(focus.begin(), focus.end(), best_class) == focus.end()) continue;
+
+        const float cx = value_at(i, 0);
+        const float cy = value_at(i, 1);
+        const float w = value_at(i, 2);
+        const float h = value_at(i, 3);
+        float x0 = std::clamp((cx - w / 2.0F - params.pad_x) / params.scale, 0.0F, width);
+        float y0 = std::clamp((cy - h / 2.0F - params.pad_y) / params.scale, 0.0F, height);
+        float x1 = std::clamp((cx + w / 2.0F - params.pad_x) / params.scale, 0.0F, width);
+        float y1 = std::clamp((cy + h / 2.0F - params.pad_y) / params.scale, 0.0F, height);
+        if (params.filter_edge_boxes && (x0 <= 0.0F || y0 <= 0.0F || x1 >= width || y1 >= height)) continue;
+        if (x1 <= x0 || y1 <= y0) continue;
+        out.emplace_back(cv::Rect2f(cv::Point2f(x0, y0), cv::Point2f(x1, y1)), best_class, final_score);
+    }
+    return out;
+}
+
+// 生成类似 YOLO 的随机输出：大多数 anchor 分数很低，少量 anchor 有高分类别
+std::vector<float> MakeOutput(size_t anchors, size_t attrs, bool channels_first, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> low(0.0F, 0.05F);
+    std::uniform_real_distribution<float> high(0.3F, 1.0F);
+    std::uniform_real_distribution<float> coord(0.0F, 640.0F);
+    std::uniform_real_distribution<float> size(4.0F, 200.0F);
+    std::uniform_int_distribution<int> pick(0, 19);
+
+    const size_t class_start = attrs == 84 ? 4 : 5;
+    std::vector<float> data(anchors * attrs);
+    auto at = [&](size_t i, size_t a) -> float & {
+        return channels_first ? data[a * anchors + i] : data[i * attrs + a];
+    };
+    for (size_t i = 0; i < anchors; ++i) {
+        at(i, 0) = coord(rng);
+        at(i, 1) = coord(rng);
+        at(i, 2) = size(rng);
+        at(i, 3) = size(rng);
+        if (class_start == 5) at(i, 4) = high(rng);
+        for (size_t a = class_start; a < attrs; ++a) at(i, a) = low(rng);
+        if (pick(rng) == 0) {
+            // 随机若干类别给出高分，覆盖"关注类别不是最高分"的情况
+            at(i, class_start + static_cast<size_t>(pick(rng))) = high(rng);
+            at(i, class_start + static_cast<size_t>(pick(rng) % 3)) = high(rng);
+        }
+    }
+    return data;
+}
+
+void ExpectSameBoxes(const std::vector<BBox> &actual, const std::vector<BBox> &expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].class_id, expected[i].class_id);
+        EXPECT_EQ(actual[i].score, expected[i].score);
+        EXPECT_EQ(actual[i].box.x, expected[i].box.x);
+        EXPECT_EQ(actual[i].box.y, expected[i].box.y);
+        EXPECT_EQ(actual[i].box.width, expected[i].box.width);
+        EXPECT_EQ(actual[i].box.height, expected[i].box.height);
+    }
+}
+
+YoloDecodeParams MakeParams() {
+    YoloDecodeParams params;
+    params.score_threshold = 0.5F;
+    params.scale = 0.5F;
+    params.pad_x = 0.0F;
+    params.pad_y = 140.0F;
+    params.original_size = cv::Size(1280, 720);
+    return params;
+}
+}  // namespace
+
+TEST(YoloDecoderTests, MatchesReferenceForAllLayouts) {
+    const YoloDecodeParams params = MakeParams();
+    const std::vector<std::vector<int>> focus_sets = {{}, {0}, {0, 2, 7}, {100}};
+    const size_t anchors = 8400 + 13;  // 非向量宽度整数倍，覆盖尾部
+
+    for (size_t attrs : {size_t{84}, size_t{85}}) {
+        for (bool channels_first : {true, false}) {
+            const auto data = MakeOutput(anchors, attrs, channels_first, 7U + static_cast<unsigned>(attrs));
+            const std::vector<int64_t> shape = channels_first
+                ? std::vector<int64_t>{1, static_cast<int64_t>(attrs), static_cast<int64_t>(anchors)}
+                : std::vector<int64_t>{1, static_cast<int64_t>(anchors), static_cast<int64_t>(attrs)};
+            const YoloOutputLayout layout = ResolveYoloOutputLayout(shape);
+            ASSERT_EQ(layout.channels_first, channels_first);
+
+            for (const auto &focus : focus_sets) {
+                const auto expected = ReferenceDecode(data.data(), shape, params, focus);
+                for (bool use_simd : {true, false}) {
+                    for (size_t parallel_min : {size_t{0}, size_t{1} << 30}) {
+                        YoloDecoder decoder;
+                        decoder.setFocusClasses(focus);
+                        decoder.setUseSimd(use_simd);
+                        decoder.setParallelMinAnchors(parallel_min);
+                        std::vector<BBox> actual;
+                        decoder.decode(data.data(), layout, params, actual);
+                        ExpectSameBoxes(actual, expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 粗略对比：关注单一类别时，新解码器相对逐 anchor 标量解码的耗时
+TEST(YoloDecoderTests, BenchmarkAgainstScalarReference) {
+    const YoloDecodeParams params = MakeParams();
+    const size_t anchors = 8400;
+    const auto data = MakeOutput(anchors, 84, true, 42U);
+    const std::vector<int64_t> shape{1, 84, static_cast<int64_t>(anchors)};
+    const YoloOutputLayout layout = ResolveYoloOutputLayout(shape);
+
+    constexpr int kIters = 50;
+    for (const std::vector<int> &focus : {std::vector<int>{}, std::vector<int>{0}}) {
+        YoloDecoder decoder;
+        decoder.setFocusClasses(focus);
+        std::vector<BBox> out;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIters; ++i) {
+            out.clear();
+            decoder.decode(data.data(), layout, params, out);
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        size_t ref_count = 0;
+        for (int i = 0; i < kIters; ++i) {
+            ref_count = ReferenceDecode(data.data(), shape, params, focus).size();
+        }
+        const auto t2 = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(out.size(), ref_count);
+        const double fast_us = std::chrono::duration<double, std::micro>(t1 - t0).count() / kIters;
+        const double ref_us = std::chrono::duration<double, std::micro>(t2 - t1).count() / kIters;
+        std::cout << "[YoloDecoder] isa=" << simd::ActiveIsaName()
+                  << " focus=" << (focus.empty() ? "all" : "class 0")
+                  << " decoder=" << fast_us << "us reference=" << ref_us << "us\n";
+    }
+}
@@ -4,15 +4,17 @@
 
 #include <opencv2/opencv.hpp>
 
-#include "core/processor/model/detector/YoloDetector.h"
+#include "core/engine/model/detector/YoloDetector.h"
 
 TEST(YoloDetectorTests, DetectsOnBlankFrame) {
     constexpr const char *kProjectRoot = PROJECT_ROOT_DIR;
     const std::filesystem::path model_path = std::filesystem::path(kProjectRoot) / "model" / "yolo12n.onnx";
-    ASSERT_TRUE(std::filesystem::exists(model_path));
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "未找到模型: " << model_path;
+    }
 
     DetectorConfig config;
-    config.model_path = model_path.string();
+    config.ort_env_config.model_path = model_path.string();
 
     YoloDetector detector(config);
 
@@ -28,7 +30,9 @@ TEST(YoloDetectorTests, ManualInspectOnRealImage) {
     constexpr const char *kProjectRoot = PROJECT_ROOT_DIR;
 
     const std::filesystem::path model_path = std::filesystem::path(kProjectRoot) / "model" / "yolo12n.onnx";
-    ASSERT_TRUE(std::filesystem::exists(model_path));
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "未找到模型: " << model_path;
+    }
 
     // 允许通过环境变量 DETECTOR_TEST_IMAGE 指定测试图片，默认使用 capture/sample.jpg
     const char *env_path = std::getenv("DETECTOR_TEST_IMAGE");
@@ -40,7 +44,7 @@ TEST(YoloDetectorTests, ManualInspectOnRealImage) {
     }
 
     DetectorConfig config;
-    config.model_path = model_path.string();
+    config.ort_env_config.model_path = model_path.string();
 
     YoloDetector detector(config);
 
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/engine/FrameProcessor.h"
+#include "core/engine/LookaheadDataIterator.h"
+#include "core/engine/PipelinedDataIterator.h"
+#include "core/engine/TrackingEngine.h"
+
+namespace {
+// 两个匀速移动目标（原帧坐标）
+std::vector<BBox> SceneBoxes(int frame_index) {
+    const float dx = static_cast<float>(frame_index) * 2.0F;
+    return {BBox(cv::Rect2f(20 + dx, 20, 40, 80), 0, 0.9F), BBox(cv::Rect2f(300 + dx, 100, 40, 80), 0, 0.8F)};
+}
+
+// 整帧检测输出全部目标并记录被调用的帧；区域检测只输出完整落在区域内的目标（区域局部坐标）
+class FakeDetector : public IDetector {
+public:
+    explicit FakeDetector(std::vector<int> &calls, std::vector<size_t> *region_calls = nullptr)
+        : calls_(calls), region_calls_(region_calls) {}
+    using IDetector::detect;
+    std::vector<BBox> detect(const cv::Mat &, int frame_index) override {
+        calls_.push_back(frame_index);
+        return SceneBoxes(frame_index);
+    }
+    std::vector<std::vector<BBox>> detectRegions(const cv::Mat &, const std::vector<cv::Rect> &regions,
+                                                 int frame_index) override {
+        if (region_calls_) region_calls_->push_back(regions.size());
+        std::vector<std::vector<BBox>> out(regions.size());
+        for (size_t k = 0; k < regions.size(); ++k) {
+            const cv::Rect2f region(regions[k]);
+            for (auto b : SceneBoxes(frame_index)) {
+                if ((b.box & region).area() < b.box.area()) continue;
+                b.box.x -= region.x;
+                b.box.y -= region.y;
+                out[k].push_back(b);
+            }
+        }
+        return out;
+    }
+
+private:
+    std::vector<int> &calls_;
+    std::vector<size_t> *region_calls_;
+};
+
+// 按 x 坐标区分两个目标的特征提取器
+class FakeExtractor : public IFeatureExtractor {
+public:
+    using IFeatureExtractor::extractBatch;
+    std::vector<float> extract(const cv::Mat &) override { return {1.0F, 0.0F}; }
+    std::vector<std::vector<float>> extractBatch(const cv::Mat &, const std::vector<cv::Rect> &rois) override {
+        std::vector<std::vector<float>> feats;
+        for (const auto &roi : rois) feats.push_back(roi.x < 200 ? std::vector<float>{1.0F, 0.0F} : std::vector<float>{0.0F, 1.0F});
+        return feats;
+    }
+};
+
+std::vector<LabeledFrame> RunFrames(const TrackingEngineConfig &cfg, int count, std::vector<int> &calls,
+                                    std::vector<size_t> *region_calls = nullptr) {
+    FrameProcessor processor(std::make_unique<FakeDetector>(calls, region_calls), std::make_unique<FakeExtractor>(),
+                             std::make_unique<TrackerManager>(cfg.tracker_mgr), cfg, 1.0);
+    std::vector<LabeledFrame> labels;
+    for (int i = 0; i < count; ++i) {
+        FrameTask task;
+        task.frame_index = i;
+        task.frame = cv::Mat(480, 640, CV_8UC3, cv::Scalar(0, 0, 0));
+        processor.detect(task);
+        processor.extract(task);
+        processor.track(task);
+        labels.push_back(task.label);
+    }
+    return labels;
+}
+
+// 输出 count 个黑帧的图像迭代器
+class BlankFrames : public IImageIterator {
+public:
+    explicit BlankFrames(int count) : count_(count) {}
+    bool hasNext() const override { return produced_ < count_; }
+    bool next(cv::Mat &frame) override {
+        if (produced_ >= count_) return false;
+        frame = cv::Mat(480, 640, CV_8UC3, cv::Scalar(0, 0, 0));
+        ++produced_;
+        return true;
+    }
+
+private:
+    int count_;
+    int produced_ = 0;
+};
+
+std::vector<LabeledFrame> Drain(ILabeledDataIterator &iter) {
+    std::vector<LabeledFrame> labels;
+    LabeledFrame label;
+    while (iter.hasNext() && iter.next(label)) labels.push_back(label);
+    return labels;
+}
+
+// 逐帧比较帧号、目标数、轨迹 ID 与框
+void ExpectSameLabels(const std::vector<LabeledFrame> &labels, const std::vector<LabeledFrame> &expected) {
+    ASSERT_EQ(labels.size(), expected.size());
+    for (size_t i = 0; i < labels.size(); ++i) {
+        EXPECT_EQ(labels[i].frame_index, expected[i].frame_index);
+        ASSERT_EQ(labels[i].objs.size(), expected[i].objs.size()) << "frame " << i;
+        for (size_t k = 0; k < labels[i].objs.size(); ++k) {
+            EXPECT_EQ(labels[i].objs[k].id, expected[i].objs[k].id) << "frame " << i;
+            EXPECT_EQ(labels[i].objs[k].bbox, expected[i].objs[k].bbox) << "frame " << i;
+        }
+    }
+}
+
+std::unique_ptr<FrameProcessor> MakeProcessor(const TrackingEngineConfig &cfg, std::vector<int> &calls) {
+    return std::make_unique<FrameProcessor>(std::make_unique<FakeDetector>(calls), std::make_unique<FakeExtractor>(),
+                                            std::make_unique<TrackerManager>(cfg.tracker_mgr), cfg, 1.0);
+}
+}  // namespace
+
+// 固定间隔：只在关键帧检测，其余帧输出预测且轨迹不会因跳过检测而丢失
+TEST(FrameProcessorTests, KeyframeIntervalSkipsDetection) {
+    TrackingEngineConfig cfg;
+    cfg.keyframe.interval = 3;
+    // 血量很低且只要存活就输出：若非关键帧也做未命中扣血，轨迹会很快被清除
+    cfg.tracker_mgr.tracker_cfg.max_life = 4;
+    cfg.tracker_mgr.tracker_cfg.healthy_percent = 0.1F;
+    std::vector<int> calls;
+    const auto labels = RunFrames(cfg, 30, calls);
+
+    ASSERT_EQ(calls.size(), 10U);
+    for (size_t k = 0; k < calls.size(); ++k) EXPECT_EQ(calls[k], static_cast<int>(k * 3));
+    // 轨迹建立后每一帧（包括非关键帧）都有输出
+    for (size_t i = 12; i < labels.size(); ++i) EXPECT_EQ(labels[i].objs.size(), 2U) << "frame " << i;
+}
+
+// 自适应：场景稳定后检测间隔逐步拉长，但不超过上限
+TEST(FrameProcessorTests, AdaptiveKeyframesBackOffWhenStable) {
+    TrackingEngineConfig cfg;
+    cfg.keyframe.adaptive = true;
+    cfg.keyframe.max_interval = 4;
+    std::vector<int> calls;
+    RunFrames(cfg, 60, calls);
+
+    ASSERT_GT(calls.size(), 3U);
+    EXPECT_LT(calls.size(), 30U);
+    for (size_t k = 1; k < calls.size(); ++k) EXPECT_LE(calls[k] - calls[k - 1], 4);
+    EXPECT_EQ(calls.back() - calls[calls.size() - 2], 4);
+}
+
+// 局部检测：整帧检测之间只在两个目标周围各取一个区域合批检测，轨迹与输出不受影响
+TEST(FrameProcessorTests, LocalDetectionAroundTracksBetweenFullFrames) {
+    TrackingEngineConfig cfg;
+    cfg.local_detection.enabled = true;
+    cfg.local_detection.full_frame_interval = 5;
+    cfg.tracker_mgr.tracker_cfg.healthy_percent = 0.1F;
+    std::vector<int> calls;
+    std::vector<size_t> region_calls;
+    const auto labels = RunFrames(cfg, 20, calls, &region_calls);
+
+    EXPECT_EQ(calls, (std::vector<int>{0, 5, 10, 15}));
+    ASSERT_EQ(region_calls.size(), 16U);
+    for (size_t n : region_calls) EXPECT_EQ(n, 2U);  // 两个目标相距很远，区域不合并
+
+    ASSERT_EQ(labels[6].objs.size(), 2U);
+    for (size_t i = 6; i < labels.size(); ++i) {
+        ASSERT_EQ(labels[i].objs.size(), 2U) << "frame " << i;
+        const auto truth = SceneBoxes(static_cast<int>(i));
+        for (size_t k = 0; k < 2; ++k) {
+            EXPECT_EQ(labels[i].objs[k].id, labels[6].objs[k].id);
+            EXPECT_NEAR(labels[i].objs[k].bbox.x, truth[k].box.x, 4.0) << "frame " << i;
+        }
+    }
+}
+
+// 多个 ROI：各区域的裁剪合成一个 batch 检测；多边形区域外的目标仍被跟踪，但不输出
+TEST(FrameProcessorTests, MultipleRoisDetectCropsAndFilterOutput) {
+    TrackingEngineConfig cfg;
+    cfg.roi.enabled = true;
+    RoiZone left;
+    left.x = 0.0F, left.y = 0.0F, left.w = 0.2F, left.h = 0.5F;
+    RoiZone wedge;  // 外接矩形包含第二个目标，但目标中心在多边形外
+    wedge.shape = RoiShape::Polygon;
+    wedge.polygon = {0.4F, 0.0F, 1.0F, 0.0F, 1.0F, 1.0F};
+    cfg.roi.zones = {left, wedge};
+    cfg.tracker_mgr.tracker_cfg.healthy_percent = 0.1F;
+    std::vector<int> calls;
+    std::vector<size_t> region_calls;
+    const auto labels = RunFrames(cfg, 20, calls, &region_calls);
+
+    EXPECT_TRUE(calls.empty());
+    ASSERT_EQ(region_calls.size(), 20U);
+    for (size_t n : region_calls) EXPECT_EQ(n, 2U);
+    for (size_t i = 6; i < labels.size(); ++i) {
+        ASSERT_EQ(labels[i].objs.size(), 1U) << "frame " << i;
+        EXPECT_NEAR(labels[i].objs[0].bbox.x, SceneBoxes(static_cast<int>(i))[0].box.x, 4.0);
+    }
+}
+
+// 前瞻并行检测：检测分摊到多个检测器上，跟踪结果与串行逐帧处理完全一致
+TEST(FrameProcessorTests, LookaheadDetectionMatchesSerial) {
+    TrackingEngineConfig cfg;
+    cfg.keyframe.interval = 2;
+    std::vector<int> serial_calls;
+    const auto expected = RunFrames(cfg, 40, serial_calls);
+
+    // 每个检测器各自记录调用，避免多线程写同一个容器
+    std::vector<std::vector<int>> calls(3);
+    std::vector<std::unique_ptr<IDetector>> extra;
+    extra.push_back(std::make_unique<FakeDetector>(calls[1]));
+    extra.push_back(std::make_unique<FakeDetector>(calls[2]));
+    auto processor = MakeProcessor(cfg, calls[0]);
+    ASSERT_TRUE(processor->statelessDetection());
+    LookaheadConfig lookahead;
+    lookahead.depth = 4;
+    LookaheadDataIterator iter(std::make_unique<BlankFrames>(40), std::move(processor), std::move(extra), lookahead);
+
+    ExpectSameLabels(Drain(iter), expected);
+    EXPECT_EQ(calls[0].size() + calls[1].size() + calls[2].size(), serial_calls.size());
+}
+
+// 流水线模式：各种阶段划分下输出帧序、检测结果与轨迹 ID 都与串行逐帧处理一致
+TEST(FrameProcessorTests, PipelineMatchesSerial) {
+    TrackingEngineConfig cfg;
+    std::vector<int> serial_calls;
+    const auto expected = RunFrames(cfg, 40, serial_calls);
+
+    for (int stages = 2; stages <= 4; ++stages) {
+        SCOPED_TRACE(stages);
+        PipelineConfig pipeline;
+        pipeline.stage_count = stages;
+        std::vector<int> calls;
+        {
+            PipelinedDataIterator iter(std::make_unique<BlankFrames>(40), MakeProcessor(cfg, calls), pipeline);
+            ExpectSameLabels(Drain(iter), expected);
+        }
+        EXPECT_EQ(calls, serial_calls);
+    }
+}
+
+// 中途销毁迭代器：阻塞在满队列上的各阶段线程被唤醒并退出，析构能正常返回
+TEST(FrameProcessorTests, PipelineShutsDownMidStream) {
+    TrackingEngineConfig cfg;
+    std::vector<int> calls;
+    {
+        PipelinedDataIterator iter(std::make_unique<BlankFrames>(100000), MakeProcessor(cfg, calls), PipelineConfig{});
+        LabeledFrame label;
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(iter.hasNext());
+            ASSERT_TRUE(iter.next(label));
+            EXPECT_EQ(label.frame_index, i);
+        }
+    }
+    // 有界队列限制了检测领先输出的帧数
+    EXPECT_LT(calls.size(), 20U);
+}
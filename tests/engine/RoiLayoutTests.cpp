@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "core/engine/RoiLayout.h"
+
+// 多个区域：重叠的外接矩形合并为一个检测裁剪；多边形区域按掩膜过滤，外接矩形内多边形外的点不算在内
+TEST(RoiLayoutTests, ZonesMergeCropsAndFilterByPolygon) {
+    RoiConfig cfg;
+    cfg.enabled = true;
+    RoiZone a;
+    a.x = 0.0F, a.y = 0.0F, a.w = 0.25F, a.h = 0.25F;
+    RoiZone b;
+    b.x = 0.2F, b.y = 0.2F, b.w = 0.1F, b.h = 0.1F;
+    RoiZone tri;
+    tri.name = "crossing";
+    tri.shape = RoiShape::Polygon;
+    tri.polygon = {0.5F, 0.5F, 1.0F, 0.5F, 0.5F, 1.0F};
+    cfg.zones = {a, b, tri};
+
+    const RoiLayout layout(cfg, cv::Size(1000, 1000));
+    ASSERT_TRUE(layout.active());
+    ASSERT_EQ(layout.zones().size(), 3U);
+    EXPECT_EQ(layout.zones()[0].name, "ROI 1");
+    EXPECT_EQ(layout.zones()[2].name, "crossing");
+    ASSERT_EQ(layout.crops().size(), 2U);
+    EXPECT_EQ(layout.crops()[0], cv::Rect(0, 0, 300, 300));
+    EXPECT_EQ(layout.crops()[1], cv::Rect(500, 500, 500, 500));
+    EXPECT_EQ(layout.bounds(), cv::Rect(0, 0, 1000, 1000));
+
+    EXPECT_TRUE(layout.contains(cv::Point2f(100, 100)));
+    EXPECT_TRUE(layout.contains(cv::Point2f(280, 280)));
+    EXPECT_FALSE(layout.contains(cv::Point2f(400, 100)));
+    EXPECT_TRUE(layout.contains(cv::Point2f(600, 600)));
+    EXPECT_FALSE(layout.contains(cv::Point2f(950, 950)));  // 在三角形外接矩形内、三角形外
+}
+
+// 未配置 zones 时沿用单个矩形 ROI；未启用时不过滤
+TEST(RoiLayoutTests, LegacySingleRectAndDisabled) {
+    RoiConfig cfg;
+    cfg.enabled = true;
+    cfg.x = 0.5F, cfg.y = 0.0F, cfg.w = 0.5F, cfg.h = 0.5F;
+    const RoiLayout layout(cfg, cv::Size(640, 480));
+    ASSERT_EQ(layout.zones().size(), 1U);
+    EXPECT_EQ(layout.zones()[0].name, "ROI");
+    ASSERT_EQ(layout.crops().size(), 1U);
+    EXPECT_EQ(layout.crops()[0], cv::Rect(320, 0, 320, 240));
+    EXPECT_FALSE(layout.contains(cv::Point2f(10, 10)));
+
+    cfg.enabled = false;
+    const RoiLayout full(cfg, cv::Size(640, 480));
+    EXPECT_FALSE(full.active());
+    EXPECT_TRUE(full.contains(cv::Point2f(10, 10)));
+    EXPECT_EQ(full.bounds(), cv::Rect(0, 0, 640, 480));
+}
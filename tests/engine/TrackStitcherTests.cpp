@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/engine/SegmentParallelTracker.h"
+#include "core/engine/TrackStitcher.h"
+
+namespace {
+// 两个匀速移动的目标 A/B（全局帧号 f），以 local_a/local_b 作为某个分段内的局部 ID
+LabeledFrame SceneFrame(int f, int local_a, int local_b, std::vector<float> feat_b = {0.0F, 1.0F}) {
+    LabeledFrame frame;
+    frame.frame_index = f;
+    frame.objs.push_back({local_a, cv::Rect(10 + f, 10, 40, 80), 0, 0.9F, {1.0F, 0.0F}});
+    frame.objs.push_back({local_b, cv::Rect(300 - f, 10, 40, 80), 0, 0.8F, std::move(feat_b)});
+    return frame;
+}
+
+// 两段：[0,50) 与 [50,100)，重叠窗口为 [40,50)；第二段中 A/B 的局部 ID 互换，另有一个只在第二段出现的新目标
+std::vector<SegmentResult> TwoSegments(std::vector<float> feat_b_in_second) {
+    std::vector<SegmentResult> segs(2);
+    segs[0].begin = 0;
+    WindowCollector tail(40, 50);
+    for (int f = 0; f < 50; ++f) {
+        segs[0].frames.push_back(SceneFrame(f, 0, 1));
+        tail.add(segs[0].frames.back());
+    }
+    segs[0].tail = tail.tracks();
+
+    segs[1].begin = 50;
+    WindowCollector head(40, 50);
+    for (int f = 40; f < 100; ++f) {
+        LabeledFrame frame = SceneFrame(f, 1, 0, feat_b_in_second);
+        if (f >= 60) frame.objs.push_back({2, cv::Rect(500, 300, 40, 80), 0, 0.7F, {}});
+        head.add(frame);
+        if (f >= 50) segs[1].frames.push_back(frame);
+    }
+    segs[1].head = head.tracks();
+    return segs;
+}
+}  // namespace
+
+// 重叠窗口内框重合且外观一致的轨迹沿用前一段的全局 ID，新目标分配新的全局 ID
+TEST(TrackStitcherTests, StitchesIdsAcrossSegments) {
+    auto segs = TwoSegments({0.0F, 1.0F});
+    const auto frames = StitchSegments(segs, OfflineConfig{});
+
+    ASSERT_EQ(frames.size(), 100U);
+    for (int f = 0; f < 100; ++f) {
+        ASSERT_EQ(frames[f].frame_index, f);
+        EXPECT_EQ(frames[f].objs[0].bbox.x, 10 + f);
+        EXPECT_EQ(frames[f].objs[0].id, 0) << "frame " << f;  // A
+        EXPECT_EQ(frames[f].objs[1].id, 1) << "frame " << f;  // B
+    }
+    ASSERT_EQ(frames[70].objs.size(), 3U);
+    EXPECT_EQ(frames[70].objs[2].id, 2);
+}
+
+// 框重合但外观不一致时不拼接，宁可分配新 ID 也不串号
+TEST(TrackStitcherTests, ReidVetoesMismatchedAppearance) {
+    auto segs = TwoSegments({1.0F, 0.0F});  // 第二段中 B 的外观与前一段的 B 正交
+    const auto frames = StitchSegments(segs, OfflineConfig{});
+
+    EXPECT_EQ(frames[60].objs[0].id, 0);  // A 照常拼接
+    EXPECT_EQ(frames[60].objs[1].id, 2);  // B 被当成新轨迹
+    EXPECT_EQ(frames[60].objs[2].id, 3);
+}
+
+// 分段数受核心数与每段最少帧数约束，区间首尾相接覆盖全部帧
+TEST(TrackStitcherTests, PlanSegmentsCoversAllFrames) {
+    OfflineConfig cfg;
+    cfg.min_segment_frames = 300;
+    const auto ranges = SegmentParallelTracker::planSegments(1000, cfg, 8);
+    ASSERT_EQ(ranges.size(), 3U);
+    EXPECT_EQ(ranges.front().begin, 0);
+    EXPECT_EQ(ranges.back().end, 1000);
+    for (size_t k = 1; k < ranges.size(); ++k) EXPECT_EQ(ranges[k].begin, ranges[k - 1].end);
+
+    cfg.segments = 2;
+    EXPECT_EQ(SegmentParallelTracker::planSegments(1000, cfg, 8).size(), 2U);
+    EXPECT_EQ(SegmentParallelTracker::planSegments(-1, cfg, 8).size(), 1U);
+}
@@ -1,27 +1,72 @@
 #include <gtest/gtest.h>
+#include <cmath>
 #include <filesystem>
 #include <numeric>
 
 #include <opencv2/opencv.hpp>
 
-#include "core/processor/model/feature_extractor/IFeatureExtractor.h"
+#include "core/engine/model/feature_extractor/FeatureExtractor.h"
 
 TEST(FeatureExtractorTests, ExtractFeatureOnBlank) {
     constexpr const char *kProjectRoot = PROJECT_ROOT_DIR;
     const std::filesystem::path model_path = std::filesystem::path(kProjectRoot) / "model" / "osnet_x1_0.onnx";
-    ASSERT_TRUE(std::filesystem::exists(model_path));
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "未找到模型: " << model_path;
+    }
 
     FeatureExtractorConfig cfg;
-    cfg.model_path = model_path.string();
+    cfg.ort_env_config.model_path = model_path.string();
     cfg.input_height = 256;
     cfg.input_width = 128;
 
-    auto extractor = CreateFeatureExtractor(cfg);
+    FeatureExtractor extractor(cfg);
 
     cv::Mat img(256, 128, CV_8UC3, cv::Scalar(0, 0, 0));
-    const auto feat = extractor->extract(img);
+    const auto feat = extractor.extract(img);
 
     EXPECT_GT(feat.size(), 0U);
     float norm = std::sqrt(std::inner_product(feat.begin(), feat.end(), feat.begin(), 0.0f));
     EXPECT_NEAR(norm, 1.0f, 1e-3);
 }
+
+// 分块批量提取与逐个 extract 的结果一致：覆盖恰好整块（6 = 3 + 3）与末尾不满一块（7 = 3 + 3 + 1）
+TEST(FeatureExtractorTests, BatchMatchesSingleAcrossChunks) {
+    constexpr const char *kProjectRoot = PROJECT_ROOT_DIR;
+    const std::filesystem::path model_path = std::filesystem::path(kProjectRoot) / "model" / "osnet_x1_0.onnx";
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "未找到模型: " << model_path;
+    }
+
+    FeatureExtractorConfig cfg;
+    cfg.ort_env_config.model_path = model_path.string();
+    cfg.max_batch_size = 3;
+    FeatureExtractor extractor(cfg);
+
+    // 不同位置的渐变纹理，保证各裁剪框的特征互不相同
+    cv::Mat frame(480, 640, CV_8UC3);
+    for (int y = 0; y < frame.rows; ++y) {
+        uchar *row = frame.ptr<uchar>(y);
+        for (int x = 0; x < frame.cols; ++x) {
+            row[3 * x] = static_cast<uchar>(x % 256);
+            row[3 * x + 1] = static_cast<uchar>(y % 256);
+            row[3 * x + 2] = static_cast<uchar>((x + y) % 256);
+        }
+    }
+    std::vector<cv::Rect> rois;
+    for (int i = 0; i < 7; ++i) {
+        rois.emplace_back(40 * i, 25 * i, 60 + 5 * i, 120);
+    }
+
+    for (size_t n : {size_t{6}, size_t{7}}) {
+        const std::vector<cv::Rect> subset(rois.begin(), rois.begin() + static_cast<std::ptrdiff_t>(n));
+        const auto batch = extractor.extractBatch(frame, subset);
+        ASSERT_EQ(batch.size(), n);
+        for (size_t i = 0; i < n; ++i) {
+            const auto single = extractor.extract(frame(subset[i]));
+            ASSERT_EQ(batch[i].size(), single.size()) << "n=" << n << " roi " << i;
+            for (size_t k = 0; k < single.size(); ++k) {
+                EXPECT_NEAR(batch[i][k], single[k], 1e-4f) << "n=" << n << " roi " << i << " dim " << k;
+            }
+        }
+    }
+}
@@ -1,5 +1,23 @@
 #include <gtest/gtest.h>
-#include "core/processor/model/feature_extractor/Feature.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "core/engine/model/feature_extractor/Feature.h"
+#include "core/engine/model/feature_extractor/TrackFeature.h"
+
+namespace {
+std::vector<float> RandomValues(size_t dim, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> v(dim);
+    for (auto &x : v) x = dist(rng);
+    return v;
+}
+}  // namespace
 
 TEST(FeatureTests, CosineSimilarity) {
     Feature a({1.0f, 0.0f});
@@ -25,3 +43,138 @@ TEST(FeatureTests, AddAndScale) {
     EXPECT_FLOAT_EQ(scaled.values()[1], 4.0f);
     EXPECT_FLOAT_EQ(scaled.values()[2], 6.0f);
 }
+
+// 就地 EMA 与“融合后再归一化”的参考实现一致，且结果保持单位范数、数据 64 字节对齐
+TEST(FeatureTests, EmaUpdateMatchesReference) {
+    const auto old_v = RandomValues(kOsnetFeatureDim, 1);
+    const auto new_v = RandomValues(kOsnetFeatureDim, 2);
+    const float alpha = 0.7f;
+
+    Feature track(old_v);
+    track.normalize();
+    const Feature det(new_v);
+    const Feature old_unit = track;
+    track.emaUpdate(det, alpha);
+
+    double sq = 0.0;
+    std::vector<double> ref(kOsnetFeatureDim);
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ref[i] = alpha * new_v[i] + (1.0 - alpha) * old_unit.values()[i];
+        sq += ref[i] * ref[i];
+    }
+    for (size_t i = 0; i < ref.size(); ++i) {
+        EXPECT_NEAR(track.values()[i], ref[i] / std::sqrt(sq), 1e-5);
+    }
+    EXPECT_TRUE(track.isUnit());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(track.data()) % 64, 0U);
+}
+
+// 编译期维度版本与运行期版本的余弦一致
+TEST(FeatureTests, FixedFeatureMatchesRuntime) {
+    const Feature a(RandomValues(kOsnetFeatureDim, 3));
+    const Feature b(RandomValues(kOsnetFeatureDim, 4));
+    const OsnetFeature fa(a), fb(b);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(fa.data()) % 64, 0U);
+    EXPECT_NEAR(fa.cosine_similarity(fb), a.cosine_similarity(b), 1e-5f);
+
+    // 非 512 维走运行期内核
+    const Feature c(RandomValues(100, 5)), d(RandomValues(100, 6));
+    const FixedFeature<100> fc(c), fd(d);
+    EXPECT_NEAR(fc.cosine_similarity(fd), c.cosine_similarity(d), 1e-5f);
+}
+
+// 轨迹特征：单精度 512 维走 OsnetFeature，量化存储保持运行期表示；EMA 与余弦都与 Feature 一致
+TEST(FeatureTests, TrackFeatureMatchesRuntime) {
+    const Feature a(RandomValues(kOsnetFeatureDim, 3));
+    const Feature b(RandomValues(kOsnetFeatureDim, 4));
+    TrackFeature ta(a);
+    const TrackFeature tb(b);
+    ASSERT_NE(ta.osnet(), nullptr);
+    EXPECT_NEAR(ta.cosine_similarity(tb), a.cosine_similarity(b), 1e-5f);
+
+    // 定长特征恒为单位范数，参考实现的两侧也先归一化
+    Feature ref = a.normalized();
+    ref.emaUpdate(b.normalized(), 0.7f);
+    ta.emaUpdate(tb, 0.7f);
+    EXPECT_NEAR(ta.cosine_similarity(TrackFeature(ref)), 1.0f, 1e-5f);
+
+    TrackFeature tq;
+    tq.assignConverted(ta, FeatureStorage::Int8);
+    EXPECT_EQ(tq.osnet(), nullptr);
+    EXPECT_EQ(tq.storage(), FeatureStorage::Int8);
+    EXPECT_NEAR(tq.cosine_similarity(tb), ta.cosine_similarity(tb), 1e-2f);
+}
+
+// 512 维走编译期展开的点积内核，其余维度走运行期内核，两者都与逐元素标量结果一致
+TEST(FeatureTests, OsnetDimDotMatchesScalar) {
+    for (size_t dim : {kOsnetFeatureDim, size_t{100}}) {
+        const auto va = RandomValues(dim, 3);
+        const auto vb = RandomValues(dim, 4);
+        const Feature a(va), b(vb);
+        EXPECT_NEAR(a.dot(b), simd::DotScalar(va.data(), vb.data(), dim), 1e-3f) << "dim " << dim;
+    }
+}
+
+namespace {
+// 模拟 OSNet 输出：ReLU 后的非负稀疏向量，归一化；partner 为同一目标的另一次观测
+std::vector<Feature> OsnetLikeGallery(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<Feature> gallery;
+    std::vector<float> base(kOsnetFeatureDim), v(kOsnetFeatureDim);
+    for (size_t n = 0; n < count; ++n) {
+        if (n % 2 == 0) {
+            for (auto &x : base) x = std::max(0.0f, dist(rng));
+        }
+        for (size_t i = 0; i < v.size(); ++i) v[i] = std::max(0.0f, base[i] + 0.3f * dist(rng));
+        gallery.emplace_back(v);
+        gallery.back().normalize();
+    }
+    return gallery;
+}
+}  // namespace
+
+// 半精度转换：典型值精确，舍入误差在半精度 ulp 内
+TEST(FeatureTests, HalfConversion) {
+    EXPECT_EQ(simd::FloatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(simd::FloatToHalf(-2.0f), 0xC000);
+    EXPECT_EQ(simd::FloatToHalf(65504.0f), 0x7BFF);
+    EXPECT_EQ(simd::FloatToHalf(1e6f), 0x7C00);
+    EXPECT_FLOAT_EQ(simd::HalfToFloat(0x3555), 0.333251953125f);
+    for (float x : {0.1f, -0.0371f, 3.14159f, 6e-6f, 2e-7f}) {
+        EXPECT_NEAR(simd::HalfToFloat(simd::FloatToHalf(x)), x, std::fabs(x) * 1e-3f + 6e-8f);
+    }
+}
+
+// 量化存储下的余弦与 float 路径一致（int8 误差 < 1e-2，fp16 < 1e-3），EMA 结果也保持接近
+TEST(FeatureTests, QuantizedSimilarityMatchesFloat) {
+    const auto gallery = OsnetLikeGallery(64, 7);
+    for (FeatureStorage storage : {FeatureStorage::Int8, FeatureStorage::Float16}) {
+        const float tolerance = storage == FeatureStorage::Int8 ? 1e-2f : 1e-3f;
+        std::vector<Feature> quantized;
+        for (const auto &f : gallery) {
+            quantized.push_back(f);
+            quantized.back().convertTo(storage);
+        }
+        EXPECT_EQ(quantized.front().byteSize() * (storage == FeatureStorage::Int8 ? 4 : 2),
+                  gallery.front().byteSize());
+
+        float max_err = 0.0f;
+        for (size_t i = 0; i < gallery.size(); ++i) {
+            for (size_t j = 0; j < gallery.size(); ++j) {
+                const float ref = gallery[i].cosine_similarity(gallery[j]);
+                max_err = std::max(max_err, std::fabs(quantized[i].cosine_similarity(quantized[j]) - ref));
+            }
+        }
+        EXPECT_LT(max_err, tolerance);
+
+        Feature track = gallery[0], track_q = quantized[0];
+        for (size_t k = 1; k < 8; ++k) {
+            track.emaUpdate(gallery[k], 0.7f);
+            track_q.emaUpdate(quantized[k], 0.7f);
+        }
+        EXPECT_EQ(track_q.storage(), storage);
+        EXPECT_NEAR(track_q.l2norm(), 1.0f, tolerance);
+        EXPECT_NEAR(track_q.cosine_similarity(quantized[9]), track.cosine_similarity(gallery[9]), tolerance);
+    }
+}
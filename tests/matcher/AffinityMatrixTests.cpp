@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "core/engine/tracker_manager/matcher/AffinityMatrix.h"
+#include "core/engine/tracker_manager/matcher/Matcher.h"
+#include "core/simd/Simd.h"
+
+namespace {
+// 随机场景：框集中在一片区域内以产生足够多的重叠，特征为 dim 维随机向量
+std::vector<TrackerInner> MakeInners(size_t count, int dim, unsigned seed, float extent = 400.0F) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(0.0F, extent);
+    std::uniform_real_distribution<float> size(20.0F, 80.0F);
+    std::normal_distribution<float> feat(0.0F, 1.0F);
+    std::vector<TrackerInner> items;
+    items.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<float> values(static_cast<size_t>(dim));
+        for (auto &v : values) v = feat(rng);
+        items.push_back({BBox(cv::Rect2f(pos(rng), pos(rng), size(rng), size(rng)), 0, 0.9F), Feature(values)});
+    }
+    return items;
+}
+
+// 把稀疏结果展开为稠密矩阵，未出现的组合记为 -1
+std::vector<float> ToDense(const AffinityMatrix &affinity) {
+    std::vector<float> dense(static_cast<size_t>(affinity.rows() * affinity.cols()), -1.0F);
+    for (int i = 0; i < affinity.rows(); ++i) {
+        for (int k = affinity.rowBegin(i); k < affinity.rowEnd(i); ++k) {
+            dense[static_cast<size_t>(i * affinity.cols() + affinity.col(k))] = affinity.score(k);
+        }
+    }
+    return dense;
+}
+}  // namespace
+
+// 512 维单精度特征走定长 OsnetFeature（稀疏候选时逐对定长点积），其余维度走打包路径
+TEST(AffinityMatrixTests, MatchesPairwiseScore) {
+    for (int dim : {128, static_cast<int>(kOsnetFeatureDim)}) {
+        const auto left = MakeInners(37, dim, 1U);
+        const auto right = MakeInners(53, dim, 2U);
+        ASSERT_EQ(left.front().feature.osnet() != nullptr, dim == static_cast<int>(kOsnetFeatureDim));
+        for (float iou_weight : {0.0F, 0.3F, 0.5F, 1.0F}) {
+            MatcherConfig cfg;
+            cfg.iou_weight = iou_weight;
+            cfg.feature_weight = 1.0F - iou_weight;
+            cfg.threshold = 0.2F;
+            for (bool use_simd : {true, false}) {
+                AffinityMatrix affinity;
+                affinity.setUseSimd(use_simd);
+                affinity.compute(left, right, cfg);
+                ASSERT_EQ(affinity.rows(), 37);
+                ASSERT_EQ(affinity.cols(), 53);
+                const auto dense = ToDense(affinity);
+                for (int i = 0; i < affinity.rows(); ++i) {
+                    for (int j = 0; j < affinity.cols(); ++j) {
+                        const float expected = WeightedMatchScore(left[i], right[j], cfg);
+                        const float actual = dense[static_cast<size_t>(i * affinity.cols() + j)];
+                        // 阈值附近允许舍入导致的判定差异
+                        if (std::abs(expected - cfg.threshold) < 1e-4F) continue;
+                        if (expected >= cfg.threshold) {
+                            EXPECT_NEAR(actual, expected, 1e-4F) << i << "," << j;
+                        } else {
+                            EXPECT_EQ(actual, -1.0F) << i << "," << j;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(AffinityMatrixTests, GatingKeepsResultsAndSkipsDisjointPairs) {
+    // 4K 画面上稀疏分布的目标：绝大多数组合互不相交
+    const auto left = MakeInners(300, 64, 5U, 3800.0F);
+    const auto right = MakeInners(300, 64, 6U, 3800.0F);
+    MatcherConfig cfg;
+    cfg.threshold = 0.1F;
+
+    AffinityMatrix full, gated;
+    cfg.gating = false;
+    full.compute(left, right, cfg);
+    cfg.gating = true;
+    gated.compute(left, right, cfg);
+
+    const auto a = ToDense(full), b = ToDense(gated);
+    for (size_t k = 0; k < a.size(); ++k) {
+        ASSERT_NEAR(a[k], b[k], 1e-5F) << k;
+    }
+    EXPECT_EQ(full.evaluatedPairs(), 300U * 300U);
+    EXPECT_LT(gated.evaluatedPairs(), 300U * 300U / 50U);
+}
+
+// 下标视图与拷贝出同一子集的结果一致（门控与否都覆盖）；空下标视图没有任何行
+TEST(AffinityMatrixTests, IndexedViewMatchesCopiedSubset) {
+    const auto left = MakeInners(40, 128, 7U);
+    const auto right = MakeInners(30, 128, 8U);
+    const std::vector<int> rows{1, 4, 5, 11, 23, 39};
+    std::vector<TrackerInner> subset;
+    for (int r : rows) subset.push_back(left[static_cast<size_t>(r)]);
+
+    MatcherConfig cfg;
+    cfg.threshold = 0.2F;
+    for (bool gating : {true, false}) {
+        cfg.gating = gating;
+        AffinityMatrix viewed, copied;
+        viewed.compute(TrackerInnerView(left, rows), right, cfg);
+        copied.compute(subset, right, cfg);
+        ASSERT_EQ(viewed.rows(), static_cast<int>(rows.size()));
+        EXPECT_EQ(ToDense(viewed), ToDense(copied));
+    }
+
+    AffinityMatrix none;
+    none.compute(TrackerInnerView(left, std::span<const int>()), right, cfg);
+    EXPECT_EQ(none.rows(), 0);
+}
+
+// 微基准：200 条轨迹 x 200 个检测、512 维特征，对比逐对标量打分
+TEST(AffinityMatrixTests, BenchmarkAgainstPairwise) {
+    const auto left = MakeInners(200, 512, 3U);
+    const auto right = MakeInners(200, 512, 4U);
+    MatcherConfig cfg;
+
+    AffinityMatrix affinity;
+    constexpr int kIters = 10;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int it = 0; it < kIters; ++it) affinity.compute(left, right, cfg);
+    const auto t1 = std::chrono::steady_clock::now();
+    float sink = 0.0F;
+    for (int it = 0; it < kIters; ++it) {
+        for (const auto &a : left) {
+            for (const auto &b : right) sink += WeightedMatchScore(a, b, cfg);
+        }
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    auto us = [&](auto a, auto b) { return std::chrono::duration<double, std::micro>(b - a).count() / kIters; };
+    std::cout << "[Affinity] isa=" << simd::ActiveIsaName() << " 200x200x512 matrix=" << us(t0, t1)
+              << "us pairwise=" << us(t1, t2) << "us (" << sink << ")\n";
+}
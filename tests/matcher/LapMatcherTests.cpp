@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "core/engine/tracker_manager/matcher/IMatcher.h"
+#include "core/engine/tracker_manager/matcher/LapSolver.h"
+
+namespace {
+constexpr float kInfeasible = 9.0F;
+
+// 穷举所有部分匹配，返回最小总代价（不匹配的行计 unmatched）
+double BruteForceCost(const std::vector<float> &cost, int rows, int cols, float unmatched) {
+    double best = 1e18;
+    std::vector<char> used(static_cast<size_t>(cols), 0);
+    std::function<void(int, double)> rec = [&](int r, double acc) {
+        if (r == rows) {
+            best = std::min(best, acc);
+            return;
+        }
+        rec(r + 1, acc + unmatched);
+        for (int c = 0; c < cols; ++c) {
+            const float v = cost[static_cast<size_t>(r * cols + c)];
+            if (used[static_cast<size_t>(c)] || v >= kInfeasible) continue;
+            used[static_cast<size_t>(c)] = 1;
+            rec(r + 1, acc + v);
+            used[static_cast<size_t>(c)] = 0;
+        }
+    };
+    rec(0, 0.0);
+    return best;
+}
+}  // namespace
+
+TEST(LapSolverTests, MatchesBruteForceOnRandomSparseProblems) {
+    std::mt19937 rng(5);
+    LapSolver solver;
+    std::vector<std::pair<int, int>> matches;
+    for (int it = 0; it < 3000; ++it) {
+        const int rows = 1 + static_cast<int>(rng() % 6);
+        const int cols = 1 + static_cast<int>(rng() % 6);
+        std::vector<float> cost(static_cast<size_t>(rows * cols), kInfeasible);
+        solver.reset(rows, cols);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                if (rng() % 3 == 0) continue;
+                const float v = static_cast<float>(rng() % 100) / 100.0F;
+                cost[static_cast<size_t>(r * cols + c)] = v;
+                solver.addEdge(r, c, v);
+            }
+        }
+        solver.solve(1.0F, matches);
+
+        double total = 0.0;
+        std::vector<char> used(static_cast<size_t>(cols), 0);
+        for (auto [r, c] : matches) {
+            const float v = cost[static_cast<size_t>(r * cols + c)];
+            ASSERT_LT(v, kInfeasible);
+            ASSERT_FALSE(used[static_cast<size_t>(c)]);
+            used[static_cast<size_t>(c)] = 1;
+            total += v;
+        }
+        total += static_cast<double>(rows - static_cast<int>(matches.size()));
+        ASSERT_NEAR(total, BruteForceCost(cost, rows, cols, 1.0F), 1e-5);
+    }
+}
+
+// 贪心会先取最高分的 (0,0)，导致行 1 无可匹配；最优分配应为 (0,1) + (1,0)
+TEST(LapSolverTests, BeatsGreedyInCrowd) {
+    LapSolver solver;
+    solver.reset(2, 2);
+    solver.addEdge(0, 0, 0.10F);  // 得分 0.90
+    solver.addEdge(0, 1, 0.20F);  // 得分 0.80
+    solver.addEdge(1, 0, 0.15F);  // 得分 0.85
+    std::vector<std::pair<int, int>> matches;
+    solver.solve(1.0F, matches);
+    ASSERT_EQ(matches.size(), 2U);
+    EXPECT_EQ(matches[0], std::make_pair(0, 1));
+    EXPECT_EQ(matches[1], std::make_pair(1, 0));
+}
+
+TEST(LapMatcherTests, MatchesOverlappingSimilarPairs) {
+    TrackerInner l0{BBox(cv::Rect2f(0, 0, 10, 10), 0, 0.9f), Feature({1.0f, 0.0f})};
+    TrackerInner l1{BBox(cv::Rect2f(100, 100, 10, 10), 0, 0.8f), Feature({0.0f, 1.0f})};
+    TrackerInner r0{BBox(cv::Rect2f(102, 101, 10, 10), 0, 0.6f), Feature({0.1f, 0.9f})};
+    TrackerInner r1{BBox(cv::Rect2f(1, 1, 10, 10), 0, 0.7f), Feature({0.9f, 0.1f})};
+
+    MatcherConfig cfg;
+    cfg.type = MatcherType::Lap;
+    cfg.threshold = 0.1f;
+    auto matcher = CreateMatcher(cfg);
+    const std::vector<TrackerInner> left{l0, l1}, right{r0, r1};
+    const auto matches = matcher->match(left, right);
+
+    ASSERT_EQ(matches.size(), 2U);
+    EXPECT_EQ(matches[0], std::make_pair(0, 1));
+    EXPECT_EQ(matches[1], std::make_pair(1, 0));
+}
+
+// 500x500 的跟踪型稀疏代价（每条轨迹只与附近几个检测可行）
+TEST(LapSolverTests, Solves500x500Quickly) {
+    constexpr int kN = 500;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> u(0.0F, 0.5F);
+    std::vector<float> cost(static_cast<size_t>(kN * kN), kInfeasible);
+    for (int r = 0; r < kN; ++r) {
+        for (int c = std::max(0, r - 2); c <= std::min(kN - 1, r + 2); ++c) {
+            cost[static_cast<size_t>(r * kN + c)] = u(rng);
+        }
+    }
+
+    LapSolver solver;
+    std::vector<std::pair<int, int>> matches;
+    constexpr int kIters = 20;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIters; ++i) {
+        solver.reset(kN, kN);
+        solver.addDense(cost.data(), kN, kN, kN, 1.0F);
+        solver.solve(1.0F, matches);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / kIters;
+    std::cout << "[LapSolver] 500x500 sparse: " << ms << " ms\n";
+    EXPECT_EQ(matches.size(), static_cast<size_t>(kN));
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <vector>
+
+#include "core/engine/tracker_manager/TrackerManager.h"
+#include "core/memory/FrameArena.h"
+
+// 超出预留缓冲的帧会触发扩容，之后同等规模的帧不再向堆申请
+TEST(FrameArenaTests, GrowsOnceThenStopsTouchingHeap) {
+    FrameArena arena(1024);
+    for (int frame = 0; frame < 3; ++frame) {
+        arena.reset();
+        std::pmr::vector<float> a(4096, 0.0f, arena.resource());
+        std::pmr::vector<int> b(512, 0, arena.resource());
+        EXPECT_EQ(arena.frameAllocations(), 2U);
+        if (frame == 0) {
+            EXPECT_GT(arena.frameUpstreamAllocations(), 0U);
+        } else {
+            EXPECT_EQ(arena.frameUpstreamAllocations(), 0U);
+        }
+    }
+    EXPECT_GE(arena.capacity(), 4096 * sizeof(float) + 512 * sizeof(int));
+}
+
+// 稳定运行时 TrackerManager::update 的临时容器全部落在帧级内存池内
+TEST(FrameArenaTests, TrackerUpdateStaysInArena) {
+    TrackerManager mgr;
+    std::vector<TrackerInner> dets;
+    for (int frame = 0; frame < 20; ++frame) {
+        dets.clear();
+        for (int k = 0; k < 8; ++k) {
+            const float x = static_cast<float>(k * 50 + frame * 2);
+            dets.push_back({BBox(cv::Rect2f(x, 10, 30, 30), 0, 0.9f), Feature({1.0f, static_cast<float>(k)})});
+        }
+        mgr.predictAll();
+        mgr.update(dets);
+        if (frame >= 5) {
+            EXPECT_EQ(mgr.frameArena().frameUpstreamAllocations(), 0U);
+            // 每帧请求数只与匹配/标记容器的个数有关，不随轨迹数增长
+            EXPECT_LE(mgr.frameArena().frameAllocations(), 16U);
+        }
+    }
+    EXPECT_EQ(mgr.tracks().size(), 8U);
+}
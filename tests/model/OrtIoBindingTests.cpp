@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+
+#include <opencv2/opencv.hpp>
+
+#include "core/engine/model/OrtEnvSingleton.h"
+#include "core/engine/model/OrtIoBinding.h"
+#include "core/engine/model/detector/YoloDetector.h"
+#include "core/engine/model/feature_extractor/FeatureExtractor.h"
+
+namespace {
+// 当前线程在 CountAllocations 作用域内的 operator new 次数（其它时间、其它线程不计数）
+thread_local bool g_counting = false;
+thread_local size_t g_allocations = 0;
+
+template <typename Fn>
+size_t CountAllocations(Fn &&fn) {
+    g_allocations = 0;
+    g_counting = true;
+    fn();
+    g_counting = false;
+    return g_allocations;
+}
+
+// 对同一段调用重复 iters 次，取最少的一次（排除 ORT 内部偶发的分配波动）
+template <typename Fn>
+size_t MinAllocations(int iters, Fn &&fn) {
+    size_t best = SIZE_MAX;
+    for (int i = 0; i < iters; ++i) best = std::min(best, CountAllocations(fn));
+    return best;
+}
+
+std::filesystem::path ModelPath(const char *name) {
+    return std::filesystem::path(PROJECT_ROOT_DIR) / "model" / name;
+}
+}  // namespace
+
+void *operator new(std::size_t size) {
+    if (g_counting) ++g_allocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+    if (g_counting) ++g_allocations;
+    const auto a = static_cast<std::size_t>(align);
+    if (void *p = std::aligned_alloc(a, (std::max<std::size_t>(size, 1) + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+// 预热（第一次推理）之后，检测器的绑定层不应再分配任何推理缓冲或重建绑定
+TEST(OrtIoBindingTests, DetectorDoesNotRebindAfterWarmup) {
+    const auto model_path = ModelPath("yolo12n.onnx");
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "缺少模型文件: " << model_path;
+    }
+
+    DetectorConfig config;
+    config.ort_env_config.model_path = model_path.string();
+    YoloDetector detector(config);
+
+    cv::Mat frame(720, 1280, CV_8UC3, cv::Scalar(40, 80, 120));
+    detector.detect(frame, 0);
+    const size_t warm = detector.bindingAllocationCount();
+    EXPECT_GT(warm, 0U);
+
+    cv::Mat other(480, 640, CV_8UC3, cv::Scalar(200, 10, 10));
+    for (int i = 1; i <= 5; ++i) {
+        detector.detect(i % 2 ? other : frame, i);
+    }
+    EXPECT_EQ(detector.bindingAllocationCount(), warm);
+}
+
+// 动态 H/W 模型的矩形推理：每种宽高比的输入 shape 首次推理后，输出改为预分配，之后不再分配
+TEST(OrtIoBindingTests, RectInferenceDoesNotAllocateAfterWarmup) {
+    const auto model_path = ModelPath("yolo12n.onnx");
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "缺少模型文件: " << model_path;
+    }
+
+    DetectorConfig config;
+    config.ort_env_config.model_path = model_path.string();
+    YoloDetector detector(config);
+    if (!detector.rectInference()) {
+        GTEST_SKIP() << "模型输入 H/W 为固定维度，不使用矩形推理";
+    }
+
+    cv::Mat wide(720, 1280, CV_8UC3, cv::Scalar(40, 80, 120));
+    cv::Mat tall(1280, 720, CV_8UC3, cv::Scalar(200, 10, 10));
+    detector.detect(wide, 0);
+    detector.detect(tall, 1);
+    const size_t warm = detector.bindingAllocationCount();
+    for (int i = 2; i <= 6; ++i) {
+        detector.detect(i % 2 ? tall : wide, i);
+    }
+    EXPECT_EQ(detector.bindingAllocationCount(), warm);
+}
+
+// 特征提取器在构造期按所有 batch 大小预热，之后任意 batch 组合都不应再分配推理缓冲或重建绑定
+TEST(OrtIoBindingTests, ExtractorDoesNotRebindAfterWarmup) {
+    const auto model_path = ModelPath("osnet_x1_0.onnx");
+    if (!std::filesystem::exists(model_path)) {
+        GTEST_SKIP() << "缺少模型文件: " << model_path;
+    }
+
+    FeatureExtractorConfig cfg;
+    cfg.ort_env_config.model_path = model_path.string();
+    cfg.max_batch_size = 4;
+    FeatureExtractor extractor(cfg);
+    const size_t warm = extractor.bindingAllocationCount();
+
+    cv::Mat frame(480, 640, CV_8UC3, cv::Scalar(90, 120, 150));
+    std::vector<cv::Rect> rois;
+    for (int i = 0; i < 7; ++i) {
+        rois.emplace_back(20 * i, 10 * i, 60, 120);
+    }
+
+    for (size_t n = 1; n <= rois.size(); ++n) {
+        const std::vector<cv::Rect> subset(rois.begin(), rois.begin() + static_cast<std::ptrdiff_t>(n));
+        const auto feats = extractor.extractBatch(frame, subset);
+        ASSERT_EQ(feats.size(), n);
+    }
+    extractor.extract(frame(rois.front()));
+
+    EXPECT_EQ(extractor.bindingAllocationCount(), warm);
+}
+
+// 结果写入调用方复用的缓冲后，预热之后的逐帧 detect / extractBatch 除 ORT Run 自身外不做任何堆分配：
+// 与同一模型、同一输入 shape 上裸跑 OrtIoBindingCache::run 的分配次数相比不能更多。
+// 多线程解码经 OpenCV 线程池派发（每次派发都会分配任务对象），这里关闭以只测本仓库的代码路径
+TEST(OrtIoBindingTests, SteadyStateDetectAndExtractDoNotAllocate) {
+    const auto detector_path = ModelPath("yolo12n.onnx");
+    const auto extractor_path = ModelPath("osnet_x1_0.onnx");
+    if (!std::filesystem::exists(detector_path) || !std::filesystem::exists(extractor_path)) {
+        GTEST_SKIP() << "缺少模型文件: " << detector_path << " / " << extractor_path;
+    }
+    constexpr int kIters = 5;
+
+    DetectorConfig det_cfg;
+    det_cfg.ort_env_config.model_path = detector_path.string();
+    det_cfg.decode_parallel_min_anchors = INT_MAX;
+    YoloDetector detector(det_cfg);
+    // 方形输入：矩形推理与固定尺寸模型的推理 shape 都是 [1,3,640,640]
+    cv::Mat frame(det_cfg.input_height, det_cfg.input_width, CV_8UC3, cv::Scalar(40, 80, 120));
+    std::vector<BBox> boxes;
+    detector.detect(frame, 0, boxes);
+
+    auto det_session = CreateSession(det_cfg.ort_env_config);
+    OrtIoBindingCache det_bare(*det_session);
+    det_bare.setLearnOutputShapes(true);
+    det_bare.prepareInput({1, 3, det_cfg.input_height, det_cfg.input_width});
+    det_bare.run();
+    const size_t det_run = MinAllocations(kIters, [&] { det_bare.run(); });
+    const size_t det_steady = MinAllocations(kIters, [&] { detector.detect(frame, 1, boxes); });
+    EXPECT_LE(det_steady, det_run) << "detect 在 ORT Run 之外仍有堆分配";
+
+    FeatureExtractorConfig ext_cfg;
+    ext_cfg.ort_env_config.model_path = extractor_path.string();
+    ext_cfg.max_batch_size = 4;
+    FeatureExtractor extractor(ext_cfg);
+    cv::Mat scene(480, 640, CV_8UC3, cv::Scalar(90, 120, 150));
+    std::vector<cv::Rect> rois;
+    for (int i = 0; i < 7; ++i) rois.emplace_back(20 * i, 10 * i, 60, 120);
+    std::vector<float> feats;
+    extractor.extractBatch(scene, rois, feats);
+
+    // 7 个裁剪框按 4 + 3 分两块推理（固定 batch 的模型两块都按模型 batch）
+    auto ext_session = CreateSession(ext_cfg.ort_env_config);
+    OrtIoBindingCache ext_bare(*ext_session);
+    auto shapeFor = [&](int64_t batch) {
+        std::vector<int64_t> shape = ext_bare.modelInputShape();
+        shape[0] = shape[0] > 0 ? shape[0] : batch;
+        shape[2] = ext_cfg.input_height;
+        shape[3] = ext_cfg.input_width;
+        return shape;
+    };
+    size_t ext_run = 0;
+    for (int64_t batch : {4, 3}) {
+        ext_bare.prepareInput(shapeFor(batch));
+        ext_bare.run();
+        ext_run += MinAllocations(kIters, [&] { ext_bare.run(); });
+    }
+    const size_t ext_steady = MinAllocations(kIters, [&] { extractor.extractBatch(scene, rois, feats); });
+    EXPECT_LE(ext_steady, ext_run) << "extractBatch 在 ORT Run 之外仍有堆分配";
+    EXPECT_EQ(feats.size() % rois.size(), 0U);
+}
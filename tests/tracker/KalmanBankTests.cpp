@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "core/engine/tracker_manager/KalmanBank.h"
+#include "core/engine/tracker_manager/Tracker.h"
+
+namespace {
+// 参考实现：按 cv::KalmanFilter 的公式逐项计算的完整 8x8 / 4x4 滤波器（double 精度）
+struct ReferenceKalman {
+    using Mat8 = std::array<std::array<double, 8>, 8>;
+    std::array<double, 8> x{};
+    Mat8 P{}, F{}, Q{};
+    std::array<double, 4> R{};
+
+    ReferenceKalman(const BoxKalmanBank::Model &model, const std::array<float, 4> &z, const std::array<float, 4> &r) {
+        for (int i = 0; i < 8; ++i) {
+            P[i][i] = 1.0;
+            F[i][i] = 1.0;
+        }
+        for (int a = 0; a < 4; ++a) {
+            x[a] = z[a];
+            F[a + 4][a + 4] = model.vel_decay[a];
+            Q[a][a] = model.pos_noise[a];
+            Q[a + 4][a + 4] = model.vel_noise[a];
+            R[a] = r[a];
+        }
+    }
+
+    void predict(double dt) {
+        for (int a = 0; a < 4; ++a) F[a][a + 4] = dt;
+        std::array<double, 8> nx{};
+        Mat8 fp{}, np{};
+        for (int i = 0; i < 8; ++i) {
+            for (int k = 0; k < 8; ++k) nx[i] += F[i][k] * x[k];
+        }
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j)
+                for (int k = 0; k < 8; ++k) fp[i][j] += F[i][k] * P[k][j];
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j) {
+                for (int k = 0; k < 8; ++k) np[i][j] += fp[i][k] * F[j][k];
+                np[i][j] += Q[i][j];
+            }
+        x = nx;
+        P = np;
+    }
+
+    void correct(const std::array<float, 4> &z) {
+        // S = H P H^T + R（4x4），K = P H^T S^-1（8x4），用高斯-约当求逆
+        std::array<std::array<double, 8>, 4> aug{};
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) aug[i][j] = P[i][j] + (i == j ? R[i] : 0.0);
+            aug[i][4 + i] = 1.0;
+        }
+        for (int c = 0; c < 4; ++c) {
+            const double pivot = aug[c][c];
+            for (auto &v : aug[c]) v /= pivot;
+            for (int r = 0; r < 4; ++r) {
+                if (r == c) continue;
+                const double f = aug[r][c];
+                for (int k = 0; k < 8; ++k) aug[r][k] -= f * aug[c][k];
+            }
+        }
+        std::array<std::array<double, 4>, 8> K{};
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 4; ++j)
+                for (int k = 0; k < 4; ++k) K[i][j] += P[i][k] * aug[k][4 + j];
+        std::array<double, 4> y{};
+        for (int j = 0; j < 4; ++j) y[j] = z[j] - x[j];
+        Mat8 np = P;
+        for (int i = 0; i < 8; ++i) {
+            for (int j = 0; j < 4; ++j) x[i] += K[i][j] * y[j];
+            for (int c = 0; c < 8; ++c)
+                for (int j = 0; j < 4; ++j) np[i][c] -= K[i][j] * P[j][c];
+        }
+        P = np;
+    }
+};
+
+void ExpectClose(const BoxKalmanBank &bank, int slot, const ReferenceKalman &ref) {
+    const auto x = bank.state(slot);
+    const auto cov = bank.covariance(slot);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_NEAR(x[i], ref.x[i], 1e-3 * (1.0 + std::abs(ref.x[i]))) << "state " << i;
+        for (int j = 0; j < 8; ++j) {
+            EXPECT_NEAR(cov[i * 8 + j], ref.P[i][j], 1e-4 * (1.0 + std::abs(ref.P[i][j]))) << i << "," << j;
+        }
+    }
+}
+}  // namespace
+
+TEST(KalmanBankTests, MatchesFullMatrixFilter) {
+    const auto model = Tracker::kalmanModel();
+    BoxKalmanBank bank(model);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> pos(0.0F, 1000.0F);
+    std::normal_distribution<float> noise(0.0F, 2.0F);
+    std::uniform_real_distribution<float> dts(0.5F, 2.0F);
+
+    constexpr int kTracks = 37;
+    const std::array<float, 4> r = {1e-2F, 1e-2F, 1e-1F, 1e-1F};
+    std::vector<int> slots;
+    std::vector<ReferenceKalman> refs;
+    std::vector<std::array<float, 4>> truth;
+    for (int t = 0; t < kTracks; ++t) {
+        const std::array<float, 4> z = {pos(rng), pos(rng), 20.0F + pos(rng) * 0.1F, 40.0F + pos(rng) * 0.2F};
+        slots.push_back(bank.allocate(z, r));
+        refs.emplace_back(model, z, r);
+        truth.push_back(z);
+    }
+
+    for (int step = 0; step < 60; ++step) {
+        const float dt = dts(rng);
+        bank.predictAll(dt);
+        for (auto &ref : refs) ref.predict(dt);
+        for (int t = 0; t < kTracks; ++t) {
+            // 目标匀速移动、尺寸缓慢变化；约 70% 的帧有观测
+            truth[t][0] += 3.0F * dt;
+            truth[t][1] -= 1.5F * dt;
+            truth[t][2] += 0.1F * dt;
+            if (rng() % 10 < 7) {
+                std::array<float, 4> z = truth[t];
+                for (auto &v : z) v += noise(rng);
+                bank.correct(slots[t], z);
+                refs[t].correct(z);
+            }
+        }
+    }
+    for (int t = 0; t < kTracks; ++t) ExpectClose(bank, slots[t], refs[t]);
+}
+
+TEST(KalmanBankTests, SinglePredictMatchesBatchAndSlotsAreReused) {
+    BoxKalmanBank batch(Tracker::kalmanModel());
+    BoxKalmanBank single(Tracker::kalmanModel());
+    const std::array<float, 4> r = {1e-2F, 1e-2F, 1e-1F, 1e-1F};
+    const int a0 = batch.allocate({10, 20, 30, 40}, r), b0 = single.allocate({10, 20, 30, 40}, r);
+    const int a1 = batch.allocate({50, 60, 70, 80}, r), b1 = single.allocate({50, 60, 70, 80}, r);
+    for (int i = 0; i < 5; ++i) {
+        batch.predictAll(1.0F);
+        single.predict(b0, 1.0F);
+        single.predict(b1, 1.0F);
+        batch.correct(a0, {12.0F + i, 21, 31, 41});
+        single.correct(b0, {12.0F + i, 21, 31, 41});
+    }
+    EXPECT_EQ(batch.state(a0), single.state(b0));
+    EXPECT_EQ(batch.state(a1), single.state(b1));
+    EXPECT_EQ(batch.covariance(a0), single.covariance(b0));
+
+    batch.release(a0);
+    EXPECT_EQ(batch.activeCount(), 1U);
+    EXPECT_EQ(batch.allocate({1, 2, 3, 4}, r), a0);
+    EXPECT_EQ(batch.capacity(), 2U);
+    EXPECT_THROW(batch.correct(5, {0, 0, 0, 0}), std::out_of_range);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/engine/tracker_manager/TrackerManager.h"
+
+namespace {
+TrackerInner MakeDet(float x, float y, float score, float f0, float f1) {
+    return {BBox(cv::Rect2f(x, y, 40, 80), 0, score), Feature({f0, f1})};
+}
+
+std::vector<BBox> Boxes(const std::vector<TrackerInner> &dets) {
+    std::vector<BBox> boxes;
+    for (const auto &d : dets) boxes.push_back(d.box);
+    return boxes;
+}
+
+// 三个相距很远、缓慢移动的目标
+std::vector<TrackerInner> SparseScene(int frame) {
+    const float dx = static_cast<float>(frame);
+    return {MakeDet(10 + dx, 10, 0.9f, 1, 0), MakeDet(300 + dx, 10, 0.8f, 0, 1), MakeDet(600 + dx, 200, 0.7f, 1, 1)};
+}
+}  // namespace
+
+// 稀疏场景中轨迹建立后，检测都无歧义：不再抽特征，轨迹照常更新；特征过旧时才刷新
+TEST(ReidGateTests, SparseSceneSkipsReidUntilRefresh) {
+    TrackerManagerConfig cfg;
+    cfg.reid_gate.enabled = true;
+    cfg.reid_gate.refresh_interval = 5;
+    TrackerManager mgr(cfg);
+
+    int frame = 0;
+    for (; frame < 6; ++frame) {
+        mgr.predictAll();
+        mgr.update(SparseScene(frame));
+    }
+    ASSERT_EQ(mgr.tracks().size(), 3U);
+    std::vector<size_t> ids;
+    for (const auto &t : mgr.tracks().trackers()) ids.push_back(t.id());
+
+    ReidPlan plan;
+    size_t refreshed = 0;
+    for (; frame < 16; ++frame) {
+        mgr.predictAll();
+        auto dets = SparseScene(frame);
+        mgr.planReid(Boxes(dets), plan);
+        for (size_t i = 0; i < dets.size(); ++i) {
+            ASSERT_NE(plan.actions[i], ReidAction::Extract);
+            ASSERT_NE(plan.actions[i], ReidAction::Drop);
+            if (plan.actions[i] == ReidAction::Reuse) dets[i].feature = Feature();
+            if (plan.actions[i] == ReidAction::Refresh) ++refreshed;
+        }
+        mgr.update(dets, plan);
+
+        ASSERT_EQ(mgr.tracks().size(), 3U);
+        for (size_t i = 0; i < ids.size(); ++i) EXPECT_EQ(mgr.tracks().trackers()[i].id(), ids[i]);
+    }
+    // 10 帧内每条轨迹约刷新 2 次，远少于每帧抽取
+    EXPECT_GT(refreshed, 0U);
+    EXPECT_LT(refreshed, 3U * 10U / 2U);
+    for (const auto &t : mgr.tracks().trackers()) EXPECT_LE(t.featureAge(), 5);
+}
+
+// 同一轨迹附近出现两个检测时视为有歧义；超出裁剪上限时按置信度保留
+TEST(ReidGateTests, AmbiguousDetectionsAreExtractedUnderCap) {
+    TrackerManagerConfig cfg;
+    cfg.reid_gate.enabled = true;
+    cfg.reid_gate.max_crops_per_frame = 2;
+    TrackerManager mgr(cfg);
+    for (int frame = 0; frame < 6; ++frame) {
+        mgr.predictAll();
+        mgr.update(SparseScene(0));
+    }
+    ASSERT_EQ(mgr.tracks().size(), 3U);
+    mgr.predictAll();
+
+    ReidPlan plan;
+    const std::vector<BBox> boxes = {
+        BBox(cv::Rect2f(10, 10, 40, 80), 0, 0.9f),    // 与轨迹 0 重合
+        BBox(cv::Rect2f(22, 10, 40, 80), 0, 0.5f),    // 同样压在轨迹 0 上
+        BBox(cv::Rect2f(300, 10, 40, 80), 0, 0.8f),   // 无歧义
+        BBox(cv::Rect2f(1000, 500, 40, 80), 0, 0.6f), // 新目标
+    };
+    mgr.planReid(boxes, plan);
+    EXPECT_EQ(plan.actions[0], ReidAction::Extract);
+    EXPECT_EQ(plan.actions[1], ReidAction::Drop);  // 三个候选中置信度最低，超出上限
+    EXPECT_EQ(plan.actions[2], ReidAction::Reuse);
+    EXPECT_EQ(plan.actions[3], ReidAction::Extract);
+    EXPECT_EQ(plan.crops, 2U);
+}
+
+// 直接关联的轨迹不参与常规匹配：Extract 检测即使与已被占用的轨迹得分最高，也应落到未占用的相邻轨迹上
+TEST(ReidGateTests, ExtractDetectionsSkipClaimedTracks) {
+    TrackerManagerConfig cfg;
+    cfg.reid_gate.enabled = true;
+    TrackerManager mgr(cfg);
+    // 两条部分重叠的轨迹：A 在左、B 在右
+    const std::vector<TrackerInner> scene = {MakeDet(0, 0, 0.9f, 1, 0), MakeDet(20, 0, 0.8f, 0.6f, 0.8f)};
+    for (int frame = 0; frame < 6; ++frame) {
+        mgr.predictAll();
+        mgr.update(scene);
+    }
+    ASSERT_EQ(mgr.tracks().size(), 2U);
+    const int a = mgr.tracks().inners()[0].box.box.x < 10 ? 0 : 1;
+    mgr.predictAll();
+
+    // det0 无歧义地命中 A；det1 是 B 的观测，但位置居中且外观更像 A
+    const std::vector<TrackerInner> dets = {MakeDet(0, 0, 0.9f, 1, 0), MakeDet(10, 0, 0.8f, 1, 0)};
+    ReidPlan plan;
+    plan.actions = {ReidAction::Reuse, ReidAction::Extract};
+    plan.tracks = {a, -1};
+    plan.crops = 1;
+    mgr.update(dets, plan);
+
+    EXPECT_EQ(mgr.lastUpdateStats().hits, 2U);
+    EXPECT_EQ(mgr.lastUpdateStats().pending, 0U);
+    EXPECT_EQ(mgr.tracks().size(), 2U);
+}
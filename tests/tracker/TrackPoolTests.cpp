@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/engine/tracker_manager/TrackPool.h"
+
+namespace {
+TrackerInner MakeInner(float x) {
+    return {BBox(cv::Rect2f(x, 0, 10, 10), 0, 0.9f), Feature({1.0f, 0.0f})};
+}
+}  // namespace
+
+TEST(TrackPoolTests, RemoveKeepsOrderAndInvalidatesHandles) {
+    BoxKalmanBank kf(Tracker::kalmanModel());
+    TrackerConfig cfg;
+    TrackPool pool;
+    std::vector<TrackHandle> handles;
+    for (int i = 0; i < 5; ++i) {
+        const auto inner = MakeInner(static_cast<float>(i * 100));
+        handles.push_back(pool.add(Tracker(static_cast<size_t>(i), inner, cfg, kf), inner));
+    }
+    ASSERT_EQ(pool.size(), 5U);
+    EXPECT_EQ(kf.activeCount(), 5U);
+
+    const std::vector<char> remove = {0, 1, 0, 1, 0};
+    pool.removeIf(remove);
+    ASSERT_EQ(pool.size(), 3U);
+    // 被删除轨迹的滤波器槽位已归还
+    EXPECT_EQ(kf.activeCount(), 3U);
+
+    // 存活轨迹保持原有顺序，inner 与 tracker 一一对应
+    const size_t expected_ids[] = {0, 2, 4};
+    for (size_t i = 0; i < pool.size(); ++i) {
+        EXPECT_EQ(pool.trackers()[i].id(), expected_ids[i]);
+        EXPECT_FLOAT_EQ(pool.inners()[i].box.box.x, static_cast<float>(expected_ids[i] * 100));
+        EXPECT_EQ(pool.indexOf(handles[expected_ids[i]]), static_cast<int>(i));
+    }
+    EXPECT_FALSE(pool.contains(handles[1]));
+    EXPECT_FALSE(pool.contains(handles[3]));
+
+    // 槽位被复用后，旧句柄仍然无效（代数不同）
+    const auto inner = MakeInner(1000.0f);
+    const TrackHandle fresh = pool.add(Tracker(5, inner, cfg, kf), inner);
+    EXPECT_TRUE(fresh.index == handles[1].index || fresh.index == handles[3].index);
+    EXPECT_NE(fresh.generation, 0U);
+    EXPECT_TRUE(pool.contains(fresh));
+    EXPECT_FALSE(pool.contains(handles[fresh.index == handles[1].index ? 1 : 3]));
+    EXPECT_EQ(pool.indexOf(fresh), 3);
+}
@@ -1,31 +1,61 @@
 #include <gtest/gtest.h>
-#include "core/processor/tracker_manager/TrackerManager.h"
+#include "core/engine/tracker_manager/TrackerManager.h"
 
 TEST(TrackerManagerTests, CreateAndMatch) {
     TrackerManagerConfig cfg;
-    cfg.match_threshold = 0.1f;
-    cfg.iou_weight = 0.5f;
-    cfg.feature_weight = 0.5f;
-    cfg.max_life = 5;
+    cfg.matcher_cfg.threshold = 0.1f;
+    cfg.matcher_cfg.iou_weight = 0.5f;
+    cfg.matcher_cfg.feature_weight = 0.5f;
+    cfg.tracker_cfg.max_life = 5;
 
     TrackerManager mgr(cfg);
 
-    // 初次输入两条检测，新建两条轨迹
-    std::vector<TrackerInner> dets{
-        {BBox(cv::Rect2f(0, 0, 10, 10), 0, 0.9f), Feature({1.0f, 0.0f})},
-        {BBox(cv::Rect2f(100, 100, 10, 10), 0, 0.8f), Feature({0.0f, 1.0f})}
+    // 两条检测连续出现，经过 pending 确认（延迟建轨）后新建两条轨迹
+    auto dets_at = [](float d) {
+        return std::vector<TrackerInner>{
+            {BBox(cv::Rect2f(0 + d, 0 + d, 10, 10), 0, 0.9f), Feature({1.0f, 0.0f})},
+            {BBox(cv::Rect2f(100 + d, 100 + d, 10, 10), 0, 0.8f), Feature({0.0f, 1.0f})}
+        };
     };
-
-    mgr.predictAll();
-    auto &tracks1 = mgr.update(dets);
+    for (int f = 0; f < 3; ++f) {
+        mgr.predictAll();
+        mgr.update(dets_at(static_cast<float>(f)));
+    }
+    const auto &tracks1 = mgr.tracks();
     ASSERT_EQ(tracks1.size(), 2u);
+    const size_t id0 = tracks1.trackers()[0].id();
+    const size_t id1 = tracks1.trackers()[1].id();
 
     // 轻微移动的检测，再次匹配到原轨迹
     std::vector<TrackerInner> dets2{
-        {BBox(cv::Rect2f(2, 2, 10, 10), 0, 0.9f), Feature({0.9f, 0.1f})},
-        {BBox(cv::Rect2f(102, 102, 10, 10), 0, 0.8f), Feature({0.1f, 0.9f})}
+        {BBox(cv::Rect2f(4, 4, 10, 10), 0, 0.9f), Feature({0.9f, 0.1f})},
+        {BBox(cv::Rect2f(104, 104, 10, 10), 0, 0.8f), Feature({0.1f, 0.9f})}
     };
     mgr.predictAll();
-    auto &tracks2 = mgr.update(dets2);
+    const auto &tracks2 = mgr.update(dets2);
     ASSERT_EQ(tracks2.size(), 2u);
+    EXPECT_EQ(tracks2.trackers()[0].id(), id0);
+    EXPECT_EQ(tracks2.trackers()[1].id(), id1);
+}
+
+// 只在导出窗口内的帧附带轨迹特征，窗口外的帧不拷贝
+TEST(TrackerManagerTests, ExportsFeaturesOnlyInsideWindows) {
+    TrackerManagerConfig cfg;
+    cfg.tracker_cfg.healthy_percent = 0.1f;
+    cfg.export_features = true;
+    cfg.export_feature_windows = {{0, 2}, {8, 10}};
+    TrackerManager mgr(cfg);
+
+    const std::vector<TrackerInner> dets{{BBox(cv::Rect2f(0, 0, 40, 80), 0, 0.9f), Feature({1.0f, 0.0f})}};
+    LabeledFrame label;
+    for (int f = 0; f < 10; ++f) {
+        mgr.predictAll();
+        mgr.update(dets);
+        mgr.fillLabeledFrame(f, label);
+        for (const auto &obj : label.objs) {
+            const bool in_window = f < 2 || f >= 8;
+            EXPECT_EQ(obj.feature.empty(), !in_window) << "frame " << f;
+        }
+    }
+    EXPECT_FALSE(label.objs.empty());
 }